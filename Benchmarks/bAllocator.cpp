@@ -0,0 +1,149 @@
+
+/*
+ * File bAllocator.cpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions.
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide.
+ */
+/**
+ * @file bAllocator.cpp
+ * Microbenchmark of the Allocator against malloc, see
+ * UnitTests/tAllocator.cpp for the tests.
+ *
+ * Each thread allocates a batch of small pieces, which are then deallocated
+ * by the next thread. Several threads are used only in builds with
+ * THREAD_SAFE_ALLOCATION=1. To compare against the system allocation,
+ * run the test from a build with USE_SYSTEM_ALLOCATION=1.
+ */
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <pthread.h>
+
+#include "Lib/Allocator.hpp"
+#include "Lib/DArray.hpp"
+
+#include "Test/UnitTesting.hpp"
+
+#define UNIT_ID allocator
+UT_CREATE;
+
+using namespace std;
+using namespace Lib;
+
+namespace {
+
+/** Number of pieces allocated by a thread in a round */
+const unsigned PIECES = 100000;
+const unsigned ROUNDS = 10;
+
+struct Worker {
+  void** pieces;
+  bool useMalloc;
+  /** The worker that deallocates the pieces of this one */
+  Worker* next;
+};
+
+/** Size of the @b i-th piece of a batch, between 8 and 256 bytes */
+size_t pieceSize(unsigned i)
+{
+  return 8*(1+(i*2654435761u>>27));
+}
+
+void* allocatePieces(void* arg)
+{
+#if THREAD_SAFE_ALLOCATION
+  Allocator::ThreadInitialiser init;
+#endif
+  Worker* w = static_cast<Worker*>(arg);
+  for (unsigned i=0; i<PIECES; i++) {
+    size_t size = pieceSize(i);
+    void* mem = w->useMalloc ? malloc(size) : ALLOC_KNOWN(size,"bAllocator");
+    *static_cast<unsigned*>(mem) = i;
+    w->pieces[i] = mem;
+  }
+  return 0;
+}
+
+void* deallocatePieces(void* arg)
+{
+#if THREAD_SAFE_ALLOCATION
+  Allocator::ThreadInitialiser init;
+#endif
+  Worker* w = static_cast<Worker*>(arg)->next;
+  for (unsigned i=0; i<PIECES; i++) {
+    if (w->useMalloc) {
+      free(w->pieces[i]);
+    }
+    else {
+      DEALLOC_KNOWN(w->pieces[i],pieceSize(i),"bAllocator");
+    }
+  }
+  return 0;
+}
+
+void runThreads(DArray<Worker>& workers, void* (*fn)(void*))
+{
+  unsigned threadCnt = workers.size();
+  DArray<pthread_t> threads(threadCnt);
+  for (unsigned t=0; t<threadCnt; t++) {
+    pthread_create(&threads[t], 0, fn, &workers[t]);
+  }
+  for (unsigned t=0; t<threadCnt; t++) {
+    pthread_join(threads[t], 0);
+  }
+}
+
+/**
+ * Return the number of allocations and deallocations per second
+ * done by @b threadCnt threads
+ */
+double measure(unsigned threadCnt, bool useMalloc)
+{
+  DArray<void*> pieces(threadCnt*PIECES);
+  DArray<Worker> workers(threadCnt);
+  for (unsigned t=0; t<threadCnt; t++) {
+    workers[t].pieces = pieces.array()+t*PIECES;
+    workers[t].useMalloc = useMalloc;
+    workers[t].next = &workers[(t+1)%threadCnt];
+  }
+
+  auto begin = chrono::steady_clock::now();
+  for (unsigned r=0; r<ROUNDS; r++) {
+    runThreads(workers, allocatePieces);
+    runThreads(workers, deallocatePieces);
+  }
+  auto end = chrono::steady_clock::now();
+
+  return 2.0*ROUNDS*threadCnt*PIECES/chrono::duration<double>(end-begin).count();
+}
+
+}
+
+TEST_FUN(allocator_throughput)
+{
+#if THREAD_SAFE_ALLOCATION
+  const unsigned maxThreads = 8;
+#else
+  const unsigned maxThreads = 1;
+#endif
+
+  cout << endl << "threads  allocator ops/s  malloc ops/s" << endl;
+  for (unsigned threadCnt = 1; threadCnt<=maxThreads; threadCnt *= 2) {
+    double allocator = measure(threadCnt, false);
+    double system = measure(threadCnt, true);
+    cout << threadCnt << "\t " << (unsigned long)allocator << "\t\t" << (unsigned long)system << endl;
+  }
+}
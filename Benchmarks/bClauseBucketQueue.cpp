@@ -0,0 +1,137 @@
+
+/*
+ * File bClauseBucketQueue.cpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions.
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide.
+ */
+/**
+ * @file bClauseBucketQueue.cpp
+ * Benchmark of ClauseBucketQueue against the skip list of ClauseQueue
+ * with millions of clauses, see UnitTests/tClauseBucketQueue.cpp for
+ * the tests.
+ *
+ * The queues only compare the keys and the addresses of the clauses,
+ * so the clauses are fake pointers whose keys are kept in an array.
+ * The id of a fake clause is its index.
+ */
+
+#include <chrono>
+#include <iostream>
+
+#include "Lib/Allocator.hpp"
+#include "Lib/DArray.hpp"
+
+#include "Kernel/ClauseBucketQueue.hpp"
+#include "Kernel/ClauseQueue.hpp"
+
+#include "Test/UnitTesting.hpp"
+
+#define UNIT_ID clauseBucketQueue
+UT_CREATE;
+
+using namespace std;
+using namespace Lib;
+using namespace Kernel;
+
+namespace {
+
+/** Keys of the fake clauses */
+DArray<unsigned> keys;
+
+Clause* fakeClause(unsigned i)
+{
+  return reinterpret_cast<Clause*>(static_cast<size_t>(i+1)*8);
+}
+
+unsigned fakeKey(Clause* c)
+{
+  return keys[reinterpret_cast<size_t>(c)/8-1];
+}
+
+/** Initialize @b cnt keys between 0 and 255 */
+void initKeys(unsigned cnt)
+{
+  keys.ensure(cnt);
+  for (unsigned i=0; i<cnt; i++) {
+    keys[i] = (i*2654435761u)>>24;
+  }
+}
+
+class SkipListQueue
+: public ClauseQueue
+{
+protected:
+  bool lessThan(Clause* c1, Clause* c2) override
+  {
+    unsigned k1 = fakeKey(c1);
+    unsigned k2 = fakeKey(c2);
+    return k1<k2 || (k1==k2 && c1<c2);
+  }
+};
+
+class BucketQueue
+: public ClauseBucketQueue
+{
+protected:
+  unsigned key(Clause* c) override
+  { return fakeKey(c); }
+  unsigned id(Clause* c) override
+  { return reinterpret_cast<size_t>(c)/8-1; }
+};
+
+/**
+ * Insert @b cnt clauses in @b queue, remove every third of them and pop
+ * the rest. Return the time the operations took in seconds.
+ */
+template<class Queue>
+double run(Queue& queue, unsigned cnt)
+{
+  auto begin = chrono::steady_clock::now();
+  for (unsigned i=0; i<cnt; i++) {
+    queue.insert(fakeClause(i));
+  }
+  for (unsigned i=0; i<cnt; i+=3) {
+    queue.remove(fakeClause(i));
+  }
+  while (!queue.isEmpty()) {
+    queue.pop();
+  }
+  auto end = chrono::steady_clock::now();
+
+  return chrono::duration<double>(end-begin).count();
+}
+
+}
+
+TEST_FUN(clauseBucketQueue_throughput)
+{
+  Allocator::setMemoryLimit(4000000000u);
+
+  cout << endl << "clauses   skip list s  buckets s" << endl;
+  for (unsigned cnt = 1000000; cnt<=10000000; cnt *= 10) {
+    initKeys(cnt);
+    double skipList;
+    {
+      SkipListQueue queue;
+      skipList = run(queue, cnt);
+    }
+    double buckets;
+    {
+      BucketQueue queue;
+      buckets = run(queue, cnt);
+    }
+    cout << cnt << "\t  " << skipList << "\t       " << buckets << endl;
+  }
+}
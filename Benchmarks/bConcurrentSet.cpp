@@ -0,0 +1,129 @@
+
+/*
+ * File bConcurrentSet.cpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions.
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide.
+ */
+/**
+ * @file bConcurrentSet.cpp
+ * Benchmark of the insertion throughput of ConcurrentSet with an
+ * increasing number of threads, see UnitTests/tConcurrentSet.cpp for
+ * the tests.
+ */
+
+#include <chrono>
+#include <iostream>
+#include <pthread.h>
+
+#include "Lib/ConcurrentSet.hpp"
+#include "Lib/DArray.hpp"
+#include "Lib/Hash.hpp"
+
+#include "Test/UnitTesting.hpp"
+
+#define UNIT_ID concurrentSet
+UT_CREATE;
+
+using namespace std;
+using namespace Lib;
+
+namespace {
+
+/** The nodes of tConcurrentSet.cpp, one copy of each node per thread */
+struct Node {
+  unsigned functor;
+  unsigned args[2];
+};
+
+struct NodeHash {
+  static unsigned hash(const Node* n)
+  {
+    unsigned res = HashUtils::combine(2166136261u, n->functor);
+    res = HashUtils::combine(res, n->args[0]);
+    return HashUtils::combine(res, n->args[1]);
+  }
+  static bool equals(const Node* n1, const Node* n2)
+  {
+    return n1->functor==n2->functor && n1->args[0]==n2->args[0] && n1->args[1]==n2->args[1];
+  }
+};
+
+typedef ConcurrentSet<Node*,NodeHash> NodeSet;
+
+struct Worker {
+  NodeSet* set;
+  Node* nodes;
+  unsigned cnt;
+  /** The worker inserts the nodes starting from this one */
+  unsigned start;
+};
+
+void* insertNodes(void* arg)
+{
+  Worker* w = static_cast<Worker*>(arg);
+  for (unsigned i=0; i<w->cnt; i++) {
+    w->set->insert(&w->nodes[(w->start+i)%w->cnt]);
+  }
+  return 0;
+}
+
+/**
+ * Return the time in seconds in which @b threadCnt threads insert their
+ * own copies of @b cnt distinct nodes into a set
+ */
+double insertInParallel(unsigned threadCnt, unsigned cnt)
+{
+  NodeSet set;
+  DArray<Node> nodes(threadCnt*cnt);
+  DArray<Worker> workers(threadCnt);
+  DArray<pthread_t> threads(threadCnt);
+
+  for (unsigned t=0; t<threadCnt; t++) {
+    for (unsigned i=0; i<cnt; i++) {
+      Node& n = nodes[t*cnt+i];
+      n.functor = i%7;
+      n.args[0] = i;
+      n.args[1] = i*31;
+    }
+    workers[t].set = &set;
+    workers[t].nodes = nodes.array()+t*cnt;
+    workers[t].cnt = cnt;
+    workers[t].start = t*(cnt/threadCnt);
+  }
+
+  auto begin = chrono::steady_clock::now();
+  for (unsigned t=0; t<threadCnt; t++) {
+    pthread_create(&threads[t], 0, insertNodes, &workers[t]);
+  }
+  for (unsigned t=0; t<threadCnt; t++) {
+    pthread_join(threads[t], 0);
+  }
+  auto end = chrono::steady_clock::now();
+
+  return chrono::duration<double>(end-begin).count();
+}
+
+}
+
+TEST_FUN(concurrentSet_throughput)
+{
+  const unsigned cnt = 200000;
+
+  cout << endl << "threads  inserts/s" << endl;
+  for (unsigned threadCnt = 1; threadCnt<=8; threadCnt *= 2) {
+    double time = insertInParallel(threadCnt, cnt);
+    cout << threadCnt << "\t " << (unsigned long)(threadCnt*cnt/time) << endl;
+  }
+}
@@ -0,0 +1,166 @@
+
+/*
+ * File bFingerprintIndex.cpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions.
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide.
+ */
+/**
+ * @file bFingerprintIndex.cpp
+ * Benchmark of FingerprintIndex against TermSubstitutionTree, see
+ * UnitTests/tFingerprintIndex.cpp for the tests.
+ */
+
+#include <chrono>
+#include <iostream>
+
+#include "Lib/DArray.hpp"
+#include "Lib/Random.hpp"
+#include "Lib/Stack.hpp"
+
+#include "Kernel/Clause.hpp"
+#include "Kernel/Term.hpp"
+
+#include "Indexing/FingerprintIndex.hpp"
+#include "Indexing/ResultSubstitution.hpp"
+#include "Indexing/TermSubstitutionTree.hpp"
+
+#include "Test/RandomTerms.hpp"
+#include "Test/UnitTesting.hpp"
+
+#define UNIT_ID fingerprint_index
+UT_CREATE;
+
+using namespace std;
+using namespace Lib;
+using namespace Kernel;
+using namespace Indexing;
+using namespace Test;
+
+namespace {
+
+const unsigned TERMS = 10000;
+const unsigned QUERIES = 2000;
+
+enum Retrieval {
+  UNIFICATIONS,
+  GENERALIZATIONS,
+  INSTANCES
+};
+
+/**
+ * Insert the same @b TERMS random non-variable terms from @b rt into
+ * both indexes and store them and their clauses into @b terms and
+ * @b clauses
+ */
+void fill(RandomTerms& rt, TermIndexingStructure& tree, TermIndexingStructure& fp,
+    DArray<TermList>& terms, DArray<Clause*>& clauses)
+{
+  terms.ensure(TERMS);
+  clauses.ensure(TERMS);
+  for (unsigned i=0; i<TERMS; i++) {
+    TermList t;
+    do {
+      t = rt.term(4, 10);
+    } while (t.isVar());
+    Stack<Literal*> lits;
+    lits.push(Literal::create(rt.p, 1, true, false, &t));
+    Clause* cl = RandomTerms::clause(lits);
+    clauses[i] = cl;
+    terms[i] = t;
+    tree.insert(t, (*cl)[0], cl);
+    fp.insert(t, (*cl)[0], cl);
+  }
+}
+
+/** Remove every third of the @b terms from both indexes */
+void removeSome(TermIndexingStructure& tree, TermIndexingStructure& fp,
+    DArray<TermList>& terms, DArray<Clause*>& clauses)
+{
+  for (unsigned i=0; i<TERMS; i+=3) {
+    tree.remove(terms[i], (*clauses[i])[0], clauses[i]);
+    fp.remove(terms[i], (*clauses[i])[0], clauses[i]);
+  }
+}
+
+TermQueryResultIterator retrieve(TermIndexingStructure& is, TermList query, Retrieval kind, bool subst)
+{
+  switch (kind) {
+  case UNIFICATIONS:
+    return is.getUnifications(query, subst);
+  case GENERALIZATIONS:
+    return is.getGeneralizations(query, subst);
+  default:
+    return is.getInstances(query, subst);
+  }
+}
+
+/** Return the time it took in seconds to ask all @b queries to @b is */
+double measure(TermIndexingStructure& is, Stack<TermList>& queries, Retrieval kind, size_t& cnt)
+{
+  cnt = 0;
+  auto begin = chrono::steady_clock::now();
+  for (unsigned i=0; i<queries.size(); i++) {
+    TermQueryResultIterator rit = retrieve(is, queries[i], kind, true);
+    while (rit.hasNext()) {
+      rit.next();
+      cnt++;
+    }
+  }
+  auto end = chrono::steady_clock::now();
+  return chrono::duration<double>(end-begin).count();
+}
+
+void compare(TermIndexingStructure& tree, TermIndexingStructure& fp, Stack<TermList>& queries, Retrieval kind)
+{
+  size_t treeCnt;
+  size_t fpCnt;
+  double treeTime = measure(tree, queries, kind, treeCnt);
+  double fpTime = measure(fp, queries, kind, fpCnt);
+  ASS_EQ(treeCnt, fpCnt);
+
+  static const char* names[] = { "unifications", "generalizations", "instances" };
+  cout << names[kind] << "\t" << treeCnt << "\t  "
+       << static_cast<unsigned>(queries.size()/treeTime) << "\t    "
+       << static_cast<unsigned>(queries.size()/fpTime) << endl;
+}
+
+}
+
+TEST_FUN(fingerprint_retrieval)
+{
+  RandomTerms rt;
+  Random::setSeed(1);
+
+  TermSubstitutionTree tree;
+  FingerprintIndex fp;
+  DArray<TermList> terms;
+  DArray<Clause*> clauses;
+  fill(rt, tree, fp, terms, clauses);
+
+  Stack<TermList> queries;
+  for (unsigned i=0; i<QUERIES; i++) {
+    queries.push(rt.term(3, 10));
+  }
+
+  cout << endl << "retrieval\tresults\t  tree q/s  fingerprint q/s" << endl;
+  compare(tree, fp, queries, UNIFICATIONS);
+  compare(tree, fp, queries, GENERALIZATIONS);
+  compare(tree, fp, queries, INSTANCES);
+
+  removeSome(tree, fp, terms, clauses);
+  compare(tree, fp, queries, UNIFICATIONS);
+  compare(tree, fp, queries, GENERALIZATIONS);
+  compare(tree, fp, queries, INSTANCES);
+}
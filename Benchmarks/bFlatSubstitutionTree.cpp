@@ -0,0 +1,138 @@
+
+/*
+ * File bFlatSubstitutionTree.cpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions.
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide.
+ */
+/**
+ * @file bFlatSubstitutionTree.cpp
+ * Benchmark of the retrieval of generalizations from LiteralSubstitutionTree
+ * with and without the FlatTree copies of the roots, see
+ * UnitTests/tFlatSubstitutionTree.cpp for the tests.
+ *
+ * The queries are timed before and after some literals are removed, so
+ * the second time includes making the copies again.
+ */
+
+#include <chrono>
+#include <iostream>
+
+#include "Lib/DArray.hpp"
+#include "Lib/Random.hpp"
+#include "Lib/Stack.hpp"
+
+#include "Kernel/Clause.hpp"
+#include "Kernel/Term.hpp"
+
+#include "Indexing/LiteralSubstitutionTree.hpp"
+
+#include "Test/RandomTerms.hpp"
+#include "Test/UnitTesting.hpp"
+
+#define UNIT_ID flat_subst_tree
+UT_CREATE;
+
+using namespace std;
+using namespace Lib;
+using namespace Kernel;
+using namespace Indexing;
+using namespace Test;
+
+namespace {
+
+const unsigned LITERALS = 20000;
+const unsigned QUERIES = 50000;
+
+/**
+ * Insert the same @b LITERALS random unit clauses from @b rt into both
+ * trees and store them into @b clauses
+ */
+void fill(RandomTerms& rt, LiteralSubstitutionTree& plain, LiteralSubstitutionTree& flat, DArray<Clause*>& clauses)
+{
+  clauses.ensure(LITERALS);
+  for (unsigned i=0; i<LITERALS; i++) {
+    Stack<Literal*> lits;
+    lits.push(rt.literal(3, 8, true));
+    Clause* cl = RandomTerms::clause(lits);
+    clauses[i] = cl;
+    plain.insert((*cl)[0], cl);
+    flat.insert((*cl)[0], cl);
+  }
+}
+
+/** Remove every third of the @b clauses from both trees */
+void removeSome(LiteralSubstitutionTree& plain, LiteralSubstitutionTree& flat, DArray<Clause*>& clauses)
+{
+  for (unsigned i=0; i<LITERALS; i+=3) {
+    plain.remove((*clauses[i])[0], clauses[i]);
+    flat.remove((*clauses[i])[0], clauses[i]);
+  }
+}
+
+/**
+ * Ask all @b queries to @b tree, store the number of results into
+ * @b results and return the time it took in seconds
+ */
+double retrieve(LiteralSubstitutionTree& tree, Stack<Literal*>& queries, size_t& results)
+{
+  results = 0;
+  auto begin = chrono::steady_clock::now();
+  for (unsigned i=0; i<queries.size(); i++) {
+    SLQueryResultIterator rit = tree.getGeneralizations(queries[i], false, false);
+    while (rit.hasNext()) {
+      rit.next();
+      results++;
+    }
+  }
+  auto end = chrono::steady_clock::now();
+  return chrono::duration<double>(end-begin).count();
+}
+
+/** Time the queries to both trees */
+void compare(LiteralSubstitutionTree& plain, LiteralSubstitutionTree& flat, Stack<Literal*>& queries)
+{
+  size_t plainResults;
+  size_t flatResults;
+  double plainTime = retrieve(plain, queries, plainResults);
+  double flatTime = retrieve(flat, queries, flatResults);
+  ASS_EQ(plainResults, flatResults);
+
+  cout << queries.size() << "\t " << plainResults << "\t  "
+       << static_cast<unsigned>(queries.size()/plainTime) << "\t     "
+       << static_cast<unsigned>(queries.size()/flatTime) << endl;
+}
+
+}
+
+TEST_FUN(flat_generalizations)
+{
+  RandomTerms rt;
+  Random::setSeed(1);
+
+  LiteralSubstitutionTree plain;
+  LiteralSubstitutionTree flat(false, true);
+  DArray<Clause*> clauses;
+  fill(rt, plain, flat, clauses);
+
+  Stack<Literal*> queries;
+  for (unsigned i=0; i<QUERIES; i++) {
+    queries.push(rt.literal(4, 20, true));
+  }
+  cout << endl << "queries  results  plain q/s  flat q/s" << endl;
+  compare(plain, flat, queries);
+
+  removeSome(plain, flat, clauses);
+  compare(plain, flat, queries);
+}
@@ -0,0 +1,129 @@
+
+/*
+ * File bKBO.cpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions.
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide.
+/**
+ * @file bKBO.cpp
+ * Benchmark of KBO with and without the option kbo_cache, see
+ * UnitTests/tKBO.cpp for the tests.
+ *
+ * A stream of comparisons of random shared terms is recorded and then
+ * replayed by both orderings. As in forward demodulation, most of the
+ * comparisons in the stream repeat pairs that were compared before.
+ */
+
+#include <chrono>
+#include <iostream>
+
+#include "Lib/DArray.hpp"
+#include "Lib/Random.hpp"
+#include "Lib/Stack.hpp"
+
+#include "Kernel/KBO.hpp"
+#include "Kernel/Problem.hpp"
+#include "Kernel/Term.hpp"
+
+#include "Shell/Options.hpp"
+
+#include "Test/RandomTerms.hpp"
+#include "Test/UnitTesting.hpp"
+
+#define UNIT_ID kbo
+UT_CREATE;
+
+using namespace std;
+using namespace Lib;
+using namespace Kernel;
+using namespace Shell;
+using namespace Test;
+
+namespace {
+
+/** Number of distinct terms in the stream */
+const unsigned TERMS = 5000;
+/** Number of pairs that are compared repeatedly */
+const unsigned HOT_PAIRS = 1000;
+const unsigned COMPARISONS = 2000000;
+
+/** Record a stream of @b COMPARISONS pairs of terms into @b lhs and @b rhs */
+void recordStream(Stack<TermList>& lhs, Stack<TermList>& rhs)
+{
+  RandomTerms rt;
+
+  Random::setSeed(1);
+  DArray<TermList> terms(TERMS);
+  for (unsigned i=0; i<TERMS; i++) {
+    terms[i] = rt.term(6, 8);
+  }
+  DArray<unsigned> hot(2*HOT_PAIRS);
+  for (unsigned i=0; i<2*HOT_PAIRS; i++) {
+    hot[i] = Random::getInteger(TERMS);
+  }
+
+  for (unsigned i=0; i<COMPARISONS; i++) {
+    if (Random::getInteger(10)) {
+      unsigned p = Random::getInteger(HOT_PAIRS);
+      lhs.push(terms[hot[2*p]]);
+      rhs.push(terms[hot[2*p+1]]);
+    }
+    else {
+      lhs.push(terms[Random::getInteger(TERMS)]);
+      rhs.push(terms[Random::getInteger(TERMS)]);
+    }
+  }
+}
+
+/**
+ * Replay the stream with @b ord and return the time it took in seconds.
+ * The number of greater results is added to @b greater so that the
+ * comparisons are not optimized away.
+ */
+double replay(const Ordering& ord, Stack<TermList>& lhs, Stack<TermList>& rhs, unsigned& greater)
+{
+  auto begin = chrono::steady_clock::now();
+  for (unsigned i=0; i<lhs.size(); i++) {
+    if (ord.compare(lhs[i], rhs[i]) == Ordering::Result::GREATER) {
+      greater++;
+    }
+  }
+  auto end = chrono::steady_clock::now();
+  return chrono::duration<double>(end-begin).count();
+}
+
+}
+
+TEST_FUN(kbo_cache)
+{
+  Stack<TermList> lhs;
+  Stack<TermList> rhs;
+  recordStream(lhs, rhs);
+
+  Problem prb;
+  Options plainOpt;
+  KBO plain(prb, plainOpt);
+  Options cachedOpt;
+  cachedOpt.set("kbo_cache","on");
+  KBO cached(prb, cachedOpt);
+
+  unsigned plainGreater = 0;
+  unsigned cachedGreater = 0;
+  double plainTime = replay(plain, lhs, rhs, plainGreater);
+  double cachedTime = replay(cached, lhs, rhs, cachedGreater);
+  ASS_EQ(plainGreater, cachedGreater);
+
+  cout << endl << "comparisons  plain s  cached s" << endl;
+  cout << lhs.size() << "\t     " << plainTime << "\t" << cachedTime << endl;
+}
@@ -0,0 +1,189 @@
+
+/*
+ * File bMLMatcher.cpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions.
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide.
+ */
+/**
+ * @file bMLMatcher.cpp
+ * Benchmark of MLMatcher with and without the bitsets of alternatives,
+ * see UnitTests/tMLMatcher.cpp for the tests.
+ *
+ * The recorded subsumption queries are replayed several times with the
+ * option mlmatcher_bitsets off and on.
+ */
+
+#include <chrono>
+#include <iostream>
+
+#include "Lib/DArray.hpp"
+#include "Lib/Environment.hpp"
+#include "Lib/List.hpp"
+#include "Lib/Random.hpp"
+#include "Lib/Stack.hpp"
+
+#include "Kernel/Clause.hpp"
+#include "Kernel/Matcher.hpp"
+#include "Kernel/MLMatcher.hpp"
+#include "Kernel/SubstHelper.hpp"
+#include "Kernel/Substitution.hpp"
+#include "Kernel/Term.hpp"
+
+#include "Shell/Options.hpp"
+
+#include "Test/RandomTerms.hpp"
+#include "Test/UnitTesting.hpp"
+
+#define UNIT_ID ml_matcher
+UT_CREATE;
+
+using namespace std;
+using namespace Lib;
+using namespace Kernel;
+using namespace Test;
+
+namespace {
+
+const unsigned QUERIES = 20000;
+const unsigned ROUNDS = 20;
+
+/** A recorded call of MLMatcher::canBeMatched */
+struct Query {
+  Clause* base;
+  Clause* instance;
+  LiteralList** alts;
+};
+
+/**
+ * Record the query whether @b base subsumes @b instance into @b queries,
+ * unless some literal of @b base matches no literal of @b instance, as
+ * the callers of MLMatcher do not ask in that case.
+ */
+void record(Clause* base, Clause* instance, Stack<Query>& queries)
+{
+  unsigned blen = base->length();
+  unsigned ilen = instance->length();
+  LiteralList** alts = new LiteralList*[blen];
+  for (unsigned bi=0; bi<blen; bi++) {
+    alts[bi] = 0;
+    for (unsigned ii=0; ii<ilen; ii++) {
+      if (MatchingUtils::match((*base)[bi], (*instance)[ii], false)) {
+        LiteralList::push((*instance)[ii], alts[bi]);
+      }
+    }
+    if (!alts[bi]) {
+      for (unsigned j=0; j<=bi; j++) {
+        LiteralList::destroy(alts[j]);
+      }
+      delete[] alts;
+      return;
+    }
+  }
+  Query q;
+  q.base = base;
+  q.instance = instance;
+  q.alts = alts;
+  queries.push(q);
+}
+
+/** Record @b QUERIES queries between random clauses from @b rt into @b queries */
+void recordQueries(RandomTerms& rt, Stack<Query>& queries)
+{
+  while (queries.size()<QUERIES) {
+    Stack<Literal*> lits;
+    unsigned blen = 4+Random::getInteger(5);
+    for (unsigned j=0; j<blen; j++) {
+      lits.push(rt.literal(1, 2));
+    }
+    Clause* base = RandomTerms::clause(lits);
+
+    //an instance of the base clause, some of whose literals may coincide,
+    //with some extra literals, or a random ground clause
+    Stack<Literal*> ilits;
+    if (Random::getBit()) {
+      Substitution subst;
+      for (unsigned var=0; var<4; var++) {
+        subst.bind(var, rt.term(0, 0));
+      }
+      for (unsigned j=0; j<blen; j++) {
+        Literal* ilit = SubstHelper::apply(lits[j], subst);
+        if (!ilits.find(ilit)) {
+          ilits.push(ilit);
+        }
+      }
+    }
+    unsigned extra = Random::getInteger(4);
+    for (unsigned j=0; j<extra; j++) {
+      Literal* ilit = rt.literal(0, 0);
+      if (!ilits.find(ilit)) {
+        ilits.push(ilit);
+      }
+    }
+    record(base, RandomTerms::clause(ilits), queries);
+  }
+}
+
+void destroyQueries(Stack<Query>& queries)
+{
+  for (unsigned i=0; i<queries.size(); i++) {
+    unsigned blen = queries[i].base->length();
+    for (unsigned bi=0; bi<blen; bi++) {
+      LiteralList::destroy(queries[i].alts[bi]);
+    }
+    delete[] queries[i].alts;
+  }
+}
+
+/** Replay @b queries, return the number of subsumed ones in @b subsumed and the time it took in seconds */
+double replay(Stack<Query>& queries, bool bitsets, unsigned& subsumed)
+{
+  env.options->set("mlmatcher_bitsets", bitsets ? "on" : "off");
+  subsumed = 0;
+  auto begin = chrono::steady_clock::now();
+  for (unsigned round=0; round<ROUNDS; round++) {
+    for (unsigned i=0; i<queries.size(); i++) {
+      Query& q = queries[i];
+      if (MLMatcher::canBeMatched(q.base, q.instance, q.alts, 0)) {
+        subsumed++;
+      }
+    }
+  }
+  auto end = chrono::steady_clock::now();
+  subsumed /= ROUNDS;
+  return chrono::duration<double>(end-begin).count();
+}
+
+}
+
+TEST_FUN(ml_matcher_bitsets)
+{
+  RandomTerms rt;
+  Random::setSeed(1);
+
+  Stack<Query> queries;
+  recordQueries(rt, queries);
+
+  unsigned plainSubsumed;
+  unsigned bitsetSubsumed;
+  double plainTime = replay(queries, false, plainSubsumed);
+  double bitsetTime = replay(queries, true, bitsetSubsumed);
+  ASS_EQ(plainSubsumed, bitsetSubsumed);
+
+  cout << endl << "queries: " << QUERIES << ", subsumed: " << plainSubsumed << endl
+       << "without bitsets: " << static_cast<unsigned>(ROUNDS*QUERIES/plainTime) << " q/s" << endl
+       << "with bitsets:    " << static_cast<unsigned>(ROUNDS*QUERIES/bitsetTime) << " q/s" << endl;
+
+  destroyQueries(queries);
+}
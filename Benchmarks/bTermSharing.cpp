@@ -0,0 +1,150 @@
+/*
+ * File bTermSharing.cpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions.
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide.
+ */
+/**
+ * @file bTermSharing.cpp
+ * Benchmark of the insertion of terms into TermSharing with an
+ * increasing number of threads, see UnitTests/tTermSharing.cpp for the
+ * tests. Several threads are used only in builds with
+ * CONCURRENT_TERM_SHARING=1, e.g.
+ * make vbench XFLAGS="-O3 -DVDEBUG=0 -DCONCURRENT_TERM_SHARING=1 -DTHREAD_SAFE_ALLOCATION=1"
+ */
+
+#include <chrono>
+#include <iostream>
+#include <pthread.h>
+
+#include "Lib/Allocator.hpp"
+#include "Lib/DArray.hpp"
+#include "Lib/Environment.hpp"
+#include "Lib/Int.hpp"
+
+#include "Kernel/Signature.hpp"
+#include "Kernel/Term.hpp"
+
+#include "Indexing/TermSharing.hpp"
+
+#include "Test/UnitTesting.hpp"
+
+#define UNIT_ID termSharing
+UT_CREATE;
+
+using namespace std;
+using namespace Lib;
+using namespace Kernel;
+
+namespace {
+
+/** Number of terms created by each thread */
+const unsigned TERMS = 200000;
+/** Number of distinct constants the terms are built from */
+const unsigned LEAVES = 16;
+
+struct Worker {
+  unsigned f, g, h;
+  /** The constants at the leaves */
+  TermList* leaves;
+  /** The terms created by this worker */
+  Term** terms;
+};
+
+/**
+ * Create the terms 0 to TERMS-1 in the same way as tTermSharing.cpp
+ */
+void* createTerms(void* arg)
+{
+#if THREAD_SAFE_ALLOCATION
+  Allocator::ThreadInitialiser init;
+#endif
+  Worker* w = static_cast<Worker*>(arg);
+  for (unsigned i=0; i<TERMS; i++) {
+    unsigned hash = i*2654435761u;
+    TermList a = i<LEAVES ? w->leaves[i] : TermList(w->terms[hash%i]);
+    TermList b = i<LEAVES ? w->leaves[(i+1)%LEAVES] : TermList(w->terms[(hash>>16)%i]);
+    switch (hash%3) {
+    case 0:
+      w->terms[i] = Term::create2(w->f, a, b);
+      break;
+    case 1:
+      w->terms[i] = Term::create2(w->g, a, b);
+      break;
+    default:
+      w->terms[i] = Term::create1(w->h, a);
+      break;
+    }
+  }
+  return 0;
+}
+
+/**
+ * Return the number of insertions per second done by @b threadCnt
+ * threads creating the same terms over the constants named after @b round
+ */
+double measure(const Worker& proto, unsigned threadCnt, unsigned round)
+{
+  TermList leaves[LEAVES];
+  for (unsigned i=0; i<LEAVES; i++) {
+    leaves[i] = TermList(Term::createConstant("c"+Int::toString(round)+"_"+Int::toString(i)));
+  }
+  DArray<Term*> terms(threadCnt*TERMS);
+  DArray<Worker> workers(threadCnt);
+  DArray<pthread_t> threads(threadCnt);
+  for (unsigned t=0; t<threadCnt; t++) {
+    workers[t] = proto;
+    workers[t].leaves = leaves;
+    workers[t].terms = terms.array()+t*TERMS;
+  }
+
+  auto begin = chrono::steady_clock::now();
+  for (unsigned t=0; t<threadCnt; t++) {
+    pthread_create(&threads[t], 0, createTerms, &workers[t]);
+  }
+  for (unsigned t=0; t<threadCnt; t++) {
+    pthread_join(threads[t], 0);
+  }
+  auto end = chrono::steady_clock::now();
+
+  return threadCnt*TERMS/chrono::duration<double>(end-begin).count();
+}
+
+}
+
+TEST_FUN(termSharing_throughput)
+{
+#if CONCURRENT_TERM_SHARING
+  const unsigned maxThreads = 8;
+#else
+  const unsigned maxThreads = 1;
+#endif
+
+  Worker proto;
+  proto.f = env.signature->addFunction("f",2);
+  proto.g = env.signature->addFunction("g",2);
+  proto.h = env.signature->addFunction("h",1);
+  // the default types are created on first use, which must not happen
+  // in several threads at once
+  env.signature->getFunction(proto.f)->fnType();
+  env.signature->getFunction(proto.g)->fnType();
+  env.signature->getFunction(proto.h)->fnType();
+
+  cout << endl << "threads  insertions/s" << endl;
+  unsigned round = 0;
+  for (unsigned threadCnt = 1; threadCnt<=maxThreads; threadCnt *= 2) {
+    double rate = measure(proto, threadCnt, round++);
+    cout << threadCnt << "\t " << (unsigned long)rate << endl;
+  }
+}
@@ -21,6 +21,7 @@
  * Implements class PortfolioMode.
  */
 
+#include "Lib/Allocator.hpp"
 #include "Lib/Environment.hpp"
 #include "Lib/Int.hpp"
 #include "Lib/Portability.hpp"
@@ -41,6 +42,7 @@
 #else
 #include <unistd.h>
 #endif
+#include "Saturation/LemmaExchange.hpp"
 #include "Saturation/ProvingHelper.hpp"
 
 #include "Kernel/Problem.hpp"
@@ -52,7 +54,7 @@
 using namespace Lib;
 using namespace CASC;
 
-PortfolioMode::PortfolioMode() : _slowness(1.0), _syncSemaphore(2) {
+PortfolioMode::PortfolioMode() : _slowness(1.0), _sharedMemory(0), _numWorkers(1), _syncSemaphore(2) {
   // We need the following two values because the way the semaphore class is currently implemented:
   // 1) dec is the only operation which is blocking
   // 2) dec is done in the mode SEM_UNDO, so is undone when a process terminates
@@ -137,9 +139,17 @@ bool PortfolioMode::searchForProof()
     TheoryFinder(_prb->units(),property).search();
   }
 
+  if (env.options->lemmaExchange()) {
+    // the symbols known at this point are the same in all the slices
+    _lemmaExchange = new Saturation::LemmaExchange();
+  }
+
   // now all the cpu usage will be in children, we'll just be waiting for them
   Timer::setTimeLimitEnforcement(false);
 
+  // everything allocated so far is inherited by the children
+  _sharedMemory = Allocator::getUsedMemory();
+
   return performStrategy(property);
 }
 
@@ -468,6 +478,7 @@ bool PortfolioMode::runSchedule(Schedule& schedule, int terminationTime)
   PortfolioProcessPriorityPolicy policy;
   PortfolioSliceExecutor executor(this);
   ScheduleExecutor sched(&policy, &executor);
+  _numWorkers = sched.numWorkers();
 
   return sched.run(schedule, terminationTime);
 }
@@ -546,6 +557,28 @@ void PortfolioMode::runSlice(vstring sliceCode, unsigned timeLimitInDeciseconds)
   runSlice(opt);
 } // runSlice
 
+/**
+ * Restrict the memory limit of the current slice so that all the slices
+ * running at the same time together respect the global memory limit.
+ *
+ * The memory allocated by the parent before forking (the problem and the
+ * term sharing structures) is counted once, the rest of the limit is
+ * divided evenly among the concurrently running slices.
+ */
+void PortfolioMode::splitMemoryLimit()
+{
+  CALL("PortfolioMode::splitMemoryLimit");
+
+  if (_numWorkers<=1) {
+    return;
+  }
+  size_t limit = Allocator::getMemoryLimit();
+  if (limit<=_sharedMemory) {
+    return;
+  }
+  Allocator::setMemoryLimit(_sharedMemory + (limit-_sharedMemory)/_numWorkers);
+} // splitMemoryLimit
+
 /**
  * Run a slice given by its options
  */
@@ -569,6 +602,10 @@ void PortfolioMode::runSlice(Options& strategyOpt)
   opt.checkGlobalOptionConstraints();
   *env.options = opt; //just temporarily until we get rid of dependencies on env.options in solving
 
+  if (opt.splitMemoryLimit()) {
+    splitMemoryLimit();
+  }
+
   if (outputAllowed()) {
     env.beginOutput();
     addCommentSignForSZS(env.out()) << opt.testId() << " on " << opt.problemName() << endl;
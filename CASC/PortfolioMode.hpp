@@ -90,6 +90,7 @@ private:
   bool waitForChildAndCheckIfProofFound();
   void runSlice(vstring slice, unsigned timeLimitInDeciseconds) NO_RETURN;
   void runSlice(Options& strategyOpt) NO_RETURN;
+  void splitMemoryLimit();
 
 #if VDEBUG
   DHSet<pid_t> childIds;
@@ -97,6 +98,15 @@ private:
 
   float _slowness;
 
+  /**
+   * Memory allocated before the first slice is spawned. It is shared
+   * (copy-on-write) by all the slices, so when the memory limit is split
+   * among slices it is counted only once.
+   */
+  size_t _sharedMemory;
+  /** Number of slices running at the same time */
+  unsigned _numWorkers;
+
   /**
    * Problem that is being solved.
    *
@@ -105,6 +115,9 @@ private:
    */
   ScopedPtr<Problem> _prb;
 
+  /** Lemmas shared by the slices, if lemma_exchange is on */
+  ScopedPtr<Saturation::LemmaExchange> _lemmaExchange;
+
   Semaphore _syncSemaphore; // semaphore for synchronizing proof printing
 };
 
@@ -28,6 +28,8 @@ class ScheduleExecutor
 public:
   ScheduleExecutor(ProcessPriorityPolicy *policy, SliceExecutor *executor);
   bool run(const Schedule &schedule, int terminationTime);
+  /** Return the number of slices that are allowed to run at the same time */
+  unsigned numWorkers() const { return _numWorkers; }
 
 private:
   pid_t spawn(Lib::vstring code, int terminationTime);
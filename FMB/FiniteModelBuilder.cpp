@@ -26,6 +26,7 @@
  */
 
 #include <math.h>
+#include <csignal>
 
 #include "Kernel/Ordering.hpp"
 #include "Kernel/Inference.hpp"
@@ -41,6 +42,8 @@
 
 #include "SAT/Preprocess.hpp"
 #include "SAT/TWLSolver.hpp"
+#include "SAT/CDCLSolver.hpp"
+#include "SAT/LingelingInterfacing.hpp"
 #include "SAT/MinisatInterfacingNewSimp.hpp"
 #include "SAT/BufferedSolver.hpp"
 
@@ -53,6 +56,8 @@
 #include "Lib/Random.hpp"
 #include "Lib/DHSet.hpp"
 #include "Lib/ArrayMap.hpp"
+#include "Lib/Sys/Multiprocessing.hpp"
+#include "Lib/Sys/SyncPipe.hpp"
 
 #include "Shell/UIHelper.hpp"
 #include "Shell/TPTPPrinter.hpp"
@@ -80,6 +85,46 @@
 namespace FMB 
 {
 
+// the number of SAT clauses that are passed to the SAT solver at once
+static const unsigned SAT_CLAUSE_BLOCK_SIZE = 1<<16;
+
+// the worker processes that are running, so that they can be killed when we terminate
+static Stack<pid_t>* s_workers = 0;
+
+static void killWorkers()
+{
+  if(!s_workers) {
+    return;
+  }
+#ifdef _WIN32
+#else
+  Stack<pid_t>::Iterator it(*s_workers);
+  while(it.hasNext()) {
+    Sys::Multiprocessing::instance()->killNoCheck(it.next(), SIGKILL);
+  }
+#endif
+  s_workers = 0;
+}
+
+// in a worker, the pipe to the parent until we have reported our result
+static Sys::SyncPipe* s_workerPipe = 0;
+
+// in a worker, tell the parent that we terminate without a result (time limit, out of memory, ...)
+static void workerTerminated()
+{
+  if(!s_workerPipe) {
+    return;
+  }
+  Sys::SyncPipe* pipe = s_workerPipe;
+  s_workerPipe = 0;
+  if(!pipe->isWriting()) {
+    pipe->acquireWrite();
+  }
+  bool timeLimit = env.statistics->terminationReason == Statistics::TerminationReason::TIME_LIMIT;
+  pipe->out() << System::getPID() << (timeLimit ? " T" : " G") << endl;
+  pipe->releaseWrite();
+}
+
 FiniteModelBuilder::FiniteModelBuilder(Problem& prb, const Options& opt)
 : MainLoop(prb, opt), _sortedSignature(0), _groundClauses(0), _clauses(0),
                       _isAppropriate(true)
@@ -145,6 +190,14 @@ FiniteModelBuilder::FiniteModelBuilder(Problem& prb, const Options& opt)
     default:
       ASSERTION_VIOLATION;
   }
+  _incremental = opt.fmbIncremental() && !_xmass;
+  _lazyOption = opt.fmbLazyInstances() && !_incremental;
+  _instanceMemoryLimit = _incremental ? 0 : static_cast<size_t>(opt.fmbInstanceMemoryLimit())*1048576;
+  _lazyInstances = false;
+  _satClauseCount = 0;
+  _workers = (_xmass || _incremental) ? 1 : max(1u,opt.fmbWorkers());
+  _worker = false;
+  _workerPipe = 0;
 }
 
 FiniteModelBuilder::~FiniteModelBuilder()
@@ -158,17 +211,14 @@ FiniteModelBuilder::~FiniteModelBuilder()
   }
 }
 
-// Do all setting up required for finite model search 
-// Returns false we if we failed to reset, this can happen if offsets overflow 2^32, possible for
-// large signatures and large models. If this a frequent problem then we can go to longs.
-bool FiniteModelBuilder::reset(){
-  CALL("FiniteModelBuilder::reset");
-
-  // Construct the offsets for symbols
-  // Each symbol requires size^n) variables where n is the number of spaces for grounding
-  // For function symbols we have n=arity+1 as we have the return value
-  // For predicate symbols n=arity 
-
+// Construct the offsets for symbols
+// Each symbol requires size^n) variables where n is the number of spaces for grounding
+// For function symbols we have n=arity+1 as we have the return value
+// For predicate symbols n=arity 
+// Returns false if the offsets overflow
+bool FiniteModelBuilder::setSymbolOffsets(unsigned& offsets)
+{
+  CALL("FiniteModelBuilder::setSymbolOffsets");
 
   // This has been refined after adding multiple sorts i.e. no general 'size'
   // We now need the current size of the sort of each position to compute the offsets
@@ -176,7 +226,7 @@ bool FiniteModelBuilder::reset(){
   static const unsigned VAR_MAX = MinisatInterfacingNewSimp::VAR_MAX;
 
   // Start from 1 as SAT solver variables are 1-based
-  unsigned offsets=1;
+  offsets=1;
   for(unsigned f=0; f<env.signature->functions();f++){
     if(del_f[f]) continue; 
     f_offsets[f]=offsets;
@@ -187,9 +237,9 @@ bool FiniteModelBuilder::reset(){
     DArray<unsigned> f_signature = _sortedSignature->functionSignatures[f];
     ASS(f_signature.size() == env.signature->functionArity(f)+1);
 
-    unsigned add = _sortModelSizes[f_signature[0]]; 
+    unsigned add = _sortEncodingSizes[f_signature[0]]; 
     for(unsigned i=1;i<f_signature.size();i++){
-      add *= _sortModelSizes[f_signature[i]];
+      add *= _sortEncodingSizes[f_signature[i]];
     }
 
     // Check that we do not overflow
@@ -211,7 +261,7 @@ bool FiniteModelBuilder::reset(){
     ASS(p_signature.size()==env.signature->predicateArity(p));
     unsigned add=1;
     for(unsigned i=0;i<p_signature.size();i++){
-      add *= _sortModelSizes[p_signature[i]];
+      add *= _sortEncodingSizes[p_signature[i]];
     }
 
     // Check for overflow
@@ -220,15 +270,59 @@ bool FiniteModelBuilder::reset(){
     }
     offsets += add; 
   }
+  return true;
+}
+
+// Do all setting up required for finite model search 
+// Returns false we if we failed to reset, this can happen if offsets overflow 2^32, possible for
+// large signatures and large models. If this a frequent problem then we can go to longs.
+bool FiniteModelBuilder::reset(){
+  CALL("FiniteModelBuilder::reset");
+
+  static const unsigned VAR_MAX = MinisatInterfacingNewSimp::VAR_MAX;
+
+  if(_incremental && _solver && resetIncrementally()){
+    // the grounded terms depend on the sizes
+    createSymmetryOrdering();
+    return true;
+  }
+
+  _sortEncodingSizes.ensure(_sortedSignature->sorts);
+  _distinctSortEncodingSizes.ensure(_sortedSignature->distinctSorts);
+
+  unsigned offsets;
+  bool offsetsSet = false;
+  if(_incremental){
+    // leave room for the sizes to double before we need another reset
+    for(unsigned i=0;i<_distinctSortSizes.size();i++){
+      unsigned size = _distinctSortSizes[i];
+      _distinctSortEncodingSizes[i] = size > _distinctSortMaxs[i]/2 ? max(size,_distinctSortMaxs[i]) : 2*size;
+    }
+    for(unsigned s=0;s<_sortedSignature->sorts;s++) {
+      _sortEncodingSizes[s] = _distinctSortEncodingSizes[_sortedSignature->parents[s]];
+    }
+    offsetsSet = setSymbolOffsets(offsets);
+  }
+  if(!offsetsSet){
+    for(unsigned i=0;i<_distinctSortSizes.size();i++){
+      _distinctSortEncodingSizes[i] = _distinctSortSizes[i];
+    }
+    for(unsigned s=0;s<_sortedSignature->sorts;s++) {
+      _sortEncodingSizes[s] = _sortModelSizes[s];
+    }
+    if(!setSymbolOffsets(offsets)){
+      return false;
+    }
+  }
 
 #if VTRACE_FMB
   cout << "Maximum offset is " << offsets << endl;
 #endif
 
-  if (_xmass) {
+  if (_xmass || _incremental) {
     marker_offsets.ensure(_distinctSortSizes.size());
     for (unsigned i = 0; i < _distinctSortSizes.size(); i++) {
-      unsigned add = _distinctSortSizes[i];
+      unsigned add = _distinctSortEncodingSizes[i];
 
       marker_offsets[i] = offsets;
 
@@ -239,7 +333,23 @@ bool FiniteModelBuilder::reset(){
 
       offsets += add;
     }
-  } else {
+  }
+  if (_incremental) {
+    // the markers for the first sizes, further ones are added by resetIncrementally
+    unsigned add = _distinctSortSizes.size()+1;
+
+    // Check for overflow
+    if(VAR_MAX - add < offsets){
+      return false;
+    }
+
+    totalityMarker_offset = offsets;
+    symmetryMarker = offsets+_distinctSortSizes.size();
+    offsets += add;
+    _nextMarker = offsets;
+
+    _instantiatedSizes.reset();
+  } else if (!_xmass) {
     unsigned add = _distinctSortSizes.size();
 
     totalityMarker_offset = offsets;
@@ -261,9 +371,28 @@ bool FiniteModelBuilder::reset(){
     offsets += add;
   }
 
+  // the instances are added lazily if we are asked to or if they would take too much memory
+  _lazyInstances = _lazyOption || (_instanceMemoryLimit && estimateInstanceMemory() > _instanceMemoryLimit);
+
   // Create a new SAT solver
-  try{
-    _solver = new MinisatInterfacingNewSimp(_opt,true);
+  if(_opt.satSolver() == Options::SatSolver::CDCL){
+    _solver = new CDCLSolver(_opt,true);
+  }
+  else if(_opt.satSolver() == Options::SatSolver::LINGELING){
+    LingelingInterfacing* solver = new LingelingInterfacing(_opt,true);
+    if(!_incremental && !_lazyInstances){
+      // all the clauses are added before the only call to the solver
+      solver->enableVariableElimination();
+    }
+    _solver = solver;
+  }
+  else try{
+    MinisatInterfacingNewSimp* solver = new MinisatInterfacingNewSimp(_opt,true);
+    if(_incremental || _lazyInstances){
+      // clauses over all the variables will be added after solving
+      solver->disableVariableElimination();
+    }
+    _solver = solver;
   }catch(Minisat::OutOfMemoryException&){
     MinisatInterfacingNewSimp::reportMinisatOutOfMemory();
   }
@@ -304,6 +433,103 @@ bool FiniteModelBuilder::reset(){
   return true;
 }
 
+/**
+ * Prepare the SAT solver of the incremental mode for the current sizes. The markers
+ * of the totality definitions and symmetry axioms of the previous sizes are made false,
+ * which switches these constraints off for good, and fresh markers are taken for the
+ * current sizes.
+ *
+ * Return false if the current sizes do not fit into the encoding sizes, or if we run
+ * out of SAT variables for the markers. Then the solver must be reset.
+ */
+bool FiniteModelBuilder::resetIncrementally()
+{
+  CALL("FiniteModelBuilder::resetIncrementally");
+  ASS(_incremental);
+
+  static const unsigned VAR_MAX = MinisatInterfacingNewSimp::VAR_MAX;
+
+  for(unsigned i=0;i<_distinctSortSizes.size();i++){
+    if(_distinctSortSizes[i] > _distinctSortEncodingSizes[i]){
+      return false;
+    }
+  }
+  unsigned add = _distinctSortSizes.size()+1;
+  if(VAR_MAX - add < _nextMarker){
+    return false;
+  }
+
+  for(unsigned i=0;i<_distinctSortSizes.size();i++){
+    addSATClause(SATLiteral(totalityMarker_offset+i,0));
+  }
+  addSATClause(SATLiteral(symmetryMarker,0));
+
+  totalityMarker_offset = _nextMarker;
+  symmetryMarker = _nextMarker+_distinctSortSizes.size();
+  _nextMarker += add;
+  _solver->ensureVarCount(_nextMarker-1);
+
+  return true;
+}
+
+/**
+ * Return true if the groundings whose largest elements of each distinct sort are
+ * given by @b maxes (with 0 for the sorts not used) have been added for some earlier
+ * sizes in the incremental mode
+ */
+bool FiniteModelBuilder::instantiatedBefore(ArrayMap<unsigned>& maxes)
+{
+  CALL("FiniteModelBuilder::instantiatedBefore");
+
+  unsigned sorts = _distinctSortSizes.size();
+  for(unsigned pos=0;pos<_instantiatedSizes.size();pos+=sorts){
+    bool covered = true;
+    for(unsigned i=0;i<sorts;i++){
+      if(maxes.get(i,0) > _instantiatedSizes[pos+i]){
+        covered = false;
+        break;
+      }
+    }
+    if(covered){
+      return true;
+    }
+  }
+  return false;
+}
+
+/**
+ * Record that the instances and functional definitions of the current sizes have
+ * been added in the incremental mode. The sizes that are now covered by the current
+ * ones are forgotten.
+ */
+void FiniteModelBuilder::recordInstantiatedSizes()
+{
+  CALL("FiniteModelBuilder::recordInstantiatedSizes");
+
+  unsigned sorts = _distinctSortSizes.size();
+  unsigned kept = 0;
+  for(unsigned pos=0;pos<_instantiatedSizes.size();pos+=sorts){
+    bool covered = true;
+    for(unsigned i=0;i<sorts;i++){
+      if(_instantiatedSizes[pos+i] > _distinctSortSizes[i]){
+        covered = false;
+        break;
+      }
+    }
+    if(covered){
+      continue;
+    }
+    for(unsigned i=0;i<sorts;i++){
+      _instantiatedSizes[kept+i] = _instantiatedSizes[pos+i];
+    }
+    kept += sorts;
+  }
+  _instantiatedSizes.truncate(kept);
+  for(unsigned i=0;i<sorts;i++){
+    _instantiatedSizes.push(_distinctSortSizes[i]);
+  }
+}
+
 // Compare function symbols by their usage in the problem
 struct FMBSymmetryFunctionComparator
 {
@@ -924,6 +1150,8 @@ void FiniteModelBuilder::addGroundClauses()
 
   // If we don't have any ground clauses don't do anything
   if(!_groundClauses) return;
+  // The incremental SAT solver has them already unless it is new
+  if(_incremental && _instantiatedSizes.isNonEmpty()) return;
 
   ClauseList::Iterator cit(_groundClauses);
 
@@ -973,7 +1201,36 @@ unsigned FiniteModelBuilder::estimateInstanceCount()
   return res;
 }
 
-void FiniteModelBuilder::addNewInstances()
+// uses _distinctSortSizes to estimate how many bytes the instances would take in the SAT solver
+size_t FiniteModelBuilder::estimateInstanceMemory()
+{
+  CALL("FiniteModelBuilder::estimateInstanceMemory");
+  size_t res = 0;
+  ClauseList::Iterator cit(_clauses);
+
+  while(cit.hasNext()){
+    size_t instances = 1;
+
+    Clause* c = cit.next();
+    unsigned vars = c->varCnt();
+    const DArray<unsigned>* varSorts = _clauseVariableSorts.get(c) ;
+    if(!varSorts){
+      continue;
+    }
+
+    for(unsigned var=0;var<vars;var++){
+      unsigned srt = (*varSorts)[var];
+      instances *= min(_distinctSortSizes[_sortedSignature->parents[srt]],_sortedSignature->sortBounds[srt]);
+    }
+
+    // the SAT solver keeps a header word and the literals (with the markers)
+    // of each instance, and two watches of two words each
+    res += instances*(c->length()+_distinctSortSizes.size()+5)*sizeof(unsigned);
+  }
+  return res;
+}
+
+void FiniteModelBuilder::addNewInstances(bool onlyViolated)
 {
   CALL("FiniteModelBuilder::addNewInstances");
 
@@ -1003,7 +1260,7 @@ void FiniteModelBuilder::addNewInstances()
 
     static ArrayMap<unsigned> varDistinctSortsMaxes(_distinctSortSizes.size());
 
-    if (!_xmass) {
+    if (!_xmass && !_incremental) {
       varDistinctSortsMaxes.reset();
     }
 
@@ -1014,7 +1271,7 @@ void FiniteModelBuilder::addNewInstances()
       maxVarSize[var] = min(_sortModelSizes[srt],_sortedSignature->sortBounds[srt]);
       //cout << ",max="<<maxVarSize[var] << endl;
 
-      if (!_xmass) {
+      if (!_xmass && !_incremental) {
         unsigned dsort = _sortedSignature->parents[srt];
         if (!_sortedSignature->monotonicSorts[dsort]) { // don't mark instances of monotonic sorts!
           varDistinctSortsMaxes.set(dsort,1);
@@ -1075,6 +1332,23 @@ instanceLabel:
             }
           }
           // cout << "Clause finised" << endl;
+        } else if (_incremental) {
+          varDistinctSortsMaxes.reset();
+          for(unsigned var=0;var<vars;var++) {
+            unsigned dsr = _sortedSignature->parents[(*varSorts)[var]];
+            varDistinctSortsMaxes.set(dsr,max(grounding[var],varDistinctSortsMaxes.get(dsr,0)));
+          }
+          if (instantiatedBefore(varDistinctSortsMaxes)) {
+            // the solver has this instance already
+            goto instanceLabel;
+          }
+          // guard by the largest elements used, so that smaller sizes can switch the instance off
+          for (unsigned i = 0; i < _distinctSortSizes.size(); i++) {
+            unsigned val = varDistinctSortsMaxes.get(i,0);
+            if (val) {
+              satClauseLits.push(SATLiteral(marker_offsets[i]+val-1,0));
+            }
+          }
         } else {
           for (unsigned i = 0; i < _distinctSortSizes.size(); i++) {
             if (varDistinctSortsMaxes.get(i,0)) {
@@ -1129,6 +1403,15 @@ instanceLabel:
           }
         }
      
+        if(onlyViolated){
+          for(unsigned i=0;i<satClauseLits.size();i++){
+            if(!_solver->falseInAssignment(satClauseLits[i])){
+              // the current model satisfies this instance
+              goto instanceLabel;
+            }
+          }
+        }
+
         SATClause* satCl = SATClause::fromStack(satClauseLits);
         addSATClause(satCl);
 
@@ -1221,6 +1504,19 @@ newFuncLabel:
             //Skip this instance
             goto newFuncLabel;
           }
+          if(_incremental){
+            static ArrayMap<unsigned> maxes(_distinctSortSizes.size());
+            maxes.reset();
+            // y is smaller than z
+            maxes.set(_sortedSignature->parents[returnSrt],grounding[1]);
+            for(unsigned var=2;var<arity+2;var++){
+              unsigned dsrt = _sortedSignature->parents[f_signature[var-2]];
+              maxes.set(dsrt,max(grounding[var],maxes.get(dsrt,0)));
+            }
+            if(instantiatedBefore(maxes)){
+              goto newFuncLabel;
+            }
+          }
           static SATLiteralStack satClauseLits;
           satClauseLits.reset();
 
@@ -1270,6 +1566,9 @@ void FiniteModelBuilder::addNewSymmetryOrderingAxioms(unsigned size,
     SATLiteral sl = getSATLiteral(gt.f,grounding,true,true);
     satClauseLits.push(sl);
   }
+  if(_incremental){
+    satClauseLits.push(SATLiteral(symmetryMarker,0));
+  }
   SATClause* satCl = SATClause::fromStack(satClauseLits);
   addSATClause(satCl);
 
@@ -1316,6 +1615,9 @@ void FiniteModelBuilder::addNewSymmetryCanonicityAxioms(unsigned size,
 
         satClauseLits.push(getSATLiteral(gtj.f,grounding_j,true,true));
       }
+      if(_incremental){
+        satClauseLits.push(SATLiteral(symmetryMarker,0));
+      }
       addSATClause(SATClause::fromStack(satClauseLits));
   }
 
@@ -1509,8 +1811,8 @@ SATLiteral FiniteModelBuilder::getSATLiteral(unsigned f, const DArray<unsigned>&
   for(unsigned i=0;i<grounding.size();i++){
     var += mult*(grounding[i]-1);
     unsigned srt = signature[i];
-    //cout << var << ", " << mult << "," << _sortModelSizes[srt] << endl;
-    mult *= _sortModelSizes[srt];
+    //cout << var << ", " << mult << "," << _sortEncodingSizes[srt] << endl;
+    mult *= _sortEncodingSizes[srt];
   }
   //cout << "return " << var << endl;
 
@@ -1522,12 +1824,57 @@ void FiniteModelBuilder::addSATClause(SATClause* cl)
   CALL("FiniteModelBuilder::addSATClause");
   cl = Preprocess::removeDuplicateLiterals(cl);
   if(!cl){ return; }
+  // removing the duplicate literals sorted the clause
+  if(_blockClauses.insert(cl)!=cl){
+    cl->destroy();
+    return;
+  }
 #if VTRACE_FMB
   cout << "ADDING " << cl->toString() << endl; // " of size " << cl->length() << endl;
 #endif
 
   _clausesToBeAdded.push(cl);
+  if(_clausesToBeAdded.size() >= SAT_CLAUSE_BLOCK_SIZE){
+    flushSATClauses();
+  }
+}
+
+void FiniteModelBuilder::flushSATClauses()
+{
+  CALL("FiniteModelBuilder::flushSATClauses");
+
+  {
+    TimeCounter tc(Lib::TimeCounterUnit::TC_FMB_SAT_SOLVING);
+    _solver->addClausesIter(pvi(SATClauseStack::ConstIterator(_clausesToBeAdded)));
+  }
+  _satClauseCount += _clausesToBeAdded.size();
+
+  // the SAT solver has copied the clauses
+  SATClauseStack::Iterator it(_clausesToBeAdded);
+  while (it.hasNext()) {
+    it.next()->destroy();
+  }
+  _clausesToBeAdded.reset();
+  _blockClauses.reset();
+}
 
+unsigned FiniteModelBuilder::SATClauseHash::hash(SATClause* cl)
+{
+  return Hash::hash(reinterpret_cast<const unsigned char*>(cl->literals()),
+      cl->length()*sizeof(SATLiteral));
+}
+
+bool FiniteModelBuilder::SATClauseHash::equals(SATClause* cl1, SATClause* cl2)
+{
+  if(cl1->length()!=cl2->length()) {
+    return false;
+  }
+  for(unsigned i=0;i<cl1->length();i++) {
+    if((*cl1)[i]!=(*cl2)[i]) {
+      return false;
+    }
+  }
+  return true;
 }
 
 MainLoopResult FiniteModelBuilder::runImpl()
@@ -1576,19 +1923,38 @@ MainLoopResult FiniteModelBuilder::runImpl()
 
   if (!_xmass) {
     if (!_dsaEnumerator->init(_startModelSize,_distinctSortSizes,_distinct_sort_constraints,_strict_distinct_sort_constraints)) {
-      goto gave_up;
+      return MainLoopResult(Statistics::TerminationReason::REFUTATION_NOT_FOUND);
+    }
+  }
+
+  if (_workers > 1) {
+    return runWorkers();
+  }
+  return runSizes();
+}
+
+void FiniteModelBuilder::outputTrying()
+{
+  CALL("FiniteModelBuilder::outputTrying");
+
+  if(outputAllowed()) {
+    cout << "TRYING " << "["; 
+    for(unsigned i=0;i<_distinctSortSizes.size();i++){
+      cout << _distinctSortSizes[i];
+      if(i+1 < _distinctSortSizes.size()) cout << ",";
     }
+    cout << "]" << endl;
   }
+}
+
+MainLoopResult FiniteModelBuilder::runSizes()
+{
+  CALL("FiniteModelBuilder::runSizes");
 
   if (reset()) {
   while(true){
-    if(outputAllowed()) {
-      cout << "TRYING " << "["; 
-      for(unsigned i=0;i<_distinctSortSizes.size();i++){
-        cout << _distinctSortSizes[i];
-        if(i+1 < _distinctSortSizes.size()) cout << ",";
-      }
-      cout << "]" << endl;
+    if(!_worker) { // the parent reports the sizes of its workers
+      outputTrying();
     }
     Timer::syncClock();
     if(env.timeLimitReached()){ return MainLoopResult(Statistics::TerminationReason::TIME_LIMIT); }
@@ -1604,7 +1970,9 @@ MainLoopResult FiniteModelBuilder::runImpl()
 #if VTRACE_FMB
     cout << "INSTANCES" << endl;
 #endif
-    addNewInstances();
+    if(!_lazyInstances){
+      addNewInstances();
+    }
 #if VTRACE_FMB
     cout << "FUNC DEFS" << endl;
 #endif
@@ -1619,65 +1987,119 @@ MainLoopResult FiniteModelBuilder::runImpl()
 #endif
     addNewTotalityDefs();
 
+    if(_incremental){
+      recordInstantiatedSizes();
+    }
     }
 
 #if VTRACE_FMB
     cout << "SOLVING" << endl;
 #endif
-    //TODO consider adding clauses directly to SAT solver in new interface?
-    // pass clauses and assumption to SAT Solver
+    // pass the rest of the clauses to the SAT solver
+    flushSATClauses();
+
+    SATSolver::Status satResult = SATSolver::Status::UNKNOWN;
+    env.statistics->phase = Statistics::ExecutionPhase::FMB_SOLVING;
+
+    static SATLiteralStack assumptions(_distinctSortSizes.size());
+    assumptions.reset();
+    if (_xmass) {
+      for (unsigned i = 0; i < _distinctSortSizes.size(); i++) {
+        assumptions.push(SATLiteral(marker_offsets[i]+_distinctSortSizes[i]-1,0));
+        // cout << "assuming sort " << i << " value " << _distinctSortSizes[i]-1 << " negative" << endl;
+      }
+    } else if (_incremental) {
+      // the elements of the current sizes, larger ones are left to the solver
+      for (unsigned i = 0; i < _distinctSortSizes.size(); i++) {
+        for (unsigned j = 0; j < _distinctSortSizes[i]; j++) {
+          assumptions.push(SATLiteral(marker_offsets[i]+j,1));
+        }
+      }
+      assumptions.push(SATLiteral(symmetryMarker,1));
+      for (unsigned i = 0; i < _distinctSortSizes.size(); i++) {
+        assumptions.push(SATLiteral(totalityMarker_offset+i,1));
+      }
+    } else {
+      for (unsigned i = 0; i < _distinctSortSizes.size(); i++) {
+        assumptions.push(SATLiteral(totalityMarker_offset+i,1));
+      }
+      for (unsigned i = 0; i < _distinctSortSizes.size(); i++) {
+        assumptions.push(SATLiteral(instancesMarker_offset+i,1));
+      }
+    }
+
     {
       TimeCounter tc(Lib::TimeCounterUnit::TC_FMB_SAT_SOLVING);
-      _solver->addClausesIter(pvi(SATClauseStack::ConstIterator(_clausesToBeAdded)));
+      satResult = _solver->solveUnderAssumptions(assumptions);
     }
 
-    SATSolver::Status satResult = SATSolver::Status::UNKNOWN;
-    {
-      env.statistics->phase = Statistics::ExecutionPhase::FMB_SOLVING;
+    while (_lazyInstances && satResult == SATSolver::Status::SATISFIABLE) {
+#if VTRACE_FMB
+      cout << "VIOLATED INSTANCES" << endl;
+#endif
+      unsigned satClauseCount = _satClauseCount;
+      {
+        TimeCounter tc(Lib::TimeCounterUnit::TC_FMB_CONSTRAINT_CREATION);
+        addNewInstances(true);
+      }
+      flushSATClauses();
+      if (_satClauseCount == satClauseCount) {
+        // the model satisfies all the instances
+        break;
+      }
+      Timer::syncClock();
+      if(env.timeLimitReached()){ return MainLoopResult(Statistics::TerminationReason::TIME_LIMIT); }
+
       TimeCounter tc(Lib::TimeCounterUnit::TC_FMB_SAT_SOLVING);
+      satResult = _solver->solveUnderAssumptions(assumptions);
+    }
 
-      static SATLiteralStack assumptions(_distinctSortSizes.size());
-      assumptions.reset();
-      if (_xmass) {
-        for (unsigned i = 0; i < _distinctSortSizes.size(); i++) {
-          assumptions.push(SATLiteral(marker_offsets[i]+_distinctSortSizes[i]-1,0));
-          // cout << "assuming sort " << i << " value " << _distinctSortSizes[i]-1 << " negative" << endl;
-        }
-      } else {
-        for (unsigned i = 0; i < _distinctSortSizes.size(); i++) {
-          assumptions.push(SATLiteral(totalityMarker_offset+i,1));
+    if (_incremental && satResult == SATSolver::Status::UNSATISFIABLE) {
+      TimeCounter tc(Lib::TimeCounterUnit::TC_FMB_SAT_SOLVING);
+      _failedAssumptions.reset();
+      _failedAssumptions.loadFromIterator(SATLiteralStack::ConstIterator(_solver->failedAssumptions()));
+
+      // The learnt clauses of earlier sizes make the solver blame totality more often
+      // than a new solver would, and the nogood then excludes just the current sizes.
+      // So we check whether the sizes also fail without the totality definitions.
+      bool totalityUsed = false;
+      for (unsigned i = 0; i < _failedAssumptions.size(); i++) {
+        unsigned var = _failedAssumptions[i].var();
+        if (var >= totalityMarker_offset && var != symmetryMarker) {
+          totalityUsed = true;
         }
-        for (unsigned i = 0; i < _distinctSortSizes.size(); i++) {
-          assumptions.push(SATLiteral(instancesMarker_offset+i,1));
+      }
+      if (totalityUsed) {
+        // the totality markers are the last assumptions
+        assumptions.truncate(assumptions.size()-_distinctSortSizes.size());
+        if (_solver->solveUnderAssumptions(assumptions) == SATSolver::Status::UNSATISFIABLE) {
+          _failedAssumptions.reset();
+          _failedAssumptions.loadFromIterator(SATLiteralStack::ConstIterator(_solver->failedAssumptions()));
         }
       }
-
-      satResult = _solver->solveUnderAssumptions(assumptions);
-      env.statistics->phase = Statistics::ExecutionPhase::FMB_CONSTRAINT_GEN;
     }
+    env.statistics->phase = Statistics::ExecutionPhase::FMB_CONSTRAINT_GEN;
 
     // if the clauses are satisfiable then we have found a finite model
     if(satResult == SATSolver::Status::SATISFIABLE){
+      if(_worker){
+        reportModel();
+      }
       onModelFound();
       return MainLoopResult(Statistics::TerminationReason::SATISFIABLE);
     }
 
     static unsigned numberOfSatCalls = 0;
     numberOfSatCalls++;
-    unsigned clauseSetSize = _clausesToBeAdded.size();
-    unsigned weight = clauseSetSize;
-
-    // destroy the clauses
-    SATClauseStack::Iterator it(_clausesToBeAdded);
-    while (it.hasNext()) {
-      it.next()->destroy();
-    }
-    // but the container needs to be empty for the next round in any case
-    _clausesToBeAdded.reset();
+    // the incremental solver only got the clauses new for these sizes, the lazy one only
+    // the violated instances, and the parent of a worker does not solve the sizes it hands
+    // out, so estimate the size of the whole encoding instead
+    unsigned weight = (_incremental || _lazyInstances || _worker) ? estimateInstanceCount()+estimateFunctionalDefCount() : _satClauseCount;
+    _satClauseCount = 0;
 
     {
       // _solver->explicitlyMinimizedFailedAssumptions(false,true); // TODO: try adding this in
-      const SATLiteralStack& failed = _solver->failedAssumptions();
+      const SATLiteralStack& failed = _incremental ? _failedAssumptions : _solver->failedAssumptions();
 
       if (_xmass) {
         unsigned domToGrow = UINT_MAX;
@@ -1767,18 +2189,32 @@ MainLoopResult FiniteModelBuilder::runImpl()
 
         for (unsigned i = 0; i < failed.size(); i++) {
           unsigned var = failed[i].var();
-          ASS_GE(var,totalityMarker_offset);
+          bool totality;
+          unsigned dsort;
+          if (_incremental) {
+            if (var == symmetryMarker) { // symmetry axioms do not tell which domain should grow
+              continue;
+            }
+            totality = var >= totalityMarker_offset;
+            dsort = totality ? var-totalityMarker_offset : which_sort(var);
+            if (!totality && _sortedSignature->monotonicSorts[dsort]) { // marked only so that smaller sizes can switch them off
+              continue;
+            }
+          } else {
+            ASS_GE(var,totalityMarker_offset);
+            totality = var < instancesMarker_offset;
+            dsort = totality ? var-totalityMarker_offset : var-instancesMarker_offset;
+          }
 
-          if (var < instancesMarker_offset) { // totality used (-> instances used as well / unless the sort is monotonic)
-            unsigned dsort = var-totalityMarker_offset;
+          if (totality) { // totality used (-> instances used as well / unless the sort is monotonic)
             if (_sortedSignature->monotonicSorts[dsort]) {
               nogood[dsort].first = FMB::FiniteModelBuilder::ConstraintSign::LEQ;
             } else {
               nogood[dsort].first = FMB::FiniteModelBuilder::ConstraintSign::EQ;
             }
-          } else if (nogood[var-instancesMarker_offset].first == FMB::FiniteModelBuilder::ConstraintSign::STAR) { // instances used (and we don't know yet about totality)
-            ASS(!_sortedSignature->monotonicSorts[var-instancesMarker_offset]);
-            nogood[var-instancesMarker_offset].first = FMB::FiniteModelBuilder::ConstraintSign::GEQ;
+          } else if (nogood[dsort].first == FMB::FiniteModelBuilder::ConstraintSign::STAR) { // instances used (and we don't know yet about totality)
+            ASS(!_sortedSignature->monotonicSorts[dsort]);
+            nogood[dsort].first = FMB::FiniteModelBuilder::ConstraintSign::GEQ;
           }
         }
 
@@ -1788,6 +2224,10 @@ MainLoopResult FiniteModelBuilder::runImpl()
         cout << " of weight " << weight << endl;
 #endif
 
+        if (_worker) {
+          reportNogood(nogood,weight);
+        }
+
         _dsaEnumerator->learnNogood(nogood,weight);
 
         if (!_dsaEnumerator->increaseModelSizes(_distinctSortSizes,_distinctSortMaxs)) {
@@ -1834,6 +2274,195 @@ MainLoopResult FiniteModelBuilder::runImpl()
   return MainLoopResult(Statistics::TerminationReason::REFUTATION_NOT_FOUND);
 }
 
+/**
+ * Try the sizes given by the enumerator in up to _workers forked processes at a time.
+ *
+ * The sizes handed to a worker are ruled out by a nogood straight away, so that the
+ * enumerator gives the next sizes to the next worker. When a worker has no model,
+ * it reports the real nogood, which we learn. The first worker to find a model goes on
+ * to print it, the other workers are killed, and we terminate when it does.
+ *
+ * A worker reports one line "<pid> <result>" into the pipe, where the result is
+ * N (no model) followed by the weight and the sign and size for each distinct sort of the nogood,
+ * S (found a model), T (time limit) or G (gave up).
+ */
+MainLoopResult FiniteModelBuilder::runWorkers()
+{
+  CALL("FiniteModelBuilder::runWorkers");
+
+  unsigned distinctSorts = _distinctSortSizes.size();
+
+  // the workers report back through this pipe
+  Sys::SyncPipe pipe;
+
+  Stack<pid_t> workers;
+  s_workers = &workers;
+  static bool handlerInstalled = false;
+  if(!handlerInstalled){
+    System::addTerminationHandler(killWorkers);
+    handlerInstalled = true;
+  }
+
+  static Constraint_Generator_Vals nogood;
+  nogood.ensure(distinctSorts);
+
+  // the nogoods arrive out of order, so they must not be forgotten once they generate no more sizes
+  _dsaEnumerator->keepOldNogoods();
+
+  // the first sizes are in _distinctSortSizes already
+  bool first = true;
+  while(true){
+    while(workers.size() < _workers){
+      if(!first){
+        if(!_dsaEnumerator->increaseModelSizes(_distinctSortSizes,_distinctSortMaxs)){
+          break;
+        }
+        for(unsigned s=0;s<_sortedSignature->sorts;s++) {
+          _sortModelSizes[s] = _distinctSortSizes[_sortedSignature->parents[s]];
+        }
+      }
+      first = false;
+
+      outputTrying();
+
+      pid_t pid = Sys::Multiprocessing::instance()->fork();
+      if(!pid){
+        _worker = true;
+        s_workers = 0;
+        // the parent takes care of the time limit
+        Timer::setTimeLimitEnforcement(false);
+        pipe.neverRead();
+        _workerPipe = &pipe;
+        s_workerPipe = &pipe;
+        System::addTerminationHandler(workerTerminated);
+
+        MainLoopResult res = runSizes();
+        if(res.terminationReason == Statistics::TerminationReason::SATISFIABLE){
+          // we won, so the result is ours to output
+          return res;
+        }
+        // we could not try the sizes, workerTerminated tells the parent
+        System::terminateImmediately(0);
+      }
+      workers.push(pid);
+
+      // rule the sizes out until the worker reports the real nogood
+      for(unsigned i=0;i<distinctSorts;i++){
+        nogood[i] = make_pair(FMB::FiniteModelBuilder::ConstraintSign::EQ,_distinctSortSizes[i]);
+      }
+      _dsaEnumerator->learnNogood(nogood,estimateInstanceCount()+estimateFunctionalDefCount());
+    }
+
+    if(workers.isEmpty()){
+      s_workers = 0;
+      if(_dsaEnumerator->isFmbComplete(distinctSorts)){
+        Clause* empty = new(0) Clause(0,NonspecificInference0(UnitInputType::AXIOM,InferenceRule::MODEL_NOT_FOUND));
+        return MainLoopResult(Statistics::TerminationReason::REFUTATION,empty);
+      }
+      if(outputAllowed()){
+        cout << "Cannot enumerate next child to try in an incomplete setup" <<endl;
+      }
+      return MainLoopResult(Statistics::TerminationReason::REFUTATION_NOT_FOUND);
+    }
+
+    pipe.acquireRead();
+    istream& in = pipe.in();
+    pid_t pid;
+    char result;
+    in >> pid >> result;
+    unsigned weight = 0;
+    if(result == 'N'){
+      in >> weight;
+      for(unsigned i=0;i<distinctSorts;i++){
+        unsigned sign;
+        in >> sign >> nogood[i].second;
+        nogood[i].first = static_cast<ConstraintSign>(sign);
+      }
+    }
+    pipe.releaseRead();
+
+    ALWAYS(workers.remove(pid));
+
+    int status;
+    if(result == 'S'){
+      Timer::setTimeLimitEnforcement(false);
+      // the worker stops itself after reporting, so that no other worker prints
+      // anything while it outputs the model
+      bool stopped, exited, signalled;
+      while(Sys::Multiprocessing::instance()->poll_children(stopped,exited,signalled,status) != pid) {}
+      killWorkers();
+#ifdef _WIN32
+#else
+      if(stopped){
+        // let the worker print the model and finish as it would
+        Sys::Multiprocessing::instance()->kill(pid,SIGCONT);
+        Sys::Multiprocessing::instance()->waitForParticularChildTermination(pid,status);
+      }
+#endif
+      System::terminateImmediately(status);
+    }
+    Sys::Multiprocessing::instance()->waitForParticularChildTermination(pid,status);
+
+    if(result == 'T'){
+      killWorkers();
+      return MainLoopResult(Statistics::TerminationReason::TIME_LIMIT);
+    }
+    if(result != 'N'){
+      ASS_EQ(result,'G');
+      // as when we fail to reset
+      killWorkers();
+      return MainLoopResult(Statistics::TerminationReason::REFUTATION_NOT_FOUND);
+    }
+
+#if VTRACE_DOMAINS
+    cout << "Learned a nogood from a worker: ";
+    output_cg(nogood);
+    cout << " of weight " << weight << endl;
+#endif
+    _dsaEnumerator->learnNogood(nogood,weight);
+  }
+}
+
+/**
+ * In a worker, tell the parent that we have found a model and wait until it has killed
+ * the other workers. We keep the right to write into the pipe, so that no other worker
+ * can report a model in the meantime.
+ */
+void FiniteModelBuilder::reportModel()
+{
+  CALL("FiniteModelBuilder::reportModel");
+  ASS(_worker);
+
+  s_workerPipe = 0;
+  _workerPipe->acquireWrite();
+  _workerPipe->out() << System::getPID() << " S" << endl;
+#ifdef _WIN32
+#else
+  raise(SIGSTOP);
+#endif
+}
+
+/**
+ * In a worker, send the nogood learnt for our sizes to the parent and terminate
+ */
+void FiniteModelBuilder::reportNogood(Constraint_Generator_Vals& nogood, unsigned weight)
+{
+  CALL("FiniteModelBuilder::reportNogood");
+  ASS(_worker);
+
+  s_workerPipe = 0;
+  _workerPipe->acquireWrite();
+  ostream& out = _workerPipe->out();
+  out << System::getPID() << " N " << weight;
+  for(unsigned i=0;i<nogood.size();i++){
+    out << " " << static_cast<unsigned>(nogood[i].first) << " " << nogood[i].second;
+  }
+  out << endl;
+  _workerPipe->releaseWrite();
+
+  System::terminateImmediately(0);
+}
+
 void FiniteModelBuilder::onModelFound()
 {
  CALL("FiniteModelBuilder::onModelFound");
@@ -2356,6 +2985,16 @@ bool FiniteModelBuilder::HackyDSAE::increaseModelSizes(DArray<unsigned>& newSort
       }
       */
 
+      // test 2c -- kept nogoods (no longer generators, but still constraints)
+      {
+        Stack<Constraint_Generator*>::Iterator it(_oldNogoods);
+        while (it.hasNext()) {
+          if (checkConstriant(newSortSizes,it.next()->_vals)) {
+            goto next_candidate;
+          }
+        }
+      }
+
       // test 3 -- (strict)_distinct_sort_constraints
       {
         Stack<std::pair<unsigned,unsigned>>::Iterator it1(*_distinct_sort_constraints);
@@ -2411,7 +3050,11 @@ bool FiniteModelBuilder::HackyDSAE::increaseModelSizes(DArray<unsigned>& newSort
       newSortSizes[i] -= 1;
     }
 
-    delete _constraints_generators.pop();
+    if (_keepOldNogoods) {
+      _oldNogoods.push(_constraints_generators.pop());
+    } else {
+      delete _constraints_generators.pop();
+    }
     // _old_generators.push(_constraints_generators.pop()); // keeping old generators degraded performance on average ...
 #if VTRACE_DOMAINS
     cout << "Deleted" << endl;
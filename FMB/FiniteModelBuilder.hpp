@@ -36,6 +36,7 @@
 #include "Lib/ScopedPtr.hpp"
 #include "SortInference.hpp"
 #include "Lib/BinaryHeap.hpp"
+#include "Lib/Set.hpp"
 
 namespace FMB {
 using namespace Lib;
@@ -84,13 +85,23 @@ private:
   // Creates the model output
   void onModelFound();
 
+  // Tries the model sizes one after another, starting with _distinctSortSizes
+  MainLoopResult runSizes();
+  // Tries several model sizes at the same time in forked worker processes
+  MainLoopResult runWorkers();
+  // Prints the sizes we are trying
+  void outputTrying();
+
   // Adds constraints from ground clauses (same constraints for each model size)
   void addGroundClauses();
   // Adds constraints from grounding the non-ground clauses
-  void addNewInstances();
+  // if onlyViolated, only the instances false in the current SAT assignment are added
+  void addNewInstances(bool onlyViolated=false);
 
   // uses _distinctSortSizes to estimate how many instances would we generate
   unsigned estimateInstanceCount();
+  // uses _distinctSortSizes to estimate how many bytes the instances would take in the SAT solver
+  size_t estimateInstanceMemory();
 
   // Add constraints from functionality of function symbols in signature (except those removed in preprocessing)
   void addNewFunctionalDefs();
@@ -132,13 +143,25 @@ private:
 
   // resets all structures and SAT solver using _sortModelSizes 
   bool reset();
+  // computes the offsets of symbols using _sortEncodingSizes, returns false on overflow
+  bool setSymbolOffsets(unsigned& offsets);
+  // in the incremental mode, prepares the SAT solver for the next sizes
+  // returns false if the sizes do not fit into the encoding and the solver must be reset
+  bool resetIncrementally();
+
+  // in the incremental mode, whether all groundings whose largest elements
+  // for each distinct sort are given by maxes have been added for earlier sizes
+  bool instantiatedBefore(ArrayMap<unsigned>& maxes);
+  // in the incremental mode, records that all groundings for the current sizes have been added
+  void recordInstantiatedSizes();
 
   // make the symmetry orderings
   void createSymmetryOrdering();
   // The per-sort ordering of grounded terms used for symmetry breaking
   DArray<Stack<GroundedTerm>> _sortedGroundedTerms;
 
-  // SAT solver used to solve constraints (a new one is used for each model size)
+  // SAT solver used to solve constraints (a new one is used for each model size,
+  // unless we are incremental)
   ScopedPtr<SATSolverWithAssumptions> _solver;
 
   // Structures to record symbols removed during preprocessing i.e. via definition elimination
@@ -161,8 +184,21 @@ private:
     satClauseLits.push(lit);
     addSATClause(SATClause::fromStack(satClauseLits));
   }
-  // SAT clauses to be added. We record them so we can delete them after calling the SAT solver
+  // Pass the SAT clauses to be added to the SAT solver and delete them
+  void flushSATClauses();
+  // SAT clauses to be added. We record them so we can delete them after passing them to the SAT solver,
+  // which happens once a block of them is ready, or before solving
   SATClauseStack _clausesToBeAdded;
+  // the number of SAT clauses passed to the SAT solver for the current sizes
+  unsigned _satClauseCount;
+
+  // Compares SAT clauses by their (sorted) literals
+  struct SATClauseHash {
+    static unsigned hash(SATClause* cl);
+    static bool equals(SATClause* cl1,SATClause* cl2);
+  };
+  // The clauses in _clausesToBeAdded, so that the duplicates in a block are not passed on
+  Set<SATClause*,SATClauseHash> _blockClauses;
 
   // The inferred signature of sorts (see SortInference.hpp)
   SortedSignature* _sortedSignature;
@@ -185,6 +221,39 @@ private:
   // do contour encoding instead of point-wise
   bool _xmass;
 
+  /* keep the SAT solver across model sizes (only with the point-wise encoding)
+   *
+   * The instances and the functional definitions are kept, and only those for
+   * the new groundings are added. The totality definitions and the symmetry axioms,
+   * which only hold for the current sizes, are added for each size again with
+   * fresh markers, which are assumed for that size only.
+   */
+  bool _incremental;
+
+  /* add the instances of the clauses lazily (not when _incremental)
+   *
+   * The instances are not added up front, but each time the SAT solver finds a model
+   * the instances it violates are added and we solve again. The model is a model of
+   * the problem once it violates no instance.
+   */
+  // always, as asked by fmb_lazy_instances
+  bool _lazyOption;
+  // when the instances for the current sizes are estimated to take more bytes than this (0 if no limit)
+  size_t _instanceMemoryLimit;
+  // for the current sizes
+  bool _lazyInstances;
+
+  /* the number of worker processes (if more than one)
+   *
+   * Each worker is forked to try one vector of sizes with its own SAT solver, and
+   * reports the nogood (or the model) back through _workerPipe. The parent keeps the
+   * enumerator, so the nogoods of all the workers are used to pick the next sizes.
+   */
+  unsigned _workers;
+  // are we a worker process
+  bool _worker;
+  Sys::SyncPipe* _workerPipe;
+
   // if (_xmass) {
 
   /* Each distinctSort has as many markers as is its current size.
@@ -192,10 +261,36 @@ private:
    */
   DArray<unsigned> marker_offsets;
 
+  // } else if (_incremental) {
+
+  /* Each distinctSort has a marker for each of its elements up to its encoding size,
+   * at marker_offsets[sort]+element-1. An instance is guarded by the markers of the largest
+   * elements it uses, so that it is switched off when the sort is smaller than that.
+   */
+
+  /* the sizes of sorts the SAT variables are numbered for; these are larger
+   * than the model sizes so that the model sizes can grow without a reset
+   */
+  DArray<unsigned> _sortEncodingSizes;
+  DArray<unsigned> _distinctSortEncodingSizes;
+
+  // the marker of the symmetry axioms for the current sizes
+  unsigned symmetryMarker;
+  // the first SAT variable not yet used for markers
+  unsigned _nextMarker;
+
+  /* the vectors of distinct sort sizes for which the instances and the functional
+   * definitions have been added, stored one after another
+   */
+  Stack<unsigned> _instantiatedSizes;
+  // the failed assumptions for the current sizes
+  SATLiteralStack _failedAssumptions;
+
   // } else {
 
   /* for each distinctSort i there is a variable (totalityMarker_offset+i)
    * which we use in the encoding to learn which domain should grow in order to possibly resolve a conflict.
+   * (also when _incremental, where these variables are fresh for each size)
    */
   unsigned totalityMarker_offset;
   /* for each distinctSort i there is a variable (instancesMarker_offset+i)
@@ -247,12 +342,20 @@ private:
 
   typedef DArray<pair<ConstraintSign,unsigned>> Constraint_Generator_Vals;
 
+  // In a worker, tell the parent we have a model (and go on to print it),
+  // or send it the nogood for our sizes and terminate
+  void reportModel();
+  void reportNogood(Constraint_Generator_Vals& nogood, unsigned weight);
+
   class DSAEnumerator { // Domain Size Assignment Enumerator - for the point-wise encoding case
   public:
     virtual bool init(unsigned, DArray<unsigned>&, Stack<std::pair<unsigned,unsigned>>&, Stack<std::pair<unsigned,unsigned>>&) { return true; }
     virtual void learnNogood(Constraint_Generator_Vals& nogood, unsigned weight) = 0;
     virtual bool increaseModelSizes(DArray<unsigned>& newSortSizes, DArray<unsigned>& sortMaxes) = 0;
     virtual bool isFmbComplete(unsigned noDomains) { return false; }
+    // keep the nogoods in force even when they cannot generate any more sizes,
+    // needed when the nogoods are not learnt in the order the sizes were enumerated
+    virtual void keepOldNogoods() {}
     virtual ~DSAEnumerator() {}
   };
 
@@ -291,6 +394,10 @@ private:
 
     // Stack<Constraint_Generator*> _old_generators; // keeping old generators degraded performance on average ...
 
+    bool _keepOldNogoods;
+    // the generators done with when _keepOldNogoods
+    Stack<Constraint_Generator*> _oldNogoods;
+
   protected:
     bool checkConstriant(DArray<unsigned>& newSortSizes, Constraint_Generator_Vals& constraint);
 
@@ -298,7 +405,7 @@ private:
     CLASS_NAME(FiniteModedlBuilder::HackyDSAE);
     USE_ALLOCATOR(FiniteModelBuilder::HackyDSAE);
 
-    HackyDSAE() : _maxWeightSoFar(0) {}
+    HackyDSAE() : _maxWeightSoFar(0), _keepOldNogoods(false) {}
 
     bool init(unsigned, DArray<unsigned>&, Stack<std::pair<unsigned,unsigned>>& dsc, Stack<std::pair<unsigned,unsigned>>& sdsc) override {
       _distinct_sort_constraints = &dsc;
@@ -307,6 +414,7 @@ private:
     }
 
     bool isFmbComplete(unsigned noDomains) override { return noDomains == 1; }
+    void keepOldNogoods() override { _keepOldNogoods = true; }
     void learnNogood(Constraint_Generator_Vals& nogood, unsigned weight) override;
     bool increaseModelSizes(DArray<unsigned>& newSortSizes, DArray<unsigned>& sortMaxes) override;
   };
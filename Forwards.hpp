@@ -188,6 +188,7 @@ typedef VirtualIterator<Formula*> FormulaIterator;
 typedef Stack<Formula*> FormulaStack;
 
 class Clause;
+class CompactClause;
 /** Defined as VirtualIterator<Clause*> */
 typedef VirtualIterator<Clause*> ClauseIterator;
 typedef SingleParamEvent<Clause*> ClauseEvent;
@@ -224,6 +225,7 @@ class LiteralSelector;
 typedef Lib::SmartPtr<LiteralSelector> LiteralSelectorSP;
 
 class Ordering;
+class InstanceOrderingCheck;
 typedef Lib::SmartPtr<Ordering> OrderingSP;
 
 class Grounder;
@@ -277,6 +279,7 @@ class LiteralIndexingStructure;
 class TermIndex;
 class TermIndexingStructure;
 class ClauseSubsumptionIndex;
+class FeatureVectorIndex;
 class FormulaIndex;
 
 class TermSharing;
@@ -324,6 +327,7 @@ class Splitter;
 class ConsequenceFinder;
 class LabelFinder;
 class SymElOutput;
+class LemmaExchange;
 }
 
 namespace Inferences
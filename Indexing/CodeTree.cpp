@@ -40,6 +40,19 @@
 
 #define GROUND_TERM_CHECK 0
 
+/**
+ * When set to 1, the code of the tree is interpreted with threaded
+ * dispatch, jumping from each instruction right to the handler of the
+ * next one through the labels as values extension of GCC and Clang.
+ */
+#ifndef CODE_TREE_THREADED_DISPATCH
+#ifdef __GNUC__
+#define CODE_TREE_THREADED_DISPATCH 1
+#else
+#define CODE_TREE_THREADED_DISPATCH 0
+#endif
+#endif
+
 #undef RSTAT_COLLECTION
 #define RSTAT_COLLECTION 0
 
@@ -1466,7 +1479,74 @@ bool CodeTree::Matcher::execute()
     }
   }
 
+#if CODE_TREE_THREADED_DISPATCH
+  //handlers indexed by CodeOp::dispatchIndex(), the instructions with
+  //a prefix other than SUFFIX_INSTR have one entry in each row
+  static void* const handlers[16] = {
+    &&success_or_fail, &&check_ground_term, &&lit_end, &&check_fun,
+    &&success_or_fail, &&check_ground_term, &&lit_end, &&assign_var,
+    &&success_or_fail, &&check_ground_term, &&lit_end, &&check_var,
+    &&success_or_fail, &&check_ground_term, &&lit_end, &&search_struct
+  };
+
+#define CT_DISPATCH                                     \
+  if(op->alternative()) {                               \
+    btStack.push(BTPoint(tp, op->alternative()));       \
+  }                                                     \
+  goto *handlers[op->dispatchIndex()]
+
+  CT_DISPATCH;
+
+success_or_fail:
+  //yield successes only in the first round (we don't want to yield the
+  //same thing for each query literal)
+  if(op->isFail() || curLInfo!=0) {
+    goto backtrack_point;
+  }
+  return true;
+lit_end:
+  return true;
+check_ground_term:
+  if(!doCheckGroundTerm()) {
+    goto backtrack_point;
+  }
+  op++;
+  CT_DISPATCH;
+check_fun:
+  if(!doCheckFun()) {
+    goto backtrack_point;
+  }
+  op++;
+  //the arguments of a checked function are mostly assigned to variables,
+  //we do it here unless there is an alternative to be pushed
+  while(op->isAssignVar() && !op->alternative()) {
+    doAssignVar();
+    op++;
+  }
+  CT_DISPATCH;
+assign_var:
+  doAssignVar();
+  op++;
+  CT_DISPATCH;
+check_var:
+  if(!doCheckVar()) {
+    goto backtrack_point;
+  }
+  op++;
+  CT_DISPATCH;
+search_struct:
+  if(!doSearchStruct()) {
+    goto backtrack_point;
+  }
+  CT_DISPATCH;
+backtrack_point:
+  if(!backtrack()) {
+    return false;
+  }
+  CT_DISPATCH;
 
+#undef CT_DISPATCH
+#else
   bool shouldBacktrack=false;
   for(;;) {
     if(op->alternative()) {
@@ -1530,6 +1610,7 @@ bool CodeTree::Matcher::execute()
       op++;
     }
   }
+#endif
 }
 
 /**
@@ -203,6 +203,7 @@ public:
     inline bool isSearchStruct() const { return instrPrefix()== InstructionPrefix::SUFFIX_INSTR && instrSuffix()== InstructionSuffix::SEARCH_STRUCT; }
     inline bool isCheckFun() const { return instrPrefix()== InstructionPrefix::SUFFIX_INSTR && instrSuffix()== InstructionSuffix::CHECK_FUN; }
     inline bool isCheckGroundTerm() const { return instrPrefix()== InstructionPrefix::CHECK_GROUND_TERM; }
+    inline bool isAssignVar() const { return instrPrefix()== InstructionPrefix::SUFFIX_INSTR && instrSuffix()== InstructionSuffix::ASSIGN_VAR; }
 
     inline Term* getTargetTerm() const
     {
@@ -231,6 +232,13 @@ public:
       return static_cast<InstructionSuffix>(_info.suffix);
     }
 
+    /**
+     * Return the index of the handler of the instruction in threaded
+     * dispatch, made of the prefix and the suffix (the suffix bits hold
+     * data unless the prefix is SUFFIX_INSTR)
+     */
+    inline unsigned dispatchIndex() const { return _info.prefix | (_info.suffix<<2); }
+
     inline unsigned arg() const { return _info.arg; }
     inline CodeOp* alternative() const { return _alternative; }
     inline CodeOp*& alternative() { return _alternative; }
@@ -176,6 +176,7 @@ public:
     else {
       res=TermQueryResult(_found->t, _found->lit, _found->cls);
     }
+    res.orderingCheck=_found->check;
     _found=0;
     return res;
   }
@@ -198,6 +199,14 @@ void CodeTreeTIS::insert(TermList t, Literal* lit, Clause* cls)
   _ct.insert(ti);
 }
 
+void CodeTreeTIS::insert(TermList t, Literal* lit, Clause* cls, InstanceOrderingCheck* check)
+{
+  CALL("CodeTreeTIS::insert/4");
+
+  TermCodeTree::TermInfo* ti=new TermCodeTree::TermInfo(t,lit,cls,check);
+  _ct.insert(ti);
+}
+
 void CodeTreeTIS::remove(TermList t, Literal* lit, Clause* cls)
 {
   CALL("CodeTreeTIS::remove");
@@ -53,6 +53,7 @@ public:
   USE_ALLOCATOR(CodeTreeTIS);
 
   void insert(TermList t, Literal* lit, Clause* cls);
+  void insert(TermList t, Literal* lit, Clause* cls, InstanceOrderingCheck* check);
   void remove(TermList t, Literal* lit, Clause* cls);
 
   TermQueryResultIterator getGeneralizations(TermList t, bool retrieveSubstitutions = true);
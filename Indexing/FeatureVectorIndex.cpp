@@ -0,0 +1,278 @@
+
+/*
+ * File FeatureVectorIndex.cpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions.
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide.
+ */
+/**
+ * @file FeatureVectorIndex.cpp
+ * Implements class FeatureVectorIndex.
+ */
+
+#include "Lib/Metaiterators.hpp"
+#include "Lib/TimeCounter.hpp"
+
+#include "Kernel/Clause.hpp"
+#include "Kernel/Term.hpp"
+
+#include "FeatureVectorIndex.hpp"
+
+/** Index of the first feature counting literals in predicate buckets */
+#define FV_PRED_BASE 2
+/** Index of the first feature counting occurrences of function symbols */
+#define FV_FUNC_COUNT_BASE (FV_PRED_BASE+2*FV_PRED_BUCKETS)
+/** Index of the first feature with the depth of function symbols */
+#define FV_FUNC_DEPTH_BASE (FV_FUNC_COUNT_BASE+FV_FUNC_BUCKETS)
+
+namespace Indexing
+{
+
+using namespace Lib;
+using namespace Kernel;
+
+FeatureVectorIndex::Node::~Node()
+{
+  CALL("FeatureVectorIndex::Node::~Node");
+
+  Stack<Child>::Iterator cit(children);
+  while(cit.hasNext()) {
+    delete cit.next().node;
+  }
+}
+
+/** Return the position of the first child whose value is at least @b value */
+unsigned FeatureVectorIndex::Node::lowerBound(unsigned value) const
+{
+  unsigned lo=0;
+  unsigned hi=children.size();
+  while(lo<hi) {
+    unsigned mid=(lo+hi)/2;
+    if(children[mid].value<value) {
+      lo=mid+1;
+    } else {
+      hi=mid;
+    }
+  }
+  return lo;
+}
+
+FeatureVectorIndex::FeatureVectorIndex()
+{
+}
+
+FeatureVectorIndex::~FeatureVectorIndex()
+{
+}
+
+/**
+ * Store the feature vector of @b cl into the array @b fv of the size
+ * FV_SIZE
+ */
+void FeatureVectorIndex::computeFeatures(Clause* cl, unsigned* fv)
+{
+  CALL("FeatureVectorIndex::computeFeatures");
+
+  for(unsigned i=0; i<FV_SIZE; i++) {
+    fv[i]=0;
+  }
+
+  //terms whose arguments are yet to be traversed, with the depth of the arguments
+  static Stack<pair<Term*,unsigned> > todo;
+  todo.reset();
+
+  unsigned clen=cl->length();
+  for(unsigned i=0; i<clen; i++) {
+    Literal* lit=(*cl)[i];
+    unsigned pol=lit->isPositive() ? 0 : 1;
+    fv[pol]++;
+    fv[FV_PRED_BASE+2*(lit->functor()%FV_PRED_BUCKETS)+pol]++;
+    todo.push(make_pair(lit, 1u));
+  }
+
+  while(todo.isNonEmpty()) {
+    pair<Term*,unsigned> top=todo.pop();
+    for(TermList* arg=top.first->args(); arg->isNonEmpty(); arg=arg->next()) {
+      if(!arg->isTerm()) {
+        continue;
+      }
+      Term* t=arg->term();
+      if(t->isSpecial()) {
+        continue;
+      }
+      unsigned bucket=t->functor()%FV_FUNC_BUCKETS;
+      fv[FV_FUNC_COUNT_BASE+bucket]++;
+      if(fv[FV_FUNC_DEPTH_BASE+bucket]<top.second) {
+        fv[FV_FUNC_DEPTH_BASE+bucket]=top.second;
+      }
+      if(t->arity()) {
+        todo.push(make_pair(t, top.second+1));
+      }
+    }
+  }
+}
+
+void FeatureVectorIndex::insert(Clause* cl)
+{
+  CALL("FeatureVectorIndex::insert");
+
+  unsigned fv[FV_SIZE];
+  computeFeatures(cl, fv);
+
+  Node* n=&_root;
+  for(unsigned i=0; i<FV_SIZE; i++) {
+    unsigned pos=n->lowerBound(fv[i]);
+    if(pos==n->children.size() || n->children[pos].value!=fv[i]) {
+      //insert the new child at pos, keeping the children sorted
+      n->children.push(Child(fv[i], new Node));
+      for(unsigned j=n->children.size()-1; j>pos; j--) {
+        std::swap(n->children[j], n->children[j-1]);
+      }
+    }
+    n=n->children[pos].node;
+  }
+  n->clauses.push(cl);
+}
+
+void FeatureVectorIndex::remove(Clause* cl)
+{
+  CALL("FeatureVectorIndex::remove");
+
+  unsigned fv[FV_SIZE];
+  computeFeatures(cl, fv);
+
+  Node* path[FV_SIZE+1];
+  unsigned positions[FV_SIZE];
+  path[0]=&_root;
+  for(unsigned i=0; i<FV_SIZE; i++) {
+    positions[i]=path[i]->lowerBound(fv[i]);
+    ASS_L(positions[i], path[i]->children.size());
+    ASS_EQ(path[i]->children[positions[i]].value, fv[i]);
+    path[i+1]=path[i]->children[positions[i]].node;
+  }
+
+  Stack<Clause*>& clauses=path[FV_SIZE]->clauses;
+  unsigned i=0;
+  while(clauses[i]!=cl) {
+    i++;
+    ASS_L(i, clauses.size());
+  }
+  clauses[i]=clauses.top();
+  clauses.pop();
+
+  //remove the nodes that became empty
+  for(unsigned lev=FV_SIZE; lev>0 && path[lev]->clauses.isEmpty() &&
+      path[lev]->children.isEmpty(); lev--) {
+    Stack<Child>& siblings=path[lev-1]->children;
+    for(unsigned j=positions[lev-1]+1; j<siblings.size(); j++) {
+      siblings[j-1]=siblings[j];
+    }
+    siblings.pop();
+    delete path[lev];
+  }
+}
+
+void FeatureVectorIndex::handleClause(Clause* c, bool adding)
+{
+  CALL("FeatureVectorIndex::handleClause");
+
+  TimeCounter tc(Lib::TimeCounterUnit::TC_BACKWARD_SUBSUMPTION_INDEX_MAINTENANCE);
+
+  if(adding) {
+    insert(c);
+  } else {
+    remove(c);
+  }
+}
+
+/**
+ * Iterator over the clauses in the leaves of the trie whose features
+ * are all at least the features of the query
+ */
+class FeatureVectorIndex::CandidateIterator
+: public IteratorCore<Clause*>
+{
+public:
+  CLASS_NAME(FeatureVectorIndex::CandidateIterator);
+  USE_ALLOCATOR(CandidateIterator);
+
+  CandidateIterator(Node* root, Clause* query)
+  : _leaf(0), _leafIdx(0)
+  {
+    computeFeatures(query, _query);
+    _frames.push(Frame(root, root->lowerBound(_query[0])));
+  }
+
+  bool hasNext()
+  {
+    CALL("FeatureVectorIndex::CandidateIterator::hasNext");
+
+    for(;;) {
+      if(_leaf && _leafIdx<_leaf->clauses.size()) {
+        return true;
+      }
+      _leaf=0;
+      if(_frames.isEmpty()) {
+        return false;
+      }
+      Frame& f=_frames.top();
+      if(f.next==f.node->children.size()) {
+        _frames.pop();
+        continue;
+      }
+      Node* child=f.node->children[f.next++].node;
+      unsigned level=_frames.size();
+      if(level==FV_SIZE) {
+        _leaf=child;
+        _leafIdx=0;
+      } else {
+        _frames.push(Frame(child, child->lowerBound(_query[level])));
+      }
+    }
+  }
+
+  Clause* next()
+  {
+    ASS(_leaf);
+    return _leaf->clauses[_leafIdx++];
+  }
+
+private:
+  struct Frame {
+    Frame(Node* node, unsigned next) : node(node), next(next) {}
+
+    Node* node;
+    /** Position of the next child of @b node to be entered */
+    unsigned next;
+  };
+
+  unsigned _query[FV_SIZE];
+  Stack<Frame> _frames;
+  Node* _leaf;
+  unsigned _leafIdx;
+};
+
+/**
+ * Return the clauses in the index that may be subsumed by @b cl,
+ * that is, those with no feature smaller than the feature of @b cl.
+ * The clause @b cl itself is among them if it is in the index.
+ */
+ClauseIterator FeatureVectorIndex::getSubsumptionCandidates(Clause* cl)
+{
+  CALL("FeatureVectorIndex::getSubsumptionCandidates");
+
+  return vi( new CandidateIterator(&_root, cl) );
+}
+
+}
@@ -0,0 +1,116 @@
+
+/*
+ * File FeatureVectorIndex.hpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions.
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide.
+ */
+/**
+ * @file FeatureVectorIndex.hpp
+ * Defines class FeatureVectorIndex.
+ */
+
+#ifndef __FeatureVectorIndex__
+#define __FeatureVectorIndex__
+
+#include "Forwards.hpp"
+
+#include "Lib/Allocator.hpp"
+#include "Lib/Stack.hpp"
+#include "Lib/VirtualIterator.hpp"
+
+#include "Index.hpp"
+
+/** Number of buckets of predicate symbols in a feature vector */
+#define FV_PRED_BUCKETS 4
+/** Number of buckets of function symbols in a feature vector */
+#define FV_FUNC_BUCKETS 8
+/** Number of features in a feature vector */
+#define FV_SIZE (2+2*FV_PRED_BUCKETS+2*FV_FUNC_BUCKETS)
+
+namespace Indexing {
+
+using namespace Kernel;
+using namespace Lib;
+
+/**
+ * Index of clauses by their feature vectors (S. Schulz, Simple and
+ * Efficient Clause Subsumption with Feature Vector Indexing, 2004),
+ * used to find the candidates for backward subsumption.
+ *
+ * The features of a clause are the numbers of its positive and negative
+ * literals, the numbers of its positive and negative literals in each
+ * bucket of predicate symbols, the number of occurrences of the function
+ * symbols of each bucket, and the greatest depth of an occurrence of
+ * a function symbol of each bucket. If a clause subsumes another one,
+ * none of its features is greater than the feature of the other clause.
+ *
+ * The clauses are kept in a trie over their feature vectors, whose
+ * nodes keep their children sorted by the value of the feature.
+ */
+class FeatureVectorIndex
+: public Index
+{
+public:
+  CLASS_NAME(FeatureVectorIndex);
+  USE_ALLOCATOR(FeatureVectorIndex);
+
+  FeatureVectorIndex();
+  ~FeatureVectorIndex();
+
+  ClauseIterator getSubsumptionCandidates(Clause* cl);
+
+  static void computeFeatures(Clause* cl, unsigned* fv);
+
+protected:
+  void handleClause(Clause* c, bool adding);
+
+private:
+  struct Node;
+
+  struct Child {
+    Child(unsigned value, Node* node) : value(value), node(node) {}
+
+    unsigned value;
+    Node* node;
+  };
+
+  /**
+   * A node of the trie. The nodes at the level FV_SIZE are leaves and
+   * hold the clauses with the feature vector of their path.
+   */
+  struct Node {
+    CLASS_NAME(FeatureVectorIndex::Node);
+    USE_ALLOCATOR(Node);
+
+    ~Node();
+
+    unsigned lowerBound(unsigned value) const;
+
+    /** Children sorted by the value of the feature */
+    Stack<Child> children;
+    Stack<Clause*> clauses;
+  };
+
+  class CandidateIterator;
+
+  void insert(Clause* cl);
+  void remove(Clause* cl);
+
+  Node _root;
+};
+
+};
+
+#endif /* __FeatureVectorIndex__ */
@@ -0,0 +1,461 @@
+
+/*
+ * File FingerprintIndex.cpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions.
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide.
+ */
+/**
+ * @file FingerprintIndex.cpp
+ * Implements class FingerprintIndex.
+ */
+
+#include "Lib/Recycler.hpp"
+
+#include "Kernel/Matcher.hpp"
+#include "Kernel/Ordering.hpp"
+#include "Kernel/RobSubstitution.hpp"
+#include "Kernel/SubstHelper.hpp"
+#include "Kernel/Term.hpp"
+
+#include "FingerprintIndex.hpp"
+
+/** Feature of a position with a variable */
+#define FP_VAR 0
+/** Feature of a position below a variable */
+#define FP_BELOW_VAR 1
+/** Feature of a position that does not exist in the term */
+#define FP_NOT_PRESENT 2
+/** Features of positions with a function symbol are its functor plus this */
+#define FP_FUNCTOR_BASE 3
+
+#define QUERY_BANK 0
+#define RESULT_BANK 1
+
+namespace Indexing
+{
+
+using namespace Lib;
+using namespace Kernel;
+
+namespace {
+
+/**
+ * The positions of the fingerprint as paths of argument indexes, -1
+ * ends a path. These are the positions ε, 1, 2, 3, 1.1, 1.2, 2.1 and 2.2.
+ */
+const int fingerprintPositions[FINGERPRINT_SIZE][2] = {
+  {-1,-1}, {0,-1}, {1,-1}, {2,-1}, {0,0}, {0,1}, {1,0}, {1,1}
+};
+
+/**
+ * Return true if a term with the feature @b feature at some position
+ * can be retrieved for a query with the feature @b query at the position.
+ */
+inline
+bool compatible(unsigned query, unsigned feature, bool unif, bool inst)
+{
+  switch(query) {
+  case FP_VAR:
+    if(unif) {
+      return feature!=FP_NOT_PRESENT;
+    }
+    if(inst) {
+      return feature!=FP_NOT_PRESENT && feature!=FP_BELOW_VAR;
+    }
+    return feature==FP_VAR || feature==FP_BELOW_VAR;
+  case FP_BELOW_VAR:
+    return unif || inst || feature==FP_BELOW_VAR;
+  case FP_NOT_PRESENT:
+    return feature==FP_NOT_PRESENT || (!inst && feature==FP_BELOW_VAR);
+  default:
+    return feature==query || (!inst && (feature==FP_VAR || feature==FP_BELOW_VAR));
+  }
+}
+
+}
+
+FingerprintIndex::Node::~Node()
+{
+  CALL("FingerprintIndex::Node::~Node");
+
+  DHMap<unsigned,Node*>::Iterator cit(children);
+  while(cit.hasNext()) {
+    delete cit.next();
+  }
+  Stack<Entry>::Iterator eit(entries);
+  while(eit.hasNext()) {
+    Entry& e=eit.next();
+    if(e.check) {
+      delete e.check;
+    }
+  }
+}
+
+FingerprintIndex::FingerprintIndex()
+: _size(0)
+{
+}
+
+FingerprintIndex::~FingerprintIndex()
+{
+}
+
+/**
+ * Store the fingerprint of @b t into the array @b fp of the size
+ * FINGERPRINT_SIZE
+ */
+void FingerprintIndex::computeFingerprint(TermList t, unsigned* fp)
+{
+  CALL("FingerprintIndex::computeFingerprint");
+
+  for(unsigned i=0; i<FINGERPRINT_SIZE; i++) {
+    const int* path=fingerprintPositions[i];
+    TermList s=t;
+    unsigned feature=0;
+    bool done=false;
+    for(unsigned j=0; j<2 && path[j]>=0; j++) {
+      if(s.isVar()) {
+        feature=FP_BELOW_VAR;
+        done=true;
+        break;
+      }
+      Term* st=s.term();
+      if(static_cast<unsigned>(path[j])>=st->arity()) {
+        feature=FP_NOT_PRESENT;
+        done=true;
+        break;
+      }
+      s=*st->nthArgument(path[j]);
+    }
+    if(!done) {
+      feature=s.isVar() ? FP_VAR : s.term()->functor()+FP_FUNCTOR_BASE;
+    }
+    fp[i]=feature;
+  }
+}
+
+void FingerprintIndex::insert(TermList t, Literal* lit, Clause* cls)
+{
+  CALL("FingerprintIndex::insert/3");
+
+  insert(t, lit, cls, 0);
+}
+
+void FingerprintIndex::insert(TermList t, Literal* lit, Clause* cls, InstanceOrderingCheck* check)
+{
+  CALL("FingerprintIndex::insert/4");
+
+  unsigned fp[FINGERPRINT_SIZE];
+  computeFingerprint(t, fp);
+
+  Node* n=&_root;
+  for(unsigned i=0; i<FINGERPRINT_SIZE; i++) {
+    Node** pchild;
+    if(n->children.getValuePtr(fp[i], pchild)) {
+      *pchild=new Node;
+    }
+    n=*pchild;
+  }
+  n->entries.push(Entry(t, lit, cls, check));
+  _size++;
+}
+
+void FingerprintIndex::remove(TermList t, Literal* lit, Clause* cls)
+{
+  CALL("FingerprintIndex::remove");
+
+  unsigned fp[FINGERPRINT_SIZE];
+  computeFingerprint(t, fp);
+
+  Node* path[FINGERPRINT_SIZE+1];
+  path[0]=&_root;
+  for(unsigned i=0; i<FINGERPRINT_SIZE; i++) {
+    ALWAYS(path[i]->children.find(fp[i], path[i+1]));
+  }
+
+  Stack<Entry>& entries=path[FINGERPRINT_SIZE]->entries;
+  unsigned i=0;
+  while(entries[i].term!=t || entries[i].literal!=lit || entries[i].clause!=cls) {
+    i++;
+    ASS_L(i,entries.size());
+  }
+  if(entries[i].check) {
+    delete entries[i].check;
+  }
+  //keep the order of the remaining entries, so that the results
+  //come in the order of insertion
+  for(i++; i<entries.size(); i++) {
+    entries[i-1]=entries[i];
+  }
+  entries.pop();
+  _size--;
+
+  //remove the nodes that became empty
+  for(unsigned lev=FINGERPRINT_SIZE; lev>0 && path[lev]->entries.isEmpty() &&
+      path[lev]->children.isEmpty(); lev--) {
+    path[lev-1]->children.remove(fp[lev-1]);
+    delete path[lev];
+  }
+}
+
+/**
+ * Push the child of @b n with the feature @b feature, if there is one,
+ * or the leaves under it onto @b leaves
+ */
+inline
+void FingerprintIndex::collectChild(Node* n, unsigned feature, unsigned level, const unsigned* fp,
+    Retrieval kind, Stack<Node*>& leaves)
+{
+  Node* child;
+  if(n->children.find(feature, child)) {
+    collectLeaves(child, level+1, fp, kind, leaves);
+  }
+}
+
+/**
+ * Push onto @b leaves the leaves under the node @b n at the level
+ * @b level whose fingerprints are compatible with @b fp.
+ */
+void FingerprintIndex::collectLeaves(Node* n, unsigned level, const unsigned* fp,
+    Retrieval kind, Stack<Node*>& leaves)
+{
+  CALL("FingerprintIndex::collectLeaves");
+
+  if(level==FINGERPRINT_SIZE) {
+    ASS(n->entries.isNonEmpty());
+    leaves.push(n);
+    return;
+  }
+
+  unsigned query=fp[level];
+  bool unif=kind==UNIFICATIONS;
+  bool inst=kind==INSTANCES;
+
+  //with a function symbol or a missing position in the query, there are
+  //at most three compatible features, so they are looked up directly
+  if(query==FP_NOT_PRESENT) {
+    collectChild(n, FP_NOT_PRESENT, level, fp, kind, leaves);
+    if(!inst) {
+      collectChild(n, FP_BELOW_VAR, level, fp, kind, leaves);
+    }
+    return;
+  }
+  if(query>=FP_FUNCTOR_BASE) {
+    collectChild(n, query, level, fp, kind, leaves);
+    if(!inst) {
+      collectChild(n, FP_VAR, level, fp, kind, leaves);
+      collectChild(n, FP_BELOW_VAR, level, fp, kind, leaves);
+    }
+    return;
+  }
+
+  DHMap<unsigned,Node*>::Iterator cit(n->children);
+  while(cit.hasNext()) {
+    unsigned feature;
+    Node* child;
+    cit.next(feature, child);
+    if(compatible(query, feature, unif, inst)) {
+      collectLeaves(child, level+1, fp, kind, leaves);
+    }
+  }
+}
+
+/**
+ * Substitution of a result retrieved by matching. For generalizations
+ * it binds the variables of the result, for instances those of the query.
+ */
+class FingerprintIndex::MatchSubstitution
+: public ResultSubstitution
+{
+public:
+  CLASS_NAME(FingerprintIndex::MatchSubstitution);
+  USE_ALLOCATOR(MatchSubstitution);
+
+  MatchSubstitution(bool resultBound) : _resultBound(resultBound) {}
+
+  TermList applyToBoundResult(TermList t)
+  {
+    CALL("FingerprintIndex::MatchSubstitution::applyToBoundResult(TermList)");
+    ASS(_resultBound);
+    return SubstHelper::apply(t, *this);
+  }
+
+  Literal* applyToBoundResult(Literal* lit)
+  {
+    CALL("FingerprintIndex::MatchSubstitution::applyToBoundResult(Literal*)");
+    ASS(_resultBound);
+    return SubstHelper::apply(lit, *this);
+  }
+
+  bool isIdentityOnQueryWhenResultBound() { return _resultBound; }
+
+  TermList applyToBoundQuery(TermList t)
+  {
+    CALL("FingerprintIndex::MatchSubstitution::applyToBoundQuery");
+    ASS(!_resultBound);
+    return SubstHelper::apply(t, *this);
+  }
+
+  bool isIdentityOnResultWhenQueryBound() { return !_resultBound; }
+
+  /** Applicator interface for SubstHelper */
+  TermList apply(unsigned var)
+  {
+    TermList res;
+    ALWAYS(bindings.find(var, res));
+    return res;
+  }
+
+  DHMap<unsigned,TermList> bindings;
+private:
+  bool _resultBound;
+};
+
+class FingerprintIndex::ResultIterator
+: public IteratorCore<TermQueryResult>
+{
+public:
+  ResultIterator(FingerprintIndex* index, TermList query, Retrieval kind, bool retrieveSubstitutions)
+  : _query(query), _kind(kind), _retrieveSubstitutions(retrieveSubstitutions),
+    _leafIdx(0), _entryIdx(0), _found(0), _subst(0), _match(kind==GENERALIZATIONS)
+  {
+    unsigned fp[FINGERPRINT_SIZE];
+    computeFingerprint(query, fp);
+    if(index->_size) {
+      index->collectLeaves(&index->_root, 0, fp, kind, _leaves);
+    }
+    if(kind==UNIFICATIONS) {
+      Recycler::get(_subst);
+    }
+  }
+
+  ~ResultIterator()
+  {
+    if(_subst) {
+      Recycler::release(_subst);
+    }
+  }
+
+  CLASS_NAME(FingerprintIndex::ResultIterator);
+  USE_ALLOCATOR(ResultIterator);
+
+  bool hasNext()
+  {
+    CALL("FingerprintIndex::ResultIterator::hasNext");
+
+    if(_found) {
+      return true;
+    }
+    while(_leafIdx<_leaves.size()) {
+      Stack<Entry>& entries=_leaves[_leafIdx]->entries;
+      if(_entryIdx==entries.size()) {
+        _leafIdx++;
+        _entryIdx=0;
+        continue;
+      }
+      Entry* e=&entries[_entryIdx++];
+      if(check(*e)) {
+        _found=e;
+        return true;
+      }
+    }
+    return false;
+  }
+
+  TermQueryResult next()
+  {
+    CALL("FingerprintIndex::ResultIterator::next");
+    ASS(_found);
+
+    TermQueryResult res;
+    if(!_retrieveSubstitutions) {
+      res=TermQueryResult(_found->term, _found->literal, _found->clause);
+    }
+    else if(_kind==UNIFICATIONS) {
+      res=TermQueryResult(_found->term, _found->literal, _found->clause,
+          ResultSubstitution::fromSubstitution(_subst, QUERY_BANK, RESULT_BANK));
+    }
+    else {
+      res=TermQueryResult(_found->term, _found->literal, _found->clause,
+          ResultSubstitutionSP(&_match, true));
+    }
+    res.orderingCheck=_found->check;
+    _found=0;
+    return res;
+  }
+
+private:
+  /** Return true if the term of @b e is a result of the query */
+  bool check(const Entry& e)
+  {
+    if(_kind==UNIFICATIONS) {
+      _subst->reset();
+      return _subst->unify(_query, QUERY_BANK, e.term, RESULT_BANK);
+    }
+    _match.bindings.reset();
+    MatchingUtils::MapRefBinder<DHMap<unsigned,TermList> > binder(_match.bindings);
+    if(_kind==GENERALIZATIONS) {
+      return MatchingUtils::matchTerms(e.term, _query, binder);
+    }
+    return MatchingUtils::matchTerms(_query, e.term, binder);
+  }
+
+  TermList _query;
+  Retrieval _kind;
+  bool _retrieveSubstitutions;
+  Stack<Node*> _leaves;
+  unsigned _leafIdx;
+  unsigned _entryIdx;
+  Entry* _found;
+  RobSubstitution* _subst;
+  MatchSubstitution _match;
+};
+
+TermQueryResultIterator FingerprintIndex::getResultIterator(TermList t, Retrieval kind, bool retrieveSubstitutions)
+{
+  CALL("FingerprintIndex::getResultIterator");
+
+  return vi( new ResultIterator(this, t, kind, retrieveSubstitutions) );
+}
+
+TermQueryResultIterator FingerprintIndex::getUnifications(TermList t, bool retrieveSubstitutions)
+{
+  CALL("FingerprintIndex::getUnifications");
+
+  return getResultIterator(t, UNIFICATIONS, retrieveSubstitutions);
+}
+
+TermQueryResultIterator FingerprintIndex::getGeneralizations(TermList t, bool retrieveSubstitutions)
+{
+  CALL("FingerprintIndex::getGeneralizations");
+
+  return getResultIterator(t, GENERALIZATIONS, retrieveSubstitutions);
+}
+
+TermQueryResultIterator FingerprintIndex::getInstances(TermList t, bool retrieveSubstitutions)
+{
+  CALL("FingerprintIndex::getInstances");
+
+  return getResultIterator(t, INSTANCES, retrieveSubstitutions);
+}
+
+bool FingerprintIndex::generalizationExists(TermList t)
+{
+  CALL("FingerprintIndex::generalizationExists");
+
+  return getResultIterator(t, GENERALIZATIONS, false).hasNext();
+}
+
+}
@@ -0,0 +1,132 @@
+
+/*
+ * File FingerprintIndex.hpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions.
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide.
+ */
+/**
+ * @file FingerprintIndex.hpp
+ * Defines class FingerprintIndex.
+ */
+
+#ifndef __FingerprintIndex__
+#define __FingerprintIndex__
+
+#include "Forwards.hpp"
+
+#include "Lib/Allocator.hpp"
+#include "Lib/DHMap.hpp"
+#include "Lib/Stack.hpp"
+
+#include "Index.hpp"
+#include "TermIndexingStructure.hpp"
+
+/** Number of positions sampled into a fingerprint */
+#define FINGERPRINT_SIZE 8
+
+namespace Indexing {
+
+using namespace Kernel;
+using namespace Lib;
+
+/**
+ * Term indexing structure based on fingerprints (S. Schulz, Fingerprint
+ * Indexing for Paramodulation and Rewriting, IJCAR 2012).
+ *
+ * The fingerprint of a term records, for each of a fixed set of
+ * positions, the top functor of the subterm at the position, whether
+ * there is a variable at the position, whether the position lies below
+ * a variable, or whether it does not exist at all. Two terms can only be
+ * unifiable (or one can only be an instance of the other) if their
+ * features at each position are compatible.
+ *
+ * The terms are kept in a trie over their fingerprints. A query collects
+ * the leaves of the trie that are compatible with its fingerprint, and
+ * the terms in them are then unified or matched with the query to obtain
+ * the results and their substitutions.
+ */
+class FingerprintIndex
+: public TermIndexingStructure
+{
+public:
+  CLASS_NAME(FingerprintIndex);
+  USE_ALLOCATOR(FingerprintIndex);
+
+  FingerprintIndex();
+  ~FingerprintIndex();
+
+  void insert(TermList t, Literal* lit, Clause* cls);
+  void insert(TermList t, Literal* lit, Clause* cls, InstanceOrderingCheck* check);
+  void remove(TermList t, Literal* lit, Clause* cls);
+
+  TermQueryResultIterator getUnifications(TermList t, bool retrieveSubstitutions = true);
+  TermQueryResultIterator getGeneralizations(TermList t, bool retrieveSubstitutions = true);
+  TermQueryResultIterator getInstances(TermList t, bool retrieveSubstitutions = true);
+
+  bool generalizationExists(TermList t);
+
+#if VDEBUG
+  virtual void markTagged(){}
+#endif
+
+private:
+  /** Relation of the retrieved terms to the query */
+  enum Retrieval {
+    UNIFICATIONS,
+    GENERALIZATIONS,
+    INSTANCES
+  };
+
+  struct Entry {
+    Entry(TermList t, Literal* lit, Clause* cls, InstanceOrderingCheck* check)
+    : term(t), literal(lit), clause(cls), check(check) {}
+
+    TermList term;
+    Literal* literal;
+    Clause* clause;
+    /** Ordering check given with the term, owned by the index */
+    InstanceOrderingCheck* check;
+  };
+
+  /**
+   * A node of the trie. The nodes at the level FINGERPRINT_SIZE are
+   * leaves and hold the terms with the fingerprint of their path.
+   */
+  struct Node {
+    CLASS_NAME(FingerprintIndex::Node);
+    USE_ALLOCATOR(Node);
+
+    ~Node();
+
+    DHMap<unsigned,Node*> children;
+    Stack<Entry> entries;
+  };
+
+  class MatchSubstitution;
+  class ResultIterator;
+
+  static void computeFingerprint(TermList t, unsigned* fp);
+  void collectLeaves(Node* n, unsigned level, const unsigned* fp, Retrieval kind, Stack<Node*>& leaves);
+  void collectChild(Node* n, unsigned feature, unsigned level, const unsigned* fp, Retrieval kind, Stack<Node*>& leaves);
+  TermQueryResultIterator getResultIterator(TermList t, Retrieval kind, bool retrieveSubstitutions);
+
+  Node _root;
+  /** Number of terms in the index */
+  unsigned _size;
+};
+
+};
+
+#endif /* __FingerprintIndex__ */
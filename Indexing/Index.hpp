@@ -78,19 +78,21 @@ struct SLQueryResult
  */
 struct TermQueryResult
 {
-  TermQueryResult() {}
+  TermQueryResult() : orderingCheck(0) {}
   TermQueryResult(TermList t, Literal* l, Clause* c, ResultSubstitutionSP s)
-  : term(t), literal(l), clause(c), substitution(s) {}
+  : term(t), literal(l), clause(c), substitution(s), orderingCheck(0) {}
   TermQueryResult(TermList t, Literal* l, Clause* c)
-  : term(t), literal(l), clause(c) {}
+  : term(t), literal(l), clause(c), orderingCheck(0) {}
   TermQueryResult(TermList t, Literal* l, Clause* c, ResultSubstitutionSP s,UnificationConstraintStackSP con)
-  : term(t), literal(l), clause(c), substitution(s), constraints(con) {}
+  : term(t), literal(l), clause(c), substitution(s), constraints(con), orderingCheck(0) {}
 
   TermList term;
   Literal* literal;
   Clause* clause;
   ResultSubstitutionSP substitution;
   UnificationConstraintStackSP constraints;
+  /** The ordering check stored with the term in the index, if any */
+  InstanceOrderingCheck* orderingCheck;
 };
 
 struct ClauseSResQueryResult
@@ -30,6 +30,8 @@
 #include "AcyclicityIndex.hpp"
 #include "ArithmeticIndex.hpp"
 #include "CodeTreeInterfaces.hpp"
+#include "FeatureVectorIndex.hpp"
+#include "FingerprintIndex.hpp"
 #include "GroundingIndex.hpp"
 #include "LiteralIndex.hpp"
 #include "LiteralSubstitutionTree.hpp"
@@ -152,6 +154,12 @@ Index* IndexManager::create(IndexType t)
 
   bool isGenerating;
   static bool useConstraints = env.options->unificationWithAbstraction()!=Options::UnificationWithAbstraction::OFF;
+  //fingerprint indexes do not retrieve unifications with constraints
+  static Options::FingerprintIndexUse fpUse = env.options->fingerprintIndex();
+  static bool fpSuperposition = !useConstraints &&
+      (fpUse==Options::FingerprintIndexUse::SUPERPOSITION || fpUse==Options::FingerprintIndexUse::ALL);
+  static bool fpDemodulation =
+      fpUse==Options::FingerprintIndexUse::DEMODULATION || fpUse==Options::FingerprintIndexUse::ALL;
   switch(t) {
   case Indexing::IndexType::GENERATING_SUBST_TREE:
     is=new LiteralSubstitutionTree(useConstraints);
@@ -169,7 +177,7 @@ Index* IndexManager::create(IndexType t)
     break;
 
   case Indexing::IndexType::SIMPLIFYING_UNIT_CLAUSE_SUBST_TREE:
-    is=new LiteralSubstitutionTree();
+    is=new LiteralSubstitutionTree(false, env.options->flatSubsumptionIndex());
     res=new UnitClauseLiteralIndex(is);
     isGenerating = false;
     break;
@@ -185,7 +193,11 @@ Index* IndexManager::create(IndexType t)
     break;
 
   case Indexing::IndexType::SUPERPOSITION_SUBTERM_SUBST_TREE:
-    tis=new TermSubstitutionTree(useConstraints);
+    if(fpSuperposition) {
+      tis=new FingerprintIndex();
+    } else {
+      tis=new TermSubstitutionTree(useConstraints);
+    }
 #if VDEBUG
     //tis->markTagged();
 #endif
@@ -193,7 +205,11 @@ Index* IndexManager::create(IndexType t)
     isGenerating = true;
     break;
   case Indexing::IndexType::SUPERPOSITION_LHS_SUBST_TREE:
-    tis=new TermSubstitutionTree(useConstraints);
+    if(fpSuperposition) {
+      tis=new FingerprintIndex();
+    } else {
+      tis=new TermSubstitutionTree(useConstraints);
+    }
     res=new SuperpositionLHSIndex(tis, _alg->getOrdering(), _alg->getOptions());
     isGenerating = true;
     break;
@@ -205,7 +221,11 @@ Index* IndexManager::create(IndexType t)
     break;
 
   case Indexing::IndexType::DEMODULATION_SUBTERM_SUBST_TREE:
-    tis=new TermSubstitutionTree();
+    if(fpDemodulation) {
+      tis=new FingerprintIndex();
+    } else {
+      tis=new TermSubstitutionTree();
+    }
     res = 0;
     //TODO:
     //res=new DemodulationSubtdermIndex(tis);
@@ -213,7 +233,11 @@ Index* IndexManager::create(IndexType t)
     break;
   case Indexing::IndexType::DEMODULATION_LHS_SUBST_TREE:
 //    tis=new TermSubstitutionTree();
-    tis=new CodeTreeTIS();
+    if(fpDemodulation) {
+      tis=new FingerprintIndex();
+    } else {
+      tis=new CodeTreeTIS();
+    }
     res=new DemodulationLHSIndex(tis, _alg->getOrdering(), _alg->getOptions());
     isGenerating = false;
     break;
@@ -224,12 +248,17 @@ Index* IndexManager::create(IndexType t)
     break;
 
   case Indexing::IndexType::FW_SUBSUMPTION_SUBST_TREE:
-    is=new LiteralSubstitutionTree();
+    is=new LiteralSubstitutionTree(false, env.options->flatSubsumptionIndex());
 //    is=new CodeTreeLIS();
     res=new FwSubsSimplifyingLiteralIndex(is);
     isGenerating = false;
     break;
 
+  case Indexing::IndexType::BW_SUBSUMPTION_FEATURE_VECTOR_INDEX:
+    res=new FeatureVectorIndex();
+    isGenerating = false;
+    break;
+
   case Indexing::IndexType::REWRITE_RULE_SUBST_TREE:
     is=new LiteralSubstitutionTree();
     res=new RewriteRuleIndex(is, _alg->getOrdering());
@@ -53,6 +53,7 @@ enum class IndexType {
 
   FW_SUBSUMPTION_SUBST_TREE,
   BW_SUBSUMPTION_SUBST_TREE,
+  BW_SUBSUMPTION_FEATURE_VECTOR_INDEX,
 
   REWRITE_RULE_SUBST_TREE,
 
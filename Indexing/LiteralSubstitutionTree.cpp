@@ -32,14 +32,32 @@
 
 #include "LiteralSubstitutionTree.hpp"
 
+/**
+ * A modified root is copied again when the number of queries to it
+ * times this number reaches the number of nodes of the last copy.
+ * Until then, the queries go to the tree itself.
+ */
+#define FLAT_TREE_NODES_PER_QUERY 4
+
 namespace Indexing
 {
 
-LiteralSubstitutionTree::LiteralSubstitutionTree(bool useC)
-: SubstitutionTree(2*env.signature->predicates(),useC)
+LiteralSubstitutionTree::LiteralSubstitutionTree(bool useC, bool useFlatTrees)
+: SubstitutionTree(2*env.signature->predicates(),useC), _useFlatTrees(useFlatTrees)
 {
 }
 
+LiteralSubstitutionTree::~LiteralSubstitutionTree()
+{
+  CALL("LiteralSubstitutionTree::~LiteralSubstitutionTree");
+
+  for (unsigned i = 0; i<_flatTrees.size(); i++) {
+    if(_flatTrees[i]) {
+      delete _flatTrees[i];
+    }
+  }
+}
+
 void LiteralSubstitutionTree::insert(Literal* lit, Clause* cls)
 {
   CALL("LiteralSubstitutionTree::insert");
@@ -60,11 +78,18 @@ void LiteralSubstitutionTree::handleLiteral(Literal* lit, Clause* cls, bool inse
 
   BindingMap svBindings;
   getBindings(normLit, svBindings);
+  unsigned rootIndex=getRootNodeIndex(normLit);
   if(insert) {
     //cout << "Into " << this << " insert " << lit->toString() << endl;
-    SubstitutionTree::insert(&_nodes[getRootNodeIndex(normLit)], svBindings, LeafData(cls, lit));
+    SubstitutionTree::insert(&_nodes[rootIndex], svBindings, LeafData(cls, lit));
   } else {
-    SubstitutionTree::remove(&_nodes[getRootNodeIndex(normLit)], svBindings, LeafData(cls, lit));
+    SubstitutionTree::remove(&_nodes[rootIndex], svBindings, LeafData(cls, lit));
+  }
+
+  if(_useFlatTrees && _flatTrees[rootIndex]) {
+    delete _flatTrees[rootIndex];
+    _flatTrees[rootIndex]=0;
+    _staleQueries[rootIndex]=0;
   }
 }
 
@@ -88,6 +113,13 @@ SLQueryResultIterator LiteralSubstitutionTree::getGeneralizations(Literal* lit,
 {
   CALL("LiteralSubstitutionTree::getGeneralizations");
 
+  if(_useFlatTrees && !retrieveSubstitutions) {
+    FlatTree* flat=getFlatTree(getRootNodeIndex(lit, complementary));
+    if(flat) {
+      return getFlatGeneralizations(lit, flat);
+    }
+  }
+
   SLQueryResultIterator res=
 //  getResultIterator<GeneralizationsIterator>(lit,
     getResultIterator<FastGeneralizationsIterator>(lit,
@@ -326,6 +358,58 @@ SLQueryResultIterator LiteralSubstitutionTree::getResultIterator(Literal* lit,
   }
 }
 
+/**
+ * Return the FlatTree copy of the root with index @b rootIndex, or zero
+ * if the root is empty or a leaf, or if it is not worth copying the root
+ * yet. The cost of copying a modified root is paid off by the queries
+ * that come before it is modified again, so a root is copied again only
+ * after enough queries were made to it, see FLAT_TREE_NODES_PER_QUERY.
+ */
+SubstitutionTree::FlatTree* LiteralSubstitutionTree::getFlatTree(unsigned rootIndex)
+{
+  CALL("LiteralSubstitutionTree::getFlatTree");
+
+  FlatTree* flat=_flatTrees[rootIndex];
+  if(flat) {
+    return flat;
+  }
+  Node* root=_nodes[rootIndex];
+  if(!root || root->isLeaf()) {
+    return 0;
+  }
+  if(++_staleQueries[rootIndex]*FLAT_TREE_NODES_PER_QUERY < _flatTreeSizes[rootIndex]) {
+    return 0;
+  }
+
+  flat=new FlatTree(root);
+  _flatTrees[rootIndex]=flat;
+  _flatTreeSizes[rootIndex]=flat->size();
+  return flat;
+}
+
+SLQueryResultIterator LiteralSubstitutionTree::getFlatGeneralizations(Literal* lit, FlatTree* flat)
+{
+  CALL("LiteralSubstitutionTree::getFlatGeneralizations");
+
+  if(lit->commutative()) {
+    VirtualIterator<QueryResult> qrit1=vi(
+  	    new FlatGeneralizationsIterator(this, flat, lit, false) );
+    VirtualIterator<QueryResult> qrit2=vi(
+  	    new FlatGeneralizationsIterator(this, flat, lit, true) );
+    ASS(lit->isEquality());
+    return pvi(
+	getFilteredIterator(
+	    getMappingIterator(
+		getConcatenatedIterator(qrit1,qrit2), SLQueryResultFunctor()),
+	    EqualitySortFilter(lit))
+	);
+  } else {
+    VirtualIterator<QueryResult> qrit=vi(
+  	    new FlatGeneralizationsIterator(this, flat, lit, false) );
+    return pvi( getMappingIterator(qrit, SLQueryResultFunctor()) );
+  }
+}
+
 unsigned LiteralSubstitutionTree::getRootNodeIndex(Literal* t, bool complementary)
 {
   if(complementary) {
@@ -37,7 +37,8 @@ public:
   CLASS_NAME(LiteralSubstitutionTree);
   USE_ALLOCATOR(LiteralSubstitutionTree);
 
-  LiteralSubstitutionTree(bool useC=false);
+  LiteralSubstitutionTree(bool useC=false, bool useFlatTrees=false);
+  ~LiteralSubstitutionTree();
 
   void insert(Literal* lit, Clause* cls);
   void remove(Literal* lit, Clause* cls);
@@ -80,6 +81,18 @@ private:
 	  bool complementary, bool retrieveSubstitutions, bool useConstraints);
 
   unsigned getRootNodeIndex(Literal* t, bool complementary=false);
+
+  FlatTree* getFlatTree(unsigned rootIndex);
+  SLQueryResultIterator getFlatGeneralizations(Literal* lit, FlatTree* flat);
+
+  /** Retrieve generalizations without substitutions from FlatTree copies of the roots */
+  bool _useFlatTrees;
+  /** The copies of the roots, zero where the root was modified since the copy was made */
+  ZIArray<FlatTree*> _flatTrees;
+  /** Number of nodes in the last copy made of each root */
+  ZIArray<unsigned> _flatTreeSizes;
+  /** Number of queries to each modified root since it was last copied */
+  ZIArray<unsigned> _staleQueries;
 };
 
 };
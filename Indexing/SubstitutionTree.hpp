@@ -767,6 +767,105 @@ public:
     Stack<NodeAlgorithm> _nodeTypes;
   };
 
+  /**
+   * Read-only copy of the tree under one root, laid out in contiguous
+   * arrays for the retrieval of generalizations.
+   *
+   * The children of a node are stored next to each other, the variable
+   * children first and then the proper term children sorted by the top
+   * functor. The functors are also kept in a separate array of keys, so
+   * the child with a given top functor is found by scanning a block of
+   * integers instead of following pointers through skip lists.
+   *
+   * The copy does not follow changes of the tree, it must be thrown away
+   * and built again when the tree under the root is modified.
+   *
+   * This class is defined in SubstitutionTree_Flat.cpp
+   */
+  class FlatGeneralizationsIterator;
+  class FlatTree
+  {
+  public:
+    CLASS_NAME(SubstitutionTree::FlatTree);
+    USE_ALLOCATOR(SubstitutionTree::FlatTree);
+
+    explicit FlatTree(Node* root);
+
+    /** Number of nodes in the copy */
+    unsigned size() const { return _nodes.size(); }
+
+  private:
+    friend class FlatGeneralizationsIterator;
+
+    struct FlatNode {
+      /** term at this node */
+      TermList term;
+      /** For intermediate nodes the special variable of the children */
+      unsigned childVar;
+      /** Index of the first child in _nodes, or of the first leaf data in _leafData */
+      unsigned first;
+      /** Number of children with a variable term, or of leaf data for leaves */
+      unsigned varChildren;
+      /** Number of children with a proper term, they follow the variable ones */
+      unsigned termChildren;
+      bool leaf;
+    };
+
+    unsigned findChild(const FlatNode& n, unsigned functor) const;
+
+    Stack<FlatNode> _nodes;
+    /** Top functors of proper term nodes, at the same positions as in _nodes */
+    Stack<unsigned> _keys;
+    Stack<LeafData> _leafData;
+  };
+
+  /**
+   * Iterator that yields generalizations of a term/literal from a FlatTree,
+   * in the same order as FastGeneralizationsIterator does from the tree
+   * the copy was made of. Substitutions are not retrieved.
+   */
+  class FlatGeneralizationsIterator
+  : public IteratorCore<QueryResult>
+  {
+  public:
+    FlatGeneralizationsIterator(SubstitutionTree* parent, FlatTree* flat, Term* query, bool reversed);
+    ~FlatGeneralizationsIterator();
+
+    bool hasNext();
+    QueryResult next();
+
+  private:
+    struct Binder;
+    struct Frame {
+      /** The node whose children are tried */
+      unsigned node;
+      /** The proper term child to be tried first, or zero if there is none */
+      unsigned termChild;
+      /** The next variable child to be tried */
+      unsigned nextChild;
+      unsigned endChild;
+      /** Height of _boundVars when the node was entered */
+      unsigned boundVars;
+    };
+
+    bool findNextLeaf();
+    void enterNode(unsigned node);
+    bool match(unsigned specVar, TermList nodeTerm);
+
+    SubstitutionTree* _tree;
+    FlatTree* _flat;
+    /** The next leaf data to yield and the one after the last */
+    unsigned _nextLD;
+    unsigned _endLD;
+    /** Bindings of the special variables to subterms of the query */
+    DArray<TermList>* _specVars;
+    /** Bindings of the ordinary variables in the tree */
+    ArrayMap<TermList>* _bindings;
+    unsigned _maxVar;
+    VarStack _boundVars;
+    Stack<Frame> _frames;
+  };
+
   class InstMatcher;
 
   /**
@@ -0,0 +1,328 @@
+
+/*
+ * File SubstitutionTree_Flat.cpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions.
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide.
+ */
+/**
+ * @file SubstitutionTree_Flat.cpp
+ * Implements classes SubstitutionTree::FlatTree and
+ * SubstitutionTree::FlatGeneralizationsIterator.
+ */
+
+#include <algorithm>
+
+#include "Lib/Allocator.hpp"
+#include "Lib/Recycler.hpp"
+
+#include "Kernel/Matcher.hpp"
+
+#include "SubstitutionTree.hpp"
+
+/**
+ * Children with a proper term are looked up by counting the keys smaller
+ * than the functor when there are at most this many of them, and by
+ * binary search otherwise. The counting loop has no branches, so the
+ * compiler turns it into vector instructions.
+ */
+#define FLAT_TREE_SCAN_LIMIT 32
+
+namespace Indexing
+{
+
+namespace {
+
+struct NodeFunctorLess
+{
+  bool operator()(SubstitutionTree::Node* n1, SubstitutionTree::Node* n2) const
+  { return n1->term.term()->functor() < n2->term.term()->functor(); }
+};
+
+}
+
+/**
+ * Copy the tree under @b root, which must not be a leaf.
+ *
+ * The nodes are laid out level by level, so that the children of
+ * each node occupy a contiguous block of the array. The order of the
+ * variable children and of the leaf data is that of the tree, so that
+ * the retrieval yields the results in the same order.
+ */
+SubstitutionTree::FlatTree::FlatTree(Node* root)
+{
+  CALL("SubstitutionTree::FlatTree::FlatTree");
+  ASS(!root->isLeaf());
+
+  static Stack<Node*> originals;
+  static Stack<Node*> termChildren;
+  originals.reset();
+  originals.push(root);
+
+  for(unsigned i=0; i<originals.size(); i++) {
+    Node* orig=originals[i];
+    FlatNode fn;
+    fn.term=orig->term;
+    fn.termChildren=0;
+    if(orig->isLeaf()) {
+      fn.leaf=true;
+      fn.childVar=0;
+      fn.first=_leafData.size();
+      LDIterator ldit=static_cast<Leaf*>(orig)->allChildren();
+      while(ldit.hasNext()) {
+        _leafData.push(ldit.next());
+      }
+      fn.varChildren=_leafData.size()-fn.first;
+    } else {
+      IntermediateNode* inode=static_cast<IntermediateNode*>(orig);
+      fn.leaf=false;
+      fn.childVar=inode->childVar;
+      fn.first=originals.size();
+
+      termChildren.reset();
+      NodeIterator nit=inode->allChildren();
+      while(nit.hasNext()) {
+        Node* child=*nit.next();
+        if(child->term.isVar()) {
+          originals.push(child);
+        } else {
+          termChildren.push(child);
+        }
+      }
+      fn.varChildren=originals.size()-fn.first;
+      fn.termChildren=termChildren.size();
+      std::sort(termChildren.begin(), termChildren.end(), NodeFunctorLess());
+      originals.loadFromIterator(Stack<Node*>::BottomFirstIterator(termChildren));
+    }
+    _nodes.push(fn);
+    _keys.push(orig->term.isTerm() ? orig->term.term()->functor() : 0);
+  }
+  ASS_EQ(_nodes.size(), originals.size());
+}
+
+/**
+ * Return the index of the child of @b n with a proper term whose top
+ * functor is @b functor, or zero if there is no such child.
+ */
+inline
+unsigned SubstitutionTree::FlatTree::findChild(const FlatNode& n, unsigned functor) const
+{
+  unsigned start=n.first+n.varChildren;
+  const unsigned* keys=_keys.begin()+start;
+  unsigned cnt=n.termChildren;
+
+  unsigned pos;
+  if(cnt<=FLAT_TREE_SCAN_LIMIT) {
+    pos=0;
+    for(unsigned i=0; i<cnt; i++) {
+      pos+=keys[i]<functor;
+    }
+  } else {
+    pos=std::lower_bound(keys, keys+cnt, functor)-keys;
+  }
+  if(pos<cnt && keys[pos]==functor) {
+    return start+pos;
+  }
+  return 0;
+}
+
+/**
+ * Binding structure to be passed to the @b MatchingUtils::matchArgs
+ * method, see SubstitutionTree::GenMatcher::Binder
+ */
+struct SubstitutionTree::FlatGeneralizationsIterator::Binder
+{
+  inline
+  Binder(FlatGeneralizationsIterator* parent) : _parent(parent) {}
+
+  bool bind(unsigned var, TermList term)
+  {
+    if(var > _parent->_maxVar) {
+      return false;
+    }
+    TermList* aux;
+    if(_parent->_bindings->getValuePtr(var,aux,term)) {
+      _parent->_boundVars.push(var);
+      return true;
+    } else {
+      return *aux==term;
+    }
+  }
+  inline
+  void specVar(unsigned var, TermList term)
+  {
+    (*_parent->_specVars)[var]=term;
+  }
+private:
+  FlatGeneralizationsIterator* _parent;
+};
+
+/**
+ * If @b reversed is true, the arguments of the binary commutative query
+ * literal are matched in the reversed order.
+ */
+SubstitutionTree::FlatGeneralizationsIterator::FlatGeneralizationsIterator(SubstitutionTree* parent,
+    FlatTree* flat, Term* query, bool reversed)
+: _tree(parent), _flat(flat), _nextLD(0), _endLD(0), _boundVars(64), _frames(64)
+{
+  CALL("SubstitutionTree::FlatGeneralizationsIterator::FlatGeneralizationsIterator");
+
+#if VDEBUG
+  _tree->_iteratorCnt++;
+#endif
+
+  Recycler::get(_specVars);
+  if(_specVars->size()<static_cast<unsigned>(parent->_nextVar)) {
+    _specVars->ensure(max(static_cast<unsigned>(_specVars->size()*2), static_cast<unsigned>(parent->_nextVar)));
+  }
+  Recycler::get(_bindings);
+  _bindings->ensure(query->weight());
+  _bindings->reset();
+  _maxVar=query->weight()-1;
+
+  if(reversed) {
+    ASS(query->commutative());
+    ASS_EQ(query->arity(),2);
+    (*_specVars)[1]=*query->nthArgument(0);
+    (*_specVars)[0]=*query->nthArgument(1);
+  } else {
+    unsigned nextVar=0;
+    for(TermList* args=query->args(); !args->isEmpty(); args=args->next()) {
+      (*_specVars)[nextVar++]=*args;
+    }
+  }
+
+  enterNode(0);
+}
+
+SubstitutionTree::FlatGeneralizationsIterator::~FlatGeneralizationsIterator()
+{
+  CALL("SubstitutionTree::FlatGeneralizationsIterator::~FlatGeneralizationsIterator");
+
+#if VDEBUG
+  _tree->_iteratorCnt--;
+#endif
+  Recycler::release(_bindings);
+  Recycler::release(_specVars);
+}
+
+bool SubstitutionTree::FlatGeneralizationsIterator::hasNext()
+{
+  CALL("SubstitutionTree::FlatGeneralizationsIterator::hasNext");
+
+  while(_nextLD==_endLD && findNextLeaf()) {}
+  return _nextLD!=_endLD;
+}
+
+SubstitutionTree::QueryResult SubstitutionTree::FlatGeneralizationsIterator::next()
+{
+  CALL("SubstitutionTree::FlatGeneralizationsIterator::next");
+
+  while(_nextLD==_endLD && findNextLeaf()) {}
+  ASS_L(_nextLD,_endLD);
+  LeafData* ld=&_flat->_leafData[_nextLD++];
+  return QueryResult(make_pair(ld, ResultSubstitutionSP()),UnificationConstraintStackSP());
+}
+
+/**
+ * Push the frame for trying the children of @b node, if it has any
+ * children that may match. The child with a proper term comes first,
+ * as in FastGeneralizationsIterator::enterNode().
+ */
+void SubstitutionTree::FlatGeneralizationsIterator::enterNode(unsigned node)
+{
+  const FlatTree::FlatNode& n=_flat->_nodes[node];
+  ASS(!n.leaf);
+
+  Frame f;
+  f.node=node;
+  f.termChild=0;
+  TermList binding=(*_specVars)[n.childVar];
+  if(binding.isTerm() && n.termChildren) {
+    f.termChild=_flat->findChild(n, binding.term()->functor());
+  }
+  f.nextChild=n.first;
+  f.endChild=n.first+n.varChildren;
+  f.boundVars=_boundVars.size();
+  if(f.termChild || f.nextChild<f.endChild) {
+    _frames.push(f);
+  }
+}
+
+/**
+ * Match the term @b nodeTerm of a node against the binding of the
+ * special variable @b specVar, as in GenMatcher::matchNext().
+ * The ordinary variables bound by the matching are pushed on
+ * @b _boundVars even when the matching fails.
+ */
+inline
+bool SubstitutionTree::FlatGeneralizationsIterator::match(unsigned specVar, TermList nodeTerm)
+{
+  TermList queryTerm=(*_specVars)[specVar];
+  Binder binder(this);
+
+  if(nodeTerm.isVar()) {
+    return binder.bind(nodeTerm.var(), queryTerm);
+  }
+  Term* nt=nodeTerm.term();
+  if(nt->shared() && nt->ground()) {
+    return nodeTerm==queryTerm;
+  }
+  ASS(nt->arity()>0);
+  return queryTerm.isTerm() && queryTerm.term()->functor()==nt->functor() &&
+    MatchingUtils::matchArgs(nt, queryTerm.term(), binder);
+}
+
+/**
+ * Find the next leaf that contains generalizations of the query and set
+ * @b _nextLD and @b _endLD to its leaf data. If there is no such leaf,
+ * return false.
+ */
+bool SubstitutionTree::FlatGeneralizationsIterator::findNextLeaf()
+{
+  CALL("SubstitutionTree::FlatGeneralizationsIterator::findNextLeaf");
+
+  while(_frames.isNonEmpty()) {
+    Frame& f=_frames.top();
+    unsigned child;
+    if(f.termChild) {
+      child=f.termChild;
+      f.termChild=0;
+    } else if(f.nextChild<f.endChild) {
+      child=f.nextChild++;
+    } else {
+      _frames.pop();
+      continue;
+    }
+
+    //undo the bindings made below the previous child
+    while(_boundVars.size()>f.boundVars) {
+      _bindings->remove(_boundVars.pop());
+    }
+
+    const FlatTree::FlatNode& cn=_flat->_nodes[child];
+    if(!match(_flat->_nodes[f.node].childVar, cn.term)) {
+      continue;
+    }
+    if(cn.leaf) {
+      _nextLD=cn.first;
+      _endLD=cn.first+cn.varChildren;
+      return true;
+    }
+    enterNode(child);
+  }
+  return false;
+}
+
+}
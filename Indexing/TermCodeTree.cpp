@@ -31,6 +31,7 @@
 
 #include "Kernel/Clause.hpp"
 #include "Kernel/FlatTerm.hpp"
+#include "Kernel/Ordering.hpp"
 #include "Kernel/Term.hpp"
 #include "Kernel/TermIterators.hpp"
 
@@ -51,6 +52,11 @@ void TermCodeTree::onCodeOpDestroying(CodeOp* op)
   }
 }
 
+TermCodeTree::TermInfo::~TermInfo()
+{
+  delete check;
+}
+
 TermCodeTree::TermCodeTree()
 {
   _clauseCodeTree=false;
@@ -56,8 +56,9 @@ public:
   
   struct TermInfo
   {
-    TermInfo(TermList t, Literal* lit, Clause* cls)
-    : t(t), lit(lit), cls(cls) {}
+    TermInfo(TermList t, Literal* lit, Clause* cls, InstanceOrderingCheck* check=0)
+    : t(t), lit(lit), cls(cls), check(check) {}
+    ~TermInfo();
 
     inline bool operator==(const TermInfo& o)
     { return cls==o.cls && t==o.t && lit==o.lit; }
@@ -71,6 +72,8 @@ public:
     TermList t;
     Literal* lit;
     Clause* cls;
+    /** The ordering check for instances of the term, owned by the object */
+    InstanceOrderingCheck* check;
   };
 
 
@@ -158,13 +158,22 @@ void DemodulationLHSIndex::handleClause(Clause* c, bool adding)
   TimeCounter tc(Lib::TimeCounterUnit::TC_FORWARD_DEMODULATION_INDEX_MAINTENANCE);
 
   Literal* lit=(*c)[0];
+  // the sides of an unorientable equation are compared for each rewrite
+  bool unorientable=lit->isEquality() && _ord.getEqualityArgumentOrder(lit)==Ordering::Result::INCOMPARABLE;
   TermIterator lhsi=EqHelper::getDemodulationLHSIterator(lit, true, _ord, _opt);
   while (lhsi.hasNext()) {
-    if (adding) {
-      _is->insert(lhsi.next(), lit, c);
+    TermList lhs=lhsi.next();
+    if (!adding) {
+      _is->remove(lhs, lit, c);
+    }
+    else if (unorientable) {
+      TermList rhs=EqHelper::getOtherEqualitySide(lit, lhs);
+      _is->insert(lhs, lit, c, _ord.compileInstanceCheck(lhs, rhs));
+      _version++;
     }
     else {
-      _is->remove(lhsi.next(), lit, c);
+      _is->insert(lhs, lit, c);
+      _version++;
     }
   }
 }
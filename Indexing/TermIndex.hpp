@@ -111,12 +111,20 @@ public:
   USE_ALLOCATOR(DemodulationLHSIndex);
 
   DemodulationLHSIndex(TermIndexingStructure* is, Ordering& ord, const Options& opt)
-  : TermIndex(is), _ord(ord), _opt(opt) {};
+  : TermIndex(is), _ord(ord), _opt(opt), _version(0) {};
+
+  /**
+   * Number of times demodulators were added to the index. Removing
+   * demodulators does not change it, as a term that no demodulator
+   * rewrites stays so when demodulators are removed.
+   */
+  unsigned version() const { return _version; }
 protected:
   void handleClause(Clause* c, bool adding);
 private:
   Ordering& _ord;
   const Options& _opt;
+  unsigned _version;
 };
 
 };
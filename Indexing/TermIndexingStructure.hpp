@@ -25,6 +25,8 @@
 #ifndef __TermIndexingStructure__
 #define __TermIndexingStructure__
 
+#include "Kernel/Ordering.hpp"
+
 #include "Index.hpp"
 
 namespace Indexing {
@@ -36,6 +38,18 @@ public:
   virtual void insert(TermList t, Literal* lit, Clause* cls) = 0;
   virtual void remove(TermList t, Literal* lit, Clause* cls) = 0;
 
+  /**
+   * Insert @b t together with the ordering check @b check, which the
+   * structure then owns. Query results for @b t carry the check in
+   * TermQueryResult::orderingCheck, structures that cannot store it
+   * drop it.
+   */
+  virtual void insert(TermList t, Literal* lit, Clause* cls, InstanceOrderingCheck* check)
+  {
+    delete check;
+    insert(t, lit, cls);
+  }
+
   virtual TermQueryResultIterator getUnifications(TermList t,
 	  bool retrieveSubstitutions = true) { NOT_IMPLEMENTED; }
   virtual TermQueryResultIterator getUnificationsWithConstraints(TermList t,
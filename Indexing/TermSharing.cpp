@@ -60,11 +60,11 @@ TermSharing::~TermSharing()
   CALL("TermSharing::~TermSharing");
 
 #if CHECK_LEAKS
-  Set<Term*,TermSharing>::Iterator ts(_terms);
+  TermSet::Iterator ts(_terms);
   while (ts.hasNext()) {
     ts.next()->destroy();
   }
-  Set<Literal*,TermSharing>::Iterator ls(_literals);
+  LiteralSet::Iterator ls(_literals);
   while (ls.hasNext()) {
     ls.next()->destroy();
   }
@@ -82,7 +82,10 @@ Term* TermSharing::insert(Term* t)
   ASS(!t->isLiteral());
   ASS(!t->isSpecial());
 
+#if !CONCURRENT_TERM_SHARING
+  // time counters are not thread-safe
   TimeCounter tc(Lib::TimeCounterUnit::TC_TERM_SHARING);
+#endif
 
   // normalise commutative terms
   if (t->commutative()) {
@@ -96,56 +99,25 @@ Term* TermSharing::insert(Term* t)
   }
 
   _termInsertions++;
+#if CONCURRENT_TERM_SHARING
+  // other threads may find the term as soon as it is in the set, so it
+  // gets its id before, and the id is given back if the term was there
+  setSharedData(t);
   Term* s = _terms.insert(t);
-   if (s == t) {
-    unsigned weight = 1;
-    unsigned vars = 0;
-    bool hasInterpretedConstants=t->arity()==0 &&
-	env.signature->getFunction(t->functor())->interpreted();
-    Color color = Color::COLOR_TRANSPARENT;
-    for (TermList* tt = t->args(); ! tt->isEmpty(); tt = tt->next()) {
-      if (tt->isVar()) {
-          ASS(tt->isOrdinaryVar());
-          vars++;
-          weight += 1;
-      }
-      else 
-      {
-          ASS_REP(tt->term()->shared(), tt->term()->toString());
-          
-          Term* r = tt->term();
-    
-          vars += r->vars();
-          weight += r->weight();
-          if (env.colorUsed) {
-              color = static_cast<Color>((unsigned)color | (unsigned)r->color());
-          }
-          if(!hasInterpretedConstants && r->hasInterpretedConstants()) {
-              hasInterpretedConstants=true; 
-          }
-      }
-    }
-    t->markShared();
-    t->setId(_totalTerms);
-    t->setVars(vars);
-    t->setWeight(weight);
-    if (env.colorUsed) {
-      Color fcolor = env.signature->getFunction(t->functor())->color();
-      color = static_cast<Color>((unsigned)color | (unsigned)fcolor);
-      t->setColor(color);
-    }
-      
-    t->setInterpretedConstantsPresence(hasInterpretedConstants);
-    _totalTerms++;
-     
-    ASS_REP(SortHelper::areImmediateSortsValid(t), t->toString());
-    if (!SortHelper::areImmediateSortsValid(t)){
-      USER_ERROR("Immediate (shared) subterms of  term/literal "+t->toString()+" have different types/not well-typed!");
-    }
+  if (s != t) {
+    releaseId(_totalTerms, t->getId());
+    t->_args[0]._info.shared = 0u;
+    t->destroy();
+  }
+#else
+  Term* s = _terms.insert(t);
+  if (s == t) {
+    setSharedData(t);
   }
   else {
     t->destroy();
   }
+#endif
   return s;
 } // TermSharing::insert
 
@@ -166,7 +138,9 @@ Literal* TermSharing::insert(Literal* t)
   //equalities between variables must be inserted using insertVariableEquality() function
   ASS_REP(!t->isEquality() || !t->nthArgument(0)->isVar() || !t->nthArgument(1)->isVar(), t->toString());
 
+#if !CONCURRENT_TERM_SHARING
   TimeCounter tc(Lib::TimeCounterUnit::TC_TERM_SHARING);
+#endif
 
   if (t->commutative()) {
     ASS(t->arity() == 2);
@@ -179,52 +153,23 @@ Literal* TermSharing::insert(Literal* t)
   }
 
   _literalInsertions++;
+#if CONCURRENT_TERM_SHARING
+  setSharedData(t);
+  Literal* s = _literals.insert(t);
+  if (s != t) {
+    releaseId(_totalLiterals, t->getId());
+    t->_args[0]._info.shared = 0u;
+    t->destroy();
+  }
+#else
   Literal* s = _literals.insert(t);
   if (s == t) {
-    unsigned weight = 1;
-    unsigned vars = 0;
-    Color color = Color::COLOR_TRANSPARENT;
-    bool hasInterpretedConstants=false;
-    for (TermList* tt = t->args(); ! tt->isEmpty(); tt = tt->next()) {
-      if (tt->isVar()) {
-	ASS(tt->isOrdinaryVar());
-	vars++;
-	weight += 1;
-      }
-      else {
-	ASS_REP(tt->term()->shared(), tt->term()->toString());
-	Term* r = tt->term();
-	vars += r->vars();
-	weight += r->weight();
-	if (env.colorUsed) {
-	  ASS(color == Color::COLOR_TRANSPARENT || r->color() == Color::COLOR_TRANSPARENT || color == r->color());
-	  color = static_cast<Color>((unsigned)color | (unsigned)r->color());
-	}
-	if(!hasInterpretedConstants && r->hasInterpretedConstants()) {
-	  hasInterpretedConstants=true;
-	}
-      }
-    }
-    t->markShared();
-    t->setId(_totalLiterals);
-    t->setVars(vars);
-    t->setWeight(weight);
-    if (env.colorUsed) {
-      Color fcolor = env.signature->getPredicate(t->functor())->color();
-      color = static_cast<Color>((unsigned)color | (unsigned)fcolor);
-      t->setColor(color);
-    }
-    t->setInterpretedConstantsPresence(hasInterpretedConstants);
-    _totalLiterals++;
-
-    ASS_REP(SortHelper::areImmediateSortsValid(t), t->toString());
-    if (!SortHelper::areImmediateSortsValid(t)){
-      USER_ERROR("Immediate (shared) subterms of  term/literal "+t->toString()+" have different types/not well-typed!");
-    }
+    setSharedData(t);
   }
   else {
     t->destroy();
   }
+#endif
   return s;
 } // TermSharing::insert
 
@@ -242,7 +187,9 @@ Literal* TermSharing::insertVariableEquality(Literal* t,unsigned sort)
   ASS(t->nthArgument(1)->isVar());
   ASS(!t->isSpecial());
 
+#if !CONCURRENT_TERM_SHARING
   TimeCounter tc(Lib::TimeCounterUnit::TC_TERM_SHARING);
+#endif
 
   TermList* ts1 = t->args();
   TermList* ts2 = ts1->next();
@@ -255,23 +202,153 @@ Literal* TermSharing::insertVariableEquality(Literal* t,unsigned sort)
   t->setTwoVarEqSort(sort);
 
   _literalInsertions++;
+#if CONCURRENT_TERM_SHARING
+  setVariableEqualityData(t);
+  Literal* s = _literals.insert(t);
+  if (s != t) {
+    releaseId(_totalLiterals, t->getId());
+    t->_args[0]._info.shared = 0u;
+    t->destroy();
+  }
+#else
   Literal* s = _literals.insert(t);
   if (s == t) {
-    t->markShared();
-    t->setId(_totalLiterals);
-    t->setWeight(3);
-    if (env.colorUsed) {
-      t->setColor(Color::COLOR_TRANSPARENT);
-    }
-    t->setInterpretedConstantsPresence(false);
-    _totalLiterals++;
+    setVariableEqualityData(t);
   }
   else {
     t->destroy();
   }
+#endif
   return s;
 } // TermSharing::insertVariableEquality
 
+#if CONCURRENT_TERM_SHARING
+/**
+ * Give back the @b id taken from @b counter by a term or literal that
+ * another thread inserted first. The id is given back only if no other
+ * id was taken since, so the ids stay unique.
+ */
+void TermSharing::releaseId(Counter& counter, unsigned id)
+{
+  unsigned next = id+1;
+  counter.compare_exchange_strong(next, id, std::memory_order_relaxed);
+}
+#endif
+
+/**
+ * Compute the weight, variable count, colour and id of term @b t,
+ * whose arguments are all shared, and mark it as shared.
+ */
+void TermSharing::setSharedData(Term* t)
+{
+  CALL("TermSharing::setSharedData(Term*)");
+
+  unsigned weight = 1;
+  unsigned vars = 0;
+  bool hasInterpretedConstants=t->arity()==0 &&
+      env.signature->getFunction(t->functor())->interpreted();
+  Color color = Color::COLOR_TRANSPARENT;
+  for (TermList* tt = t->args(); ! tt->isEmpty(); tt = tt->next()) {
+    if (tt->isVar()) {
+      ASS(tt->isOrdinaryVar());
+      vars++;
+      weight += 1;
+    }
+    else {
+      ASS_REP(tt->term()->shared(), tt->term()->toString());
+      Term* r = tt->term();
+      vars += r->vars();
+      weight += r->weight();
+      if (env.colorUsed) {
+        color = static_cast<Color>((unsigned)color | (unsigned)r->color());
+      }
+      if(!hasInterpretedConstants && r->hasInterpretedConstants()) {
+        hasInterpretedConstants=true;
+      }
+    }
+  }
+  t->markShared();
+  t->setId(_totalTerms++);
+  t->setVars(vars);
+  t->setWeight(weight);
+  if (env.colorUsed) {
+    Color fcolor = env.signature->getFunction(t->functor())->color();
+    color = static_cast<Color>((unsigned)color | (unsigned)fcolor);
+    t->setColor(color);
+  }
+  t->setInterpretedConstantsPresence(hasInterpretedConstants);
+
+  ASS_REP(SortHelper::areImmediateSortsValid(t), t->toString());
+  if (!SortHelper::areImmediateSortsValid(t)){
+    USER_ERROR("Immediate (shared) subterms of  term/literal "+t->toString()+" have different types/not well-typed!");
+  }
+}
+
+/**
+ * Compute the weight, variable count, colour and id of literal @b t,
+ * whose arguments are all shared, and mark it as shared.
+ */
+void TermSharing::setSharedData(Literal* t)
+{
+  CALL("TermSharing::setSharedData(Literal*)");
+
+  unsigned weight = 1;
+  unsigned vars = 0;
+  Color color = Color::COLOR_TRANSPARENT;
+  bool hasInterpretedConstants=false;
+  for (TermList* tt = t->args(); ! tt->isEmpty(); tt = tt->next()) {
+    if (tt->isVar()) {
+      ASS(tt->isOrdinaryVar());
+      vars++;
+      weight += 1;
+    }
+    else {
+      ASS_REP(tt->term()->shared(), tt->term()->toString());
+      Term* r = tt->term();
+      vars += r->vars();
+      weight += r->weight();
+      if (env.colorUsed) {
+        ASS(color == Color::COLOR_TRANSPARENT || r->color() == Color::COLOR_TRANSPARENT || color == r->color());
+        color = static_cast<Color>((unsigned)color | (unsigned)r->color());
+      }
+      if(!hasInterpretedConstants && r->hasInterpretedConstants()) {
+        hasInterpretedConstants=true;
+      }
+    }
+  }
+  t->markShared();
+  t->setId(_totalLiterals++);
+  t->setVars(vars);
+  t->setWeight(weight);
+  if (env.colorUsed) {
+    Color fcolor = env.signature->getPredicate(t->functor())->color();
+    color = static_cast<Color>((unsigned)color | (unsigned)fcolor);
+    t->setColor(color);
+  }
+  t->setInterpretedConstantsPresence(hasInterpretedConstants);
+
+  ASS_REP(SortHelper::areImmediateSortsValid(t), t->toString());
+  if (!SortHelper::areImmediateSortsValid(t)){
+    USER_ERROR("Immediate (shared) subterms of  term/literal "+t->toString()+" have different types/not well-typed!");
+  }
+}
+
+/**
+ * Set the shared data of an equality between two variables
+ */
+void TermSharing::setVariableEqualityData(Literal* t)
+{
+  CALL("TermSharing::setVariableEqualityData");
+
+  t->markShared();
+  t->setId(_totalLiterals++);
+  t->setWeight(3);
+  if (env.colorUsed) {
+    t->setColor(Color::COLOR_TRANSPARENT);
+  }
+  t->setInterpretedConstantsPresence(false);
+}
+
 /**
  * Insert a new term and all its unshared subterms
  * in the index, and return the result.
@@ -26,11 +26,36 @@
 #ifndef __TermSharing__
 #define __TermSharing__
 
+/**
+ * When set to 1, the shared terms and literals are stored in ConcurrentSet
+ * objects, so that they can be inserted by several threads at the same time.
+ *
+ * The terms themselves are allocated by the inserting threads, so this
+ * needs THREAD_SAFE_ALLOCATION. Debug builds are not supported, as the
+ * tracer behind CALL keeps one global stack.
+ */
+#ifndef CONCURRENT_TERM_SHARING
+#define CONCURRENT_TERM_SHARING 0
+#endif
+
+#if CONCURRENT_TERM_SHARING
+#include <atomic>
+
+#include "Lib/ConcurrentSet.hpp"
+#else
 #include "Lib/Set.hpp"
+#endif
 #include "Kernel/Term.hpp"
 
 #include "Lib/Allocator.hpp"
 
+#if CONCURRENT_TERM_SHARING && !THREAD_SAFE_ALLOCATION
+#error "CONCURRENT_TERM_SHARING requires THREAD_SAFE_ALLOCATION"
+#endif
+#if CONCURRENT_TERM_SHARING && VDEBUG
+#error "CONCURRENT_TERM_SHARING cannot be used in debug builds"
+#endif
+
 using namespace Lib;
 using namespace Kernel;
 
@@ -76,22 +101,38 @@ public:
 private:
   bool argNormGt(TermList t1, TermList t2);
 
+  void setSharedData(Term* t);
+  void setSharedData(Literal* l);
+  void setVariableEqualityData(Literal* l);
+
+#if CONCURRENT_TERM_SHARING
+  typedef ConcurrentSet<Term*,TermSharing> TermSet;
+  typedef ConcurrentSet<Literal*,TermSharing> LiteralSet;
+  typedef std::atomic<unsigned> Counter;
+
+  static void releaseId(Counter& counter, unsigned id);
+#else
+  typedef Set<Term*,TermSharing> TermSet;
+  typedef Set<Literal*,TermSharing> LiteralSet;
+  typedef unsigned Counter;
+#endif
+
   /** The set storing all terms */
-  Set<Term*,TermSharing> _terms;
+  TermSet _terms;
   /** The set storing all literals */
-  Set<Literal*,TermSharing> _literals;
-  /** Number of terms stored */
-  unsigned _totalTerms;
+  LiteralSet _literals;
+  /** Id of the next term, the number of terms stored unless some ids were lost to concurrent insertions */
+  Counter _totalTerms;
   /** Number of ground terms stored */
   // unsigned _groundTerms; // MS: unused
-  /** Number of literals stored */
-  unsigned _totalLiterals;
+  /** Id of the next literal, the number of literals stored unless some ids were lost to concurrent insertions */
+  Counter _totalLiterals;
   /** Number of ground literals stored */
   // unsigned _groundLiterals; // MS: unused
   /** Number of literal insertions */
-  unsigned _literalInsertions;
+  Counter _literalInsertions;
   /** Number of term insertions */
-  unsigned _termInsertions;
+  Counter _termInsertions;
 }; // class TermSharing
 
 } // namespace Indexing
@@ -106,6 +106,12 @@ struct BackwardDemodulation::ResultFn
     _eqLit=(*_cl)[0];
     _eqSort = SortHelper::getEqualityArgumentSort(_eqLit);
     _removed=SmartPtr<ClauseSet>(new ClauseSet());
+    if(_ordering.getEqualityArgumentOrder(_eqLit)==Ordering::Result::INCOMPARABLE) {
+      TermList t0=*_eqLit->nthArgument(0);
+      TermList t1=*_eqLit->nthArgument(1);
+      _orderingChecks[0]=SmartPtr<InstanceOrderingCheck>(_ordering.compileInstanceCheck(t0,t1));
+      _orderingChecks[1]=SmartPtr<InstanceOrderingCheck>(_ordering.compileInstanceCheck(t1,t0));
+    }
   }
   DECL_RETURN_TYPE(BwSimplificationRecord);
   /**
@@ -159,7 +165,10 @@ struct BackwardDemodulation::ResultFn
       rhsS=qr.substitution->applyToBoundQuery(rhs);
     }
 
-    if(_ordering.compare(lhsS,rhsS)!= Ordering::Result::GREATER) {
+    InstanceOrderingCheck* check=_orderingChecks[lhs==*_eqLit->nthArgument(0) ? 0 : 1].ptr();
+    bool greater=check ? check->isGreater(lhsS,rhsS)
+	: _ordering.compare(lhsS,rhsS)==Ordering::Result::GREATER;
+    if(!greater) {
       return BwSimplificationRecord(0);
     }
 
@@ -225,6 +234,11 @@ private:
   Literal* _eqLit;
   Clause* _cl;
   SmartPtr<ClauseSet> _removed;
+  /**
+   * Checks for instances of the sides of an unorientable _eqLit, the
+   * first one with the argument 0 as the left-hand side
+   */
+  SmartPtr<InstanceOrderingCheck> _orderingChecks[2];
 
   BackwardDemodulation& _parent;
   Ordering& _ordering;
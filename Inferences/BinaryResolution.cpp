@@ -188,11 +188,10 @@ Clause* BinaryResolution::generateClause(Clause* queryCl, Literal* queryLit, SLQ
     }
   }
 
-  unsigned conlength = withConstraints ? constraints->size() : 0;
-  unsigned newLength = clength+dlength-2+conlength;
-
-  inf_destroyer.disable(); // ownership passed to the the clause below
-  Clause* res = new(newLength) Clause(newLength, inf); // the inference object owned by res from now on
+  // the literals are collected first and the clause is only allocated
+  // when none of the checks below discards it
+  static LiteralStack resLits;
+  resLits.reset();
 
   Literal* queryLitAfter = 0;
   if (ord && queryCl->numSelected() > 1) {
@@ -213,7 +212,6 @@ Clause* BinaryResolution::generateClause(Clause* queryCl, Literal* queryLit, SLQ
   //}
 #endif
 
-  unsigned next = 0;
   if(withConstraints){
   for(unsigned i=0;i<constraints->size();i++){
       pair<TermList,TermList> con = (*constraints)[i]; 
@@ -235,12 +233,11 @@ Clause* BinaryResolution::generateClause(Clause* queryCl, Literal* queryLit, SLQ
          (!theory->isInterpretedFunction(rT) && !theory->isInterpretedConstant(rT))){
 
         // the unification was between two uninterpreted things that were not ground 
-        res->destroy();
+        env.statistics->childrenDiscardedBeforeAllocation++;
         return 0;
       } 
 
-      (*res)[next] = constraint; 
-      next++;    
+      resLits.push(constraint);
   }
   }
   for(unsigned i=0;i<clength;i++) {
@@ -249,10 +246,10 @@ Clause* BinaryResolution::generateClause(Clause* queryCl, Literal* queryLit, SLQ
       Literal* newLit=qr.substitution->applyToQuery(curr);
       if(needsToFulfilWeightLimit) {
         wlb+=newLit->weight() - curr->weight();
-        if(!passiveClauseContainer->fulfilsWeightLimit(wlb, numPositiveLiteralsLowerBound, res->inference())) {
+        if(!passiveClauseContainer->fulfilsWeightLimit(wlb, numPositiveLiteralsLowerBound, inf)) {
           RSTAT_CTR_INC("binary resolutions skipped for weight limit while building clause");
           env.statistics->discardedNonRedundantClauses++;
-          res->destroy();
+          env.statistics->childrenDiscardedBeforeAllocation++;
           return 0;
         }
       }
@@ -265,13 +262,11 @@ Clause* BinaryResolution::generateClause(Clause* queryCl, Literal* queryLit, SLQ
             (ls->isPositiveForSelection(newLit)    // strict maximimality for positive literals
                 && (o == Ordering::Result::GREATER_EQ || o == Ordering::Result::EQUAL))) { // where is GREATER_EQ ever coming from?
           env.statistics->inferencesBlockedForOrderingAftercheck++;
-          res->destroy();
+          env.statistics->childrenDiscardedBeforeAllocation++;
           return 0;
         }
       }
-      ASS(next < newLength);
-      (*res)[next] = newLit;
-      next++;
+      resLits.push(newLit);
     }
   }
 
@@ -287,10 +282,10 @@ Clause* BinaryResolution::generateClause(Clause* queryCl, Literal* queryLit, SLQ
       Literal* newLit = qr.substitution->applyToResult(curr);
       if(needsToFulfilWeightLimit) {
         wlb+=newLit->weight() - curr->weight();
-        if(!passiveClauseContainer->fulfilsWeightLimit(wlb, numPositiveLiteralsLowerBound, res->inference())) {
+        if(!passiveClauseContainer->fulfilsWeightLimit(wlb, numPositiveLiteralsLowerBound, inf)) {
           RSTAT_CTR_INC("binary resolutions skipped for weight limit while building clause");
           env.statistics->discardedNonRedundantClauses++;
-          res->destroy();
+          env.statistics->childrenDiscardedBeforeAllocation++;
           return 0;
         }
       }
@@ -303,16 +298,20 @@ Clause* BinaryResolution::generateClause(Clause* queryCl, Literal* queryLit, SLQ
             (ls->isPositiveForSelection(newLit)   // strict maximimality for positive literals
                 && (o == Ordering::Result::GREATER_EQ || o == Ordering::Result::EQUAL))) { // where is GREATER_EQ ever coming from?
           env.statistics->inferencesBlockedForOrderingAftercheck++;
-          res->destroy();
+          env.statistics->childrenDiscardedBeforeAllocation++;
           return 0;
         }
       }
 
-      (*res)[next] = newLit;
-      next++;
+      resLits.push(newLit);
     }
   }
 
+  ASS_EQ(resLits.size(), clength+dlength-2+(withConstraints ? constraints->size() : 0));
+
+  inf_destroyer.disable(); // ownership passed to the the clause below
+  Clause* res = Clause::fromStack(resLits, inf); // the inference object owned by res from now on
+
   if(withConstraints){
     env.statistics->cResolution++;
   }
@@ -67,6 +67,9 @@ void ForwardDemodulation::attach(SaturationAlgorithm* salg)
 	  _salg->getIndexManager()->request(Indexing::IndexType::DEMODULATION_LHS_SUBST_TREE) );
 
   _preorderedOnly=getOptions().forwardDemodulation()==Options::Demodulation::PREORDERED;
+  _useNormalFormCache=getOptions().forwardDemodulationCache();
+  _irreducible.reset();
+  _irreducibleVersion=_index->version();
 }
 
 void ForwardDemodulation::detach()
@@ -90,6 +93,12 @@ bool ForwardDemodulation::perform(Clause* cl, Clause*& replacement, ClauseIterat
   //replace subterms in some special order, like
   //the heaviest first...
 
+  if(_useNormalFormCache && _irreducibleVersion!=_index->version()) {
+    // the new demodulators may rewrite the remembered terms
+    _irreducible.reset();
+    _irreducibleVersion=_index->version();
+  }
+
   static DHSet<TermList> attempted;
   attempted.reset();
 
@@ -107,6 +116,19 @@ bool ForwardDemodulation::perform(Clause* cl, Clause*& replacement, ClauseIterat
 	nvi.right();
 	continue;
       }
+      if(_useNormalFormCache) {
+	bool* normalForm=_irreducible.findPtr(trm.term());
+	if(normalForm) {
+	  env.statistics->forwardDemodulationCacheHits++;
+	  if(*normalForm) {
+	    nvi.right();
+	  }
+	  continue;
+	}
+	env.statistics->forwardDemodulationCacheMisses++;
+      }
+      //true if a demodulator was not used only because of the clause @b cl
+      bool contextDependent=false;
 
       unsigned querySort = SortHelper::getTermSort(trm, lit);
 
@@ -119,6 +141,7 @@ bool ForwardDemodulation::perform(Clause* cl, Clause*& replacement, ClauseIterat
 	ASS_EQ(qr.clause->length(),1);
 
 	if(!ColorHelper::compatible(cl->color(), qr.clause->color())) {
+	  contextDependent=true;
 	  continue;
 	}
 
@@ -158,8 +181,15 @@ bool ForwardDemodulation::perform(Clause* cl, Clause*& replacement, ClauseIterat
 	  }
 	}
 #endif
-	if(!preordered && (_preorderedOnly || ordering.compare(trm,rhsS)!=Ordering::Result::GREATER) ) {
-	  continue;
+	if(!preordered) {
+	  if(_preorderedOnly) {
+	    continue;
+	  }
+	  bool greater=qr.orderingCheck ? qr.orderingCheck->isGreater(trm,rhsS)
+	      : ordering.compare(trm,rhsS)==Ordering::Result::GREATER;
+	  if(!greater) {
+	    continue;
+	  }
 	}
 
 	if(toplevelCheck) {
@@ -184,6 +214,7 @@ bool ForwardDemodulation::perform(Clause* cl, Clause*& replacement, ClauseIterat
 	      //---------------------
 	      //     t = t1 \/ C
 	      //where t > t1 and s = t > C
+	      contextDependent=true;
 	      continue;
 	    }
 	  }
@@ -217,10 +248,52 @@ bool ForwardDemodulation::perform(Clause* cl, Clause*& replacement, ClauseIterat
 	return true;
 
       }
+      if(_useNormalFormCache && !contextDependent && trm.term()->shared()) {
+	_irreducible.insert(trm.term(), false);
+      }
     }
   }
 
+  if(_useNormalFormCache) {
+    for(unsigned li=0;li<cLen;li++) {
+      Literal* lit=(*cl)[li];
+      for(TermList* arg=lit->args(); !arg->isEmpty(); arg=arg->next()) {
+	recordNormalForms(*arg);
+      }
+    }
+  }
   return false;
 }
 
+/**
+ * Mark the subterms of @b t that are in normal form in _irreducible and
+ * return true if @b t is in normal form. To be called when perform()
+ * found that no subterm of a clause containing @b t can be rewritten,
+ * so that all subterms that can be rewritten in no clause are in
+ * _irreducible.
+ */
+bool ForwardDemodulation::recordNormalForms(TermList t)
+{
+  CALL("ForwardDemodulation::recordNormalForms");
+
+  if(t.isVar()) {
+    return true;
+  }
+  bool* normalForm=_irreducible.findPtr(t.term());
+  if(normalForm && *normalForm) {
+    return true;
+  }
+  bool normal=normalForm!=0;
+  for(TermList* arg=t.term()->args(); !arg->isEmpty(); arg=arg->next()) {
+    if(!recordNormalForms(*arg)) {
+      normal=false;
+    }
+  }
+  if(normal) {
+    // the pointer is still valid, nothing was inserted into the map
+    *normalForm=true;
+  }
+  return normal;
+}
+
 }
@@ -26,6 +26,7 @@
 #define __ForwardDemodulation__
 
 #include "Forwards.hpp"
+#include "Lib/DHMap.hpp"
 #include "Indexing/TermIndex.hpp"
 
 #include "InferenceEngine.hpp"
@@ -37,6 +38,17 @@ using namespace Kernel;
 using namespace Indexing;
 using namespace Saturation;
 
+/**
+ * Rewriting of clauses by the unit equalities in DemodulationLHSIndex.
+ *
+ * Each call to perform() rewrites at most one subterm, and the clause
+ * is then simplified again from its first subterm. When the option
+ * forward_demodulation_cache is on, the shared terms that no demodulator
+ * rewrites are remembered until new demodulators are added to the index.
+ * They are not looked up in the index again, neither in the next round
+ * nor in other clauses, and the subterms of terms in normal form are
+ * skipped altogether.
+ */
 class ForwardDemodulation
 : public ForwardSimplificationEngine
 {
@@ -48,8 +60,19 @@ public:
   void detach() override;
   bool perform(Clause* cl, Clause*& replacement, ClauseIterator& premises) override;
 private:
+  bool recordNormalForms(TermList t);
+
   bool _preorderedOnly;
   DemodulationLHSIndex* _index;
+
+  /** True if the terms in normal form are remembered */
+  bool _useNormalFormCache;
+  /**
+   * Shared terms that no demodulator of the index version _irreducibleVersion
+   * rewrites at the top. They are mapped to true if they are in normal form.
+   */
+  DHMap<Term*,bool> _irreducible;
+  unsigned _irreducibleVersion;
 };
 
 };
@@ -296,6 +296,17 @@ bool ForwardSubsumptionAndResolution::perform(Clause* cl, Clause*& replacement,
       unsigned mlen=mcl->length();
       ASS_G(mlen,1);
 
+      bool maySubsume=mcl->maySubsume(cl);
+      if(!maySubsume) {
+	env.statistics->forwardSubsumptionSignatureRejections++;
+	if(!_subsumptionResolution || !mcl->maySubsumeResolve(cl)) {
+	  //the clause can be used neither for subsumption nor for
+	  //subsumption resolution, so no matches are needed
+	  mcl->setAux(0);
+	  continue;
+	}
+      }
+
       ClauseMatches* cms=new ClauseMatches(mcl);
       mcl->setAux(cms);
       cmStore.push(cms);
@@ -303,7 +314,8 @@ bool ForwardSubsumptionAndResolution::perform(Clause* cl, Clause*& replacement,
       //      cms->fillInMatches(&miniIndex, res.literal, (*cl)[li]);
       cms->fillInMatches(&miniIndex);
 
-      if(cms->anyNonMatched()) {
+      if(!maySubsume || cms->anyNonMatched()) {
+	//the matches are kept for subsumption resolution
 	continue;
       }
 
@@ -370,6 +382,10 @@ bool ForwardSubsumptionAndResolution::perform(Clause* cl, Clause*& replacement,
 	  //we have already examined this clause
 	  continue;
 	}
+	if(!mcl->maySubsumeResolve(cl)) {
+	  mcl->setAux(0);
+	  continue;
+	}
 
 	ClauseMatches* cms=new ClauseMatches(mcl);
 	res.clause->setAux(cms);
@@ -38,6 +38,7 @@
 #include "Kernel/Term.hpp"
 #include "Kernel/ColorHelper.hpp"
 
+#include "Indexing/FeatureVectorIndex.hpp"
 #include "Indexing/Index.hpp"
 #include "Indexing/LiteralIndex.hpp"
 #include "Indexing/IndexManager.hpp"
@@ -68,6 +69,10 @@ void SLQueryBackwardSubsumption::attach(SaturationAlgorithm* salg)
   BackwardSimplificationEngine::attach(salg);
   _index=static_cast<SimplifyingLiteralIndex*>(
 	  _salg->getIndexManager()->request(Indexing::IndexType::SIMPLIFYING_SUBST_TREE) );
+  if(!_byUnitsOnly && _salg->getOptions().featureVectorSubsumption()) {
+    _fvIndex=static_cast<FeatureVectorIndex*>(
+	    _salg->getIndexManager()->request(Indexing::IndexType::BW_SUBSUMPTION_FEATURE_VECTOR_INDEX) );
+  }
 }
 
 void SLQueryBackwardSubsumption::detach()
@@ -75,6 +80,10 @@ void SLQueryBackwardSubsumption::detach()
   CALL("SLQueryBackwardSubsumption::detach");
   _index=0;
   _salg->getIndexManager()->release(Indexing::IndexType::SIMPLIFYING_SUBST_TREE);
+  if(_fvIndex) {
+    _fvIndex=0;
+    _salg->getIndexManager()->release(Indexing::IndexType::BW_SUBSUMPTION_FEATURE_VECTOR_INDEX);
+  }
   BackwardSimplificationEngine::detach();
 }
 
@@ -144,6 +153,16 @@ void SLQueryBackwardSubsumption::perform(Clause* cl,
     return;
   }
 
+  if(_fvIndex) {
+    ClauseList* subsumed=getSubsumedByFeatureVectors(cl);
+    if(subsumed) {
+      simplifications=getPersistentIterator(
+	      getMappingIterator(ClauseList::Iterator(subsumed), ClauseToBwSimplRecordFn()));
+      ClauseList::destroy(subsumed);
+    }
+    return;
+  }
+
   unsigned lmIndex=0; //least matchable literal index
   unsigned lmVal=(*cl)[0]->weight();
   for(unsigned i=1;i<clen;i++) {
@@ -181,6 +200,10 @@ void SLQueryBackwardSubsumption::perform(Clause* cl,
     if(!checkedClauses.insert(icl)) {
       continue;
     }
+    if(!cl->maySubsume(icl)) {
+      env.statistics->backwardSubsumptionSignatureRejections++;
+      continue;
+    }
 
     RSTAT_CTR_INC("bs1 0 candidates");
 
@@ -293,4 +316,70 @@ void SLQueryBackwardSubsumption::perform(Clause* cl,
   return;
 }
 
+/**
+ * Return the list of clauses subsumed by the non-unit clause @b cl,
+ * taking the candidates from the feature vector index.
+ *
+ * The index leaves out the clauses that have more literals of some
+ * polarity and predicate bucket, or more or deeper occurrences of
+ * some bucket of function symbols than @b cl. Of the remaining ones,
+ * those in which some literal of @b cl has no instance are left out
+ * before MLMatcher is asked.
+ */
+ClauseList* SLQueryBackwardSubsumption::getSubsumedByFeatureVectors(Clause* cl)
+{
+  CALL("SLQueryBackwardSubsumption::getSubsumedByFeatureVectors");
+  ASS(_fvIndex);
+
+  unsigned clen=cl->length();
+  ASS_G(clen,1);
+
+  static DArray<LiteralList*> matchedLits(32);
+  matchedLits.init(clen, 0);
+
+  ClauseList* subsumed=0;
+
+  ClauseIterator cit=_fvIndex->getSubsumptionCandidates(cl);
+  while(cit.hasNext()) {
+    Clause* icl=cit.next();
+    if(icl==cl) {
+      continue;
+    }
+    RSTAT_CTR_INC("bs2 0 candidates");
+    if(!cl->maySubsume(icl)) {
+      env.statistics->backwardSubsumptionSignatureRejections++;
+      continue;
+    }
+
+    unsigned ilen=icl->length();
+    ASS_GE(ilen,clen);
+    for(unsigned bi=0;bi<clen;bi++) {
+      Literal* blit=(*cl)[bi];
+      for(unsigned ii=0;ii<ilen;ii++) {
+	Literal* ilit=(*icl)[ii];
+	if(ilit->header()==blit->header() && MatchingUtils::match(blit,ilit,false)) {
+	  LiteralList::push(ilit, matchedLits[bi]);
+	}
+      }
+      if(!matchedLits[bi]) {
+	goto match_fail;
+      }
+    }
+
+    RSTAT_CTR_INC("bs2 1 final check");
+    if(MLMatcher::canBeMatched(cl,icl,matchedLits.array(),0)) {
+      ClauseList::push(icl, subsumed);
+      env.statistics->backwardSubsumed++;
+      RSTAT_CTR_INC("bs2 2 performed");
+    }
+
+  match_fail:
+    for(unsigned bi=0; bi<clen; bi++) {
+      LiteralList::destroy(matchedLits[bi]);
+      matchedLits[bi]=0;
+    }
+  }
+  return subsumed;
+}
+
 }
@@ -420,7 +420,6 @@ Clause* Superposition::performSuperposition(
 
   unsigned rwLength = rwClause->length();
   unsigned eqLength = eqClause->length();
-  unsigned conLength = hasConstraints ? constraints->size() : 0;
 
   TermList tgtTerm = EqHelper::getOtherEqualitySide(eqLit, eqLHS);
 
@@ -487,54 +486,14 @@ Clause* Superposition::performSuperposition(
     return 0;
   }
 
-  unsigned newLength = rwLength+eqLength-1+conLength;
-
   static bool afterCheck = getOptions().literalMaximalityAftercheck() && _salg->getLiteralSelector().isBGComplete();
 
-  inf_destroyer.disable(); // ownership passed to the the clause below
-  Clause* res = new(newLength) Clause(newLength, inf);
-
-  // If proof extra is on let's compute the positions we have performed
-  // superposition on 
-  if(env.options->proofExtra()==Options::ProofExtra::FULL){
-    /*
-    cout << "rwClause " << rwClause->toString() << endl;
-    cout << "eqClause " << eqClause->toString() << endl;
-    cout << "rwLit " << rwLit->toString() << endl;
-    cout << "eqLit " << eqLit->toString() << endl;
-    cout << "rwTerm " << rwTerm.toString() << endl;
-    cout << "eqLHS " << eqLHS.toString() << endl;
-     */
-    //cout << subst->toString() << endl;
-
-    // First find which literal it is in the clause, as selection has occured already
-    // this should remain the same...?
-    vstring rwPlace = Lib::Int::toString(rwClause->getLiteralPosition(rwLit));
-    vstring eqPlace = Lib::Int::toString(eqClause->getLiteralPosition(eqLit));
-
-    vstring rwPos="_";
-    ALWAYS(Kernel::positionIn(rwTerm,rwLit,rwPos));
-    vstring eqPos = "("+eqPlace+").2";
-    rwPos = "("+rwPlace+")."+rwPos;
-
-    vstring eqClauseNum = Lib::Int::toString(eqClause->number());
-    vstring rwClauseNum = Lib::Int::toString(rwClause->number());
-
-    vstring extra = eqClauseNum + " into " + rwClauseNum+", unify on "+
-        eqPos+" in "+eqClauseNum+" and "+
-        rwPos+" in "+rwClauseNum;
+  // the literals are collected first and the clause is only allocated
+  // when none of the checks below discards it
+  static LiteralStack resLits;
+  resLits.reset();
 
-    //cout << extra << endl;
-    //NOT_IMPLEMENTED;
-
-    if (!env.proofExtra) {
-      env.proofExtra = new DHMap<void*,vstring>();
-    }
-    env.proofExtra->insert(res,extra);
-  }
-
-  (*res)[0] = tgtLitS;
-  int next = 1;
+  resLits.push(tgtLitS);
   unsigned weight=tgtLitS->weight();
   for(unsigned i=0;i<rwLength;i++) {
     Literal* curr=(*rwClause)[i];
@@ -551,7 +510,7 @@ Clause* Superposition::performSuperposition(
 
       if(needsToFulfilWeightLimit) {
         weight+=currAfter->weight();
-        if(!passiveClauseContainer->fulfilsWeightLimit(weight, numPositiveLiteralsLowerBound, res->inference())) {
+        if(!passiveClauseContainer->fulfilsWeightLimit(weight, numPositiveLiteralsLowerBound, inf)) {
           RSTAT_CTR_INC("superpositions skipped for weight limit while constructing other literals");
           env.statistics->discardedNonRedundantClauses++;
           goto construction_fail;
@@ -566,7 +525,7 @@ Clause* Superposition::performSuperposition(
         }
       }
 
-      (*res)[next++] = currAfter;
+      resLits.push(currAfter);
     }
   }
 
@@ -587,7 +546,7 @@ Clause* Superposition::performSuperposition(
         }
         if(needsToFulfilWeightLimit) {
           weight+=currAfter->weight();
-          if(!passiveClauseContainer->fulfilsWeightLimit(weight, numPositiveLiteralsLowerBound, res->inference())) {
+          if(!passiveClauseContainer->fulfilsWeightLimit(weight, numPositiveLiteralsLowerBound, inf)) {
             RSTAT_CTR_INC("superpositions skipped for weight limit while constructing other literals");
             env.statistics->discardedNonRedundantClauses++;
             goto construction_fail;
@@ -605,7 +564,7 @@ Clause* Superposition::performSuperposition(
           }
         }
 
-        (*res)[next++] = currAfter;
+        resLits.push(currAfter);
       }
     }
   }
@@ -626,22 +585,63 @@ Clause* Superposition::performSuperposition(
          (!theory->isInterpretedFunction(rT) && !theory->isInterpretedConstant(rT))){
 
         // the unification was between two uninterpreted things that were not ground 
-        res->destroy();
-        return 0;
+        goto construction_fail;
       }
 
-      (*res)[next] = constraint;
-      next++;   
+      resLits.push(constraint);
     }
   }
 
-  if(needsToFulfilWeightLimit && !passiveClauseContainer->fulfilsWeightLimit(weight, numPositiveLiteralsLowerBound, res->inference())) {
+  if(needsToFulfilWeightLimit && !passiveClauseContainer->fulfilsWeightLimit(weight, numPositiveLiteralsLowerBound, inf)) {
     RSTAT_CTR_INC("superpositions skipped for weight limit after the clause was built");
     env.statistics->discardedNonRedundantClauses++;
     construction_fail:
-    res->destroy();
+    env.statistics->childrenDiscardedBeforeAllocation++;
     return 0;
   }
+  ASS_EQ(resLits.size(), rwLength+eqLength-1+(hasConstraints ? constraints->size() : 0));
+
+  inf_destroyer.disable(); // ownership passed to the the clause below
+  Clause* res = Clause::fromStack(resLits, inf);
+
+  // If proof extra is on let's compute the positions we have performed
+  // superposition on 
+  if(env.options->proofExtra()==Options::ProofExtra::FULL){
+    /*
+    cout << "rwClause " << rwClause->toString() << endl;
+    cout << "eqClause " << eqClause->toString() << endl;
+    cout << "rwLit " << rwLit->toString() << endl;
+    cout << "eqLit " << eqLit->toString() << endl;
+    cout << "rwTerm " << rwTerm.toString() << endl;
+    cout << "eqLHS " << eqLHS.toString() << endl;
+     */
+    //cout << subst->toString() << endl;
+
+    // First find which literal it is in the clause, as selection has occured already
+    // this should remain the same...?
+    vstring rwPlace = Lib::Int::toString(rwClause->getLiteralPosition(rwLit));
+    vstring eqPlace = Lib::Int::toString(eqClause->getLiteralPosition(eqLit));
+
+    vstring rwPos="_";
+    ALWAYS(Kernel::positionIn(rwTerm,rwLit,rwPos));
+    vstring eqPos = "("+eqPlace+").2";
+    rwPos = "("+rwPlace+")."+rwPos;
+
+    vstring eqClauseNum = Lib::Int::toString(eqClause->number());
+    vstring rwClauseNum = Lib::Int::toString(rwClause->number());
+
+    vstring extra = eqClauseNum + " into " + rwClauseNum+", unify on "+
+        eqPos+" in "+eqClauseNum+" and "+
+        rwPos+" in "+rwClauseNum;
+
+    //cout << extra << endl;
+    //NOT_IMPLEMENTED;
+
+    if (!env.proofExtra) {
+      env.proofExtra = new DHMap<void*,vstring>();
+    }
+    env.proofExtra->insert(res,extra);
+  }
 
   if(!hasConstraints){
     if(rwClause==eqClause) {
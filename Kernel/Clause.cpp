@@ -77,6 +77,7 @@ Clause::Clause(unsigned length,const Inference& inf)
     _numSelected(0),
     _weight(0),
     _weightForClauseSelection(0),
+    _signature(0),
     _refCnt(0),
     _reductionTimestamp(0),
     _literalPositions(0),
@@ -510,6 +511,47 @@ unsigned Clause::computeWeight() const
   return result;
 } // Clause::computeWeight
 
+/**
+ * Compute the signature of the clause.
+ *
+ * The lower 32 bits are for the headers of the literals, so that
+ * the literals of the same predicate symbol and opposite polarities
+ * have neighbouring bits, the upper 32 bits are for function symbols.
+ */
+unsigned long long Clause::computeSignature() const
+{
+  CALL("Clause::computeSignature");
+
+  unsigned long long result = 0;
+  for (int i = _length-1; i >= 0; i--) {
+    Literal* lit = _literals[i];
+    result |= 1ull << (lit->header()%32);
+    NonVariableIterator nvi(lit);
+    while (nvi.hasNext()) {
+      result |= 1ull << (32+nvi.next().term()->functor()%32);
+    }
+  }
+  return result;
+} // Clause::computeSignature
+
+/**
+ * Return false if this clause certainly cannot be used in subsumption
+ * resolution with @b other. All the function symbols of this clause
+ * must occur in @b other, and each of its literals must have
+ * the predicate symbol of a literal of @b other, with the same or
+ * the opposite polarity.
+ */
+bool Clause::maySubsumeResolve(Clause* other) const
+{
+  static const unsigned long long evenBits = 0x5555555555555555ull & 0xFFFFFFFFull;
+  static const unsigned long long oddBits = 0xAAAAAAAAAAAAAAAAull & 0xFFFFFFFFull;
+
+  unsigned long long otherSig = other->signature();
+  //the headers of other with both polarities
+  otherSig |= ((otherSig&evenBits)<<1) | ((otherSig&oddBits)>>1);
+  return !(signature() & ~otherSig);
+}
+
 
 /**
  * Return weight of the split part of the clause
@@ -61,6 +61,8 @@ private:
   ~Clause() { ASSERTION_VIOLATION; }
   /** Should never be used, just that compiler requires it */
   void operator delete(void* ptr) { ASSERTION_VIOLATION; }
+
+  friend class CompactClause;
 public:
   typedef ArrayishObjectIterator<const Clause> Iterator;
 
@@ -167,6 +169,31 @@ public:
   }
   unsigned computeWeight() const;
 
+  /**
+   * Return the signature of the clause, a bitset with a bit for the predicate
+   * symbol and polarity of each literal and for each function symbol that
+   * occurs in the clause. Symbols share bits, so the bitset over-approximates
+   * the symbols of the clause.
+   */
+  unsigned long long signature() const
+  {
+    if(!_signature) {
+      _signature = computeSignature();
+    }
+    return _signature;
+  }
+  unsigned long long computeSignature() const;
+
+  /**
+   * Return false if this clause certainly does not subsume @b other, that
+   * is, if its signature is not a subset of the signature of @b other
+   */
+  bool maySubsume(Clause* other) const
+  {
+    return !(signature() & ~other->signature());
+  }
+  bool maySubsumeResolve(Clause* other) const;
+
   /**
    * weight used for clause selection
    */
@@ -373,6 +400,8 @@ protected:
   mutable unsigned _weight;
   /** weight for clause selection */
   unsigned _weightForClauseSelection;
+  /** signature of the clause, or zero if not computed yet */
+  mutable unsigned long long _signature;
 
   /** number of references to this clause */
   unsigned _refCnt;
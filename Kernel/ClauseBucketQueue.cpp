@@ -0,0 +1,251 @@
+
+/*
+ * File ClauseBucketQueue.cpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions.
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide.
+ */
+/**
+ * @file ClauseBucketQueue.cpp
+ * Implements class ClauseBucketQueue.
+ */
+
+#include "Debug/Tracer.hpp"
+
+#include "ClauseBucketQueue.hpp"
+
+/** Taken entries are discarded from a bucket once there are at least this many of them */
+#define COMPACT_THRESHOLD 64
+
+using namespace Lib;
+using namespace Kernel;
+
+ClauseBucketQueue::ClauseBucketQueue()
+  : _first(0), _size(0), _positions(new PositionMap()), _removedPositions(0)
+{
+}
+
+ClauseBucketQueue::~ClauseBucketQueue()
+{
+  CALL("ClauseBucketQueue::~ClauseBucketQueue");
+
+  while (_buckets.isNonEmpty()) {
+    delete _buckets.pop();
+  }
+  delete _positions;
+}
+
+/**
+ * Insert clause @b c in the queue
+ * @pre @b c must not be in the queue
+ */
+void ClauseBucketQueue::insert(Clause* c)
+{
+  CALL("ClauseBucketQueue::insert");
+
+  unsigned k = key(c);
+  if (k > CLAUSE_BUCKET_QUEUE_MAX_KEY) {
+    k = CLAUSE_BUCKET_QUEUE_MAX_KEY;
+  }
+  while (_buckets.size() <= k) {
+    _buckets.push(0);
+  }
+  Bucket* b = _buckets[k];
+  if (!b) {
+    b = new Bucket();
+    _buckets[k] = b;
+  }
+
+  Position pos;
+  pos.key = k;
+  pos.index = b->dropped + b->entries.size();
+  ALWAYS(_positions->insert(id(c), pos));
+  b->entries.push(c);
+
+  if (k < _first) {
+    _first = k;
+  }
+  _size++;
+} // ClauseBucketQueue::insert
+
+/**
+ * Return the place of @b entry with the id @b id in its bucket,
+ * or zero if @b entry is not in the queue
+ */
+Clause** ClauseBucketQueue::find(Clause* entry, unsigned id)
+{
+  CALL("ClauseBucketQueue::find");
+
+  Position pos;
+  if (!_positions->find(id, pos)) {
+    return 0;
+  }
+  Bucket* b = _buckets[pos.key];
+  ASS_GE(pos.index, b->dropped + b->head);
+  ASS_L(pos.index - b->dropped, b->entries.size());
+  Clause** res = &b->entries[pos.index - b->dropped];
+  return *res == entry ? res : 0;
+}
+
+/**
+ * Remove the position of the entry with the id @b id, which has just
+ * left the queue
+ */
+void ClauseBucketQueue::removePosition(unsigned id)
+{
+  CALL("ClauseBucketQueue::removePosition");
+
+  ALWAYS(_positions->remove(id));
+  _removedPositions++;
+  if (_removedPositions <= _positions->size()) {
+    return;
+  }
+  // the map only reuses the place of a removed key for the same key,
+  // and never shrinks
+  PositionMap* live = new PositionMap();
+  live->loadFromMap(*_positions);
+  delete _positions;
+  _positions = live;
+  _removedPositions = 0;
+}
+
+/**
+ * Remove clause @b c from the queue. Return true if @b c was in the queue.
+ */
+bool ClauseBucketQueue::remove(Clause* c)
+{
+  CALL("ClauseBucketQueue::remove");
+
+  unsigned i = id(c);
+  Clause** place = find(c, i);
+  if (!place) {
+    return false;
+  }
+  *place = 0;
+  removePosition(i);
+  _size--;
+  return true;
+} // ClauseBucketQueue::remove
+
+/**
+ * Remove the first clause from the queue and return it.
+ * @pre the queue must not be empty
+ */
+Clause* ClauseBucketQueue::pop()
+{
+  CALL("ClauseBucketQueue::pop");
+  ASS(!isEmpty());
+
+  for (;;) {
+    ASS_L(_first, _buckets.size());
+    Bucket* b = _buckets[_first];
+    if (!b || b->head == b->entries.size()) {
+      _first++;
+      continue;
+    }
+
+    Clause* c = b->entries[b->head++];
+    drop(b);
+    if (c) {
+      removePosition(id(c));
+      _size--;
+      return c;
+    }
+  }
+} // ClauseBucketQueue::pop
+
+/**
+ * Discard the taken entries of @b b if there are enough of them
+ */
+void ClauseBucketQueue::drop(Bucket* b)
+{
+  CALL("ClauseBucketQueue::drop");
+
+  if (b->head == b->entries.size()) {
+    b->dropped += b->head;
+    b->entries.reset();
+    b->head = 0;
+  }
+  else if (b->head >= COMPACT_THRESHOLD && 2*b->head > b->entries.size()) {
+    unsigned remaining = b->entries.size() - b->head;
+    for (unsigned i = 0; i < remaining; i++) {
+      b->entries[i] = b->entries[b->head + i];
+    }
+    b->entries.truncate(remaining);
+    b->dropped += b->head;
+    b->head = 0;
+  }
+}
+
+void ClauseBucketQueue::removeAll()
+{
+  CALL("ClauseBucketQueue::removeAll");
+
+  for (unsigned i = 0; i < _buckets.size(); i++) {
+    Bucket* b = _buckets[i];
+    if (b) {
+      b->dropped += b->entries.size();
+      b->entries.reset();
+      b->head = 0;
+    }
+  }
+  delete _positions;
+  _positions = new PositionMap();
+  _removedPositions = 0;
+  _first = _buckets.size();
+  _size = 0;
+} // ClauseBucketQueue::removeAll
+
+ClauseBucketQueue::Iterator::Iterator(ClauseBucketQueue& queue)
+  : _queue(&queue), _bucket(queue._first), _pos(0)
+{
+  if (_bucket < queue._buckets.size() && queue._buckets[_bucket]) {
+    _pos = queue._buckets[_bucket]->head;
+  }
+}
+
+/** true if there is a next clause */
+bool ClauseBucketQueue::Iterator::hasNext()
+{
+  CALL("ClauseBucketQueue::Iterator::hasNext");
+
+  while (_bucket < _queue->_buckets.size()) {
+    Bucket* b = _queue->_buckets[_bucket];
+    if (b) {
+      while (_pos < b->entries.size()) {
+        if (b->entries[_pos]) {
+          return true;
+        }
+        // skip the removed clause
+        _pos++;
+      }
+    }
+    _bucket++;
+    _pos = (_bucket < _queue->_buckets.size() && _queue->_buckets[_bucket]) ?
+        _queue->_buckets[_bucket]->head : 0;
+  }
+  return false;
+}
+
+/**
+ * Return the next clause
+ * @pre hasNext() must have been called and returned true
+ */
+Clause* ClauseBucketQueue::Iterator::next()
+{
+  CALL("ClauseBucketQueue::Iterator::next");
+  ASS_L(_bucket, _queue->_buckets.size());
+
+  return _queue->_buckets[_bucket]->entries[_pos++];
+}
@@ -0,0 +1,144 @@
+
+/*
+ * File ClauseBucketQueue.hpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions.
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide.
+ */
+/**
+ * @file ClauseBucketQueue.hpp
+ * Defines class ClauseBucketQueue.
+ */
+
+#ifndef __ClauseBucketQueue__
+#define __ClauseBucketQueue__
+
+#include "Forwards.hpp"
+
+#include "Lib/Allocator.hpp"
+#include "Lib/DHMap.hpp"
+#include "Lib/Stack.hpp"
+
+/** Clauses with this or a larger key share the last bucket */
+#define CLAUSE_BUCKET_QUEUE_MAX_KEY 65535
+
+namespace Kernel {
+
+using namespace Lib;
+
+/**
+ * A clause queue ordered by a small integer key, computed by the virtual
+ * function key(). It is an alternative to the skip list of ClauseQueue
+ * for keys such as the age or the weight of a clause.
+ *
+ * There is one bucket per key, the clauses of a bucket are taken in the
+ * order in which they were inserted. The key of a clause must not change
+ * while the clause is in the queue.
+ *
+ * Removal is lazy: the entry of the clause is only overwritten by zero
+ * and dropped when pop() reaches it, so neither removal nor insertion
+ * ever moves the other entries of the bucket.
+ *
+ * The position of each entry is kept in a map from the number computed
+ * by the virtual function id(), the clause number. A position is removed
+ * when its entry leaves the queue. Since the map keeps the places of the
+ * removed positions, it is replaced by a new map once more positions were
+ * removed than there are entries, so its size follows the size of the queue.
+ */
+class ClauseBucketQueue
+{
+public:
+  ClauseBucketQueue();
+  virtual ~ClauseBucketQueue();
+  void insert(Clause*);
+  bool remove(Clause*);
+  void removeAll();
+  Clause* pop();
+  /** True if the queue is empty */
+  bool isEmpty() const
+  { return _size == 0; }
+  /** Number of clauses in the queue */
+  unsigned size() const
+  { return _size; }
+
+protected:
+  /** the key of a clause, clauses with smaller keys are taken first */
+  virtual unsigned key(Clause*) = 0;
+  /** a number that identifies the clause in the queue, such as the clause number */
+  virtual unsigned id(Clause*) = 0;
+
+private:
+  struct Bucket {
+    CLASS_NAME(ClauseBucketQueue::Bucket);
+    USE_ALLOCATOR(ClauseBucketQueue::Bucket);
+
+    Bucket() : head(0), dropped(0) {}
+    /**
+     * Entries of the bucket, the ones before @b head were already taken.
+     * Entries of removed clauses are zero.
+     */
+    Stack<Clause*> entries;
+    unsigned head;
+    /** Number of entries dropped from the beginning of @b entries */
+    unsigned dropped;
+  };
+
+  /** Where the entry of a clause is */
+  struct Position {
+    Position() : key(0), index(0) {}
+    unsigned key;
+    /** Index of the entry in the bucket, counting the dropped entries */
+    unsigned index;
+  };
+
+  Clause** find(Clause* entry, unsigned id);
+  void removePosition(unsigned id);
+  void drop(Bucket* b);
+
+  /** Buckets indexed by the key, null for keys that were not used yet */
+  Stack<Bucket*> _buckets;
+  /** All buckets with a smaller index are empty */
+  unsigned _first;
+  /** Number of clauses in the queue */
+  unsigned _size;
+  typedef DHMap<unsigned,Position> PositionMap;
+  /** Positions of the entries in the queue by their id() */
+  PositionMap* _positions;
+  /** Number of positions removed from @b _positions since it was created */
+  unsigned _removedPositions;
+
+public:
+  /**
+   * Iterator over the queue in the order in which the clauses would
+   * be popped. The queue must not be modified during the iteration.
+   */
+  class Iterator {
+  public:
+    DECL_ELEMENT_TYPE(Clause*);
+
+    explicit Iterator(ClauseBucketQueue& queue);
+    bool hasNext();
+    Clause* next();
+  private:
+    ClauseBucketQueue* _queue;
+    /** Index of the current bucket */
+    unsigned _bucket;
+    /** Position of the next entry in the current bucket */
+    unsigned _pos;
+  }; // class ClauseBucketQueue::Iterator
+}; // class ClauseBucketQueue
+
+} // namespace Kernel
+
+#endif
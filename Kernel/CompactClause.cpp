@@ -0,0 +1,157 @@
+
+/*
+ * File CompactClause.cpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions.
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide.
+ */
+/**
+ * @file CompactClause.cpp
+ * Implements class CompactClause.
+ */
+
+#include <new>
+
+#include "Debug/RuntimeStatistics.hpp"
+
+#include "Lib/DHMap.hpp"
+#include "Lib/Environment.hpp"
+#include "Lib/SharedSet.hpp"
+
+#include "Clause.hpp"
+
+#include "CompactClause.hpp"
+
+namespace Kernel
+{
+
+using namespace Lib;
+
+/**
+ * Move the proof extra of the object at @b from, if there is one, to the
+ * object at @b to. The proof extra is keyed by the address, which is reused
+ * once the object is deallocated.
+ */
+static void moveProofExtra(void* from, void* to)
+{
+  CALL("moveProofExtra");
+
+  vstring extra;
+  if (env.proofExtra && env.proofExtra->pop(from, extra)) {
+    env.proofExtra->insert(to, extra);
+  }
+}
+
+/**
+ * Return the number of bytes taken by a record of a clause with @b length literals
+ */
+size_t CompactClause::sizeFor(unsigned length)
+{
+  //the same as in Clause::operator new, _length-1 would not
+  //behave well for _length==0 on x64 platform.
+  size_t size = sizeof(CompactClause) + length * sizeof(Literal*);
+  return size - sizeof(Literal*);
+}
+
+/**
+ * True if @b cl can be replaced by a record. This is the case if no
+ * other clause refers to @b cl and @b cl is not kept anywhere else by
+ * the splitting or the preprocessing.
+ *
+ * The one reference allowed is the one SaturationAlgorithm::forwardSimplify
+ * takes on every retained clause, it is kept by the record.
+ */
+bool CompactClause::canCompact(Clause* cl)
+{
+  CALL("CompactClause::canCompact");
+
+  return cl->_refCnt <= 1 && !cl->isFromPreprocessing() &&
+    (!cl->splits() || cl->splits()->isEmpty()) &&
+    !cl->isComponent() && !cl->isExtensionality() && !cl->isTaggedExtensionality() &&
+    !cl->numSelected();
+}
+
+/**
+ * Replace the clause @b cl by a record. The clause object is destroyed,
+ * the record takes over its inference.
+ * @pre canCompact(cl)
+ */
+CompactClause* CompactClause::fromClause(Clause* cl, const Shell::Options& opt)
+{
+  CALL("CompactClause::fromClause");
+  ASS(canCompact(cl));
+
+  RSTAT_CTR_INC("clauses compacted");
+
+  unsigned length = cl->length();
+  void* mem = ALLOC_KNOWN(sizeFor(length), "CompactClause");
+  CompactClause* res = ::new(mem) CompactClause(cl->inference());
+  res->_number = cl->number();
+  res->_weightForClauseSelection = cl->weightForClauseSelection(opt);
+  res->_length = length;
+  res->_color = cl->_color;
+  res->_inheritedColor = cl->_inheritedColor;
+  res->_refCnt = cl->_refCnt;
+  for (unsigned i = 0; i < length; i++) {
+    res->_literals[i] = (*cl)[i];
+  }
+
+  moveProofExtra(cl, res);
+  cl->destroyExceptInferenceObject();
+  return res;
+}
+
+/**
+ * Create the clause the record was made from and destroy the record.
+ * The clause has the same number, literals and inference as the
+ * original one.
+ */
+Clause* CompactClause::materialize()
+{
+  CALL("CompactClause::materialize");
+
+  RSTAT_CTR_INC("clauses materialized");
+
+  unsigned length = _length;
+  Clause* res = new(length) Clause(length, _inference);
+  res->_number = _number;
+  res->_weightForClauseSelection = _weightForClauseSelection;
+  res->_color = _color;
+  res->_inheritedColor = _inheritedColor;
+  res->_refCnt = _refCnt;
+  for (unsigned i = 0; i < length; i++) {
+    (*res)[i] = _literals[i];
+  }
+
+  moveProofExtra(this, res);
+  // the inference now belongs to the clause
+  DEALLOC_KNOWN(this, sizeFor(length), "CompactClause");
+  return res;
+}
+
+/**
+ * Destroy the record together with its inference
+ */
+void CompactClause::destroy()
+{
+  CALL("CompactClause::destroy");
+
+  if (env.proofExtra) {
+    env.proofExtra->remove(this);
+  }
+  _inference.destroy();
+  DEALLOC_KNOWN(this, sizeFor(_length), "CompactClause");
+}
+
+}
@@ -0,0 +1,82 @@
+
+/*
+ * File CompactClause.hpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions.
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide.
+ */
+/**
+ * @file CompactClause.hpp
+ * Defines class CompactClause.
+ */
+
+#ifndef __CompactClause__
+#define __CompactClause__
+
+#include "Forwards.hpp"
+
+#include "Lib/Allocator.hpp"
+
+#include "Inference.hpp"
+
+namespace Kernel {
+
+using namespace Lib;
+
+/**
+ * An immutable record of a clause that is waiting in the passive
+ * container. It keeps only what is needed to order the clause and to
+ * rebuild it: the literals, the inference, the number, the colors and
+ * the weight for clause selection. On 64-bit builds the record is 56
+ * bytes smaller than the Clause object it replaces; the shared literals
+ * and the inference are taken over as they are, so they are not saved.
+ *
+ * A clause can be turned into a record only if nothing refers to
+ * it by its address, see canCompact().
+ */
+class CompactClause
+{
+public:
+  static bool canCompact(Clause* cl);
+  static CompactClause* fromClause(Clause* cl, const Shell::Options& opt);
+  Clause* materialize();
+  void destroy();
+
+  unsigned age() const { return _inference.age(); }
+  unsigned number() const { return _number; }
+  unsigned weightForClauseSelection() const { return _weightForClauseSelection; }
+  unsigned length() const { return _length; }
+
+private:
+  CompactClause(const Inference& inf) : _inference(inf) {}
+
+  static size_t sizeFor(unsigned length);
+
+  /** the inference of the clause, owned by the record */
+  Inference _inference;
+  unsigned _number;
+  unsigned _weightForClauseSelection;
+  unsigned _length : 20;
+  /** clause color, or COLOR_INVALID if not determined yet */
+  unsigned _color : 2;
+  unsigned _inheritedColor : 2;
+  /** the reference counter of the clause, at most one */
+  unsigned _refCnt : 1;
+  /** Array of literals of the clause */
+  Literal* _literals[1];
+}; // class CompactClause
+
+}
+
+#endif // __CompactClause__
@@ -845,6 +845,8 @@ vstring Kernel::ruleName(InferenceRule rule)
     return "distinct equality removal";
   case InferenceRule::EXTERNAL:
     return "external";
+  case InferenceRule::IMPORTED_LEMMA:
+    return "imported lemma";
   case InferenceRule::CLAIM_DEFINITION:
     return "claim definition";
   case InferenceRule::BFNT_FLATTENING:
@@ -322,6 +322,8 @@ enum class InferenceRule : unsigned char {
 
   /** inference coming from outside of Vampire */
   EXTERNAL,
+  /** lemma imported from another portfolio slice */
+  IMPORTED_LEMMA,
 
   /** BNFT flattening */
   BFNT_FLATTENING,
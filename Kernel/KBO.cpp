@@ -23,20 +23,29 @@
  * @since 30/04/2008 flight Brussels-Tel Aviv
  */
 
+#include <utility>
+
 #include "Debug/Tracer.hpp"
 
 
 #include "Lib/Environment.hpp"
 #include "Lib/Comparison.hpp"
+#include "Lib/DHMap.hpp"
+#include "Lib/Hash.hpp"
+#include "Lib/Stack.hpp"
 
 #include "Shell/Options.hpp"
 
 #include "Term.hpp"
+#include "TermIterators.hpp"
 #include "KBO.hpp"
 #include "Signature.hpp"
 
 #define COLORED_WEIGHT_BOOST 0x10000
 
+/** Number of entries of the comparison cache, a power of two */
+#define COMPARISON_CACHE_SIZE 4096
+
 namespace Kernel {
 
 using namespace Lib;
@@ -202,6 +211,11 @@ void KBO::State::traverse(TermList tl,int coef)
   Term* t=tl.term();
   ASSERT_VALID(*t);
 
+  if(t->ground() && _kbo.hasSharedWeight(t)) {
+    _weightDiff+=static_cast<int>(t->weight())*coef;
+    return;
+  }
+
   _weightDiff+=_kbo.functionSymbolWeight(t->functor())*coef;
 
   if(!t->arity()) {
@@ -215,9 +229,15 @@ void KBO::State::traverse(TermList tl,int coef)
       stack.push(ts->next());
     }
     if(ts->isTerm()) {
-      _weightDiff+=_kbo.functionSymbolWeight(ts->term()->functor())*coef;
-      if(ts->term()->arity()) {
-	stack.push(ts->term()->args());
+      Term* st=ts->term();
+      if(st->ground() && _kbo.hasSharedWeight(st)) {
+        // there are no variables to record
+        _weightDiff+=static_cast<int>(st->weight())*coef;
+      } else {
+        _weightDiff+=_kbo.functionSymbolWeight(st->functor())*coef;
+        if(st->arity()) {
+          stack.push(st->args());
+        }
       }
     } else {
       ASS_METHOD(*ts,isOrdinaryVar());
@@ -296,7 +316,7 @@ void KBO::State::traverse(Term* t1, Term* t2)
  * Create a KBO object.
  */
 KBO::KBO(Problem& prb, const Options& opt)
- : PrecedenceOrdering(prb, opt)
+ : PrecedenceOrdering(prb, opt), _useCache(opt.kboCache())
 {
   CALL("KBO::KBO");
 
@@ -304,6 +324,14 @@ KBO::KBO(Problem& prb, const Options& opt)
   _defaultSymbolWeight = 1;
 
   _state=new State(this);
+
+  if(_useCache) {
+    _cache.ensure(COMPARISON_CACHE_SIZE);
+    for(unsigned i=0;i<COMPARISON_CACHE_SIZE;i++) {
+      _cache[i].t1=0;
+      _cache[i].t2=0;
+    }
+  }
 }
 
 KBO::~KBO()
@@ -330,6 +358,10 @@ Ordering::Result KBO::comparePredicates(Literal* l1, Literal* l2) const
   unsigned p2 = l2->functor();
 
   Result res;
+  if(compareBySharedData(l1,l2,res)) {
+    return res;
+  }
+
   ASS(_state);
   State* state=_state;
 #if VDEBUG
@@ -388,6 +420,36 @@ Ordering::Result KBO::compare(TermList tl1, TermList tl2) const
   Term* t1=tl1.term();
   Term* t2=tl2.term();
 
+  if(!_useCache || !t1->shared() || !t2->shared()) {
+    return compareTerms(t1,t2);
+  }
+
+  Result res;
+  if(compareBySharedData(t1,t2,res)) {
+    return res;
+  }
+
+  // the pair is looked up with the term of the smaller id first
+  bool swapped=t1->getId()>t2->getId();
+  if(swapped) {
+    std::swap(t1,t2);
+  }
+  CacheEntry& entry=_cache[HashUtils::combine(t1->getId(),t2->getId()) & (COMPARISON_CACHE_SIZE-1)];
+  if(entry.t1!=t1 || entry.t2!=t2) {
+    entry.t1=t1;
+    entry.t2=t2;
+    entry.result=compareTerms(t1,t2);
+  }
+  return swapped ? reverse(entry.result) : entry.result;
+}
+
+/**
+ * Compare the terms @b t1 and @b t2 by traversing them
+ */
+Ordering::Result KBO::compareTerms(Term* t1, Term* t2) const
+{
+  CALL("KBO::compareTerms");
+
   ASS(_state);
   State* state=_state;
 #if VDEBUG
@@ -399,8 +461,8 @@ Ordering::Result KBO::compare(TermList tl1, TermList tl2) const
   if(t1->functor()==t2->functor()) {
     state->traverse(t1,t2);
   } else {
-    state->traverse(tl1,1);
-    state->traverse(tl2,-1);
+    state->traverse(TermList(t1),1);
+    state->traverse(TermList(t2),-1);
   }
   Result res=state->result(t1,t2);
 #if VDEBUG
@@ -409,6 +471,241 @@ Ordering::Result KBO::compare(TermList tl1, TermList tl2) const
   return res;
 }
 
+/**
+ * True if @b t is shared and its weight stored by the term sharing is
+ * its weight in this ordering, i.e. it contains no colored symbols
+ */
+bool KBO::hasSharedWeight(Term* t) const
+{
+  return _useCache && t->shared() && (!env.colorUsed || t->color()==COLOR_TRANSPARENT);
+}
+
+/**
+ * If the weights of the terms or literals @b t1 and @b t2 differ, the
+ * result of their comparison only depends on the variable condition.
+ * If the condition can be decided from the numbers of occurrences of
+ * variables, assign the result to @b res and return true.
+ *
+ * The weights stored by the term sharing count the top symbol too, this
+ * does not matter for the difference of the weights of two literals.
+ */
+bool KBO::compareBySharedData(Term* t1, Term* t2, Result& res) const
+{
+  CALL("KBO::compareBySharedData");
+
+  if(!hasSharedWeight(t1) || !hasSharedWeight(t2)) {
+    return false;
+  }
+  unsigned w1=t1->weight();
+  unsigned w2=t2->weight();
+  if(w1>w2) {
+    if(t2->ground()) {
+      res=Result::GREATER;
+      return true;
+    }
+    if(t2->vars()>t1->vars()) {
+      // some variable occurs more times in t2
+      res=Result::INCOMPARABLE;
+      return true;
+    }
+  } else if(w1<w2) {
+    if(t1->ground()) {
+      res=Result::LESS;
+      return true;
+    }
+    if(t1->vars()>t2->vars()) {
+      res=Result::INCOMPARABLE;
+      return true;
+    }
+  }
+  return false;
+}
+
+/**
+ * Check whether lσ>rσ for terms l and r such that l is not a variable
+ * and contains all variables of r.
+ *
+ * The variable condition holds for lσ and rσ if every variable that
+ * occurs more times in r than in l is mapped to a ground term. These
+ * variables are found in lσ at the positions of their occurrences in l.
+ * When the condition holds, the weights stored by the term sharing decide,
+ * unless they are equal. Then the result is given by the precedence of
+ * the top symbols or by the first arguments in which lσ and rσ differ,
+ * and l and r determine in advance which one it is and which arguments
+ * can differ. All other cases are left to KBO::compare.
+ */
+class KBO::InstanceCheck
+: public InstanceOrderingCheck
+{
+public:
+  CLASS_NAME(KBO::InstanceCheck);
+  USE_ALLOCATOR(InstanceCheck);
+
+  InstanceCheck(const KBO& kbo, Term* l, TermList r);
+
+  bool isGreater(TermList lS, TermList rS) const override;
+private:
+  bool evaluate(Term* lS, TermList rS) const;
+  static bool findVariable(Term* t, unsigned var, Stack<unsigned>& path);
+
+  /** How lσ and rσ of the same weight compare */
+  enum class Lex {
+    GREATER,
+    NOT_GREATER,
+    /** by the first arguments starting from _firstArg that differ */
+    ARGUMENTS
+  };
+
+  const KBO& _kbo;
+  /**
+   * For every variable that occurs more times in r than in l, the length
+   * of a path to one of its occurrences in l, followed by the indices of
+   * the arguments on the path
+   */
+  Stack<unsigned> _groundPaths;
+  Lex _lex;
+  /** The first argument in which l and r differ */
+  unsigned _firstArg;
+};
+
+KBO::InstanceCheck::InstanceCheck(const KBO& kbo, Term* l, TermList r)
+: _kbo(kbo), _firstArg(0)
+{
+  CALL("KBO::InstanceCheck::InstanceCheck");
+
+  static DHMap<unsigned,int> varDiffs;
+  varDiffs.reset();
+  int* pnum;
+  VariableIterator lvit(l);
+  while(lvit.hasNext()) {
+    varDiffs.getValuePtr(lvit.next().var(),pnum,0);
+    (*pnum)++;
+  }
+  VariableIterator rvit(r);
+  while(rvit.hasNext()) {
+    varDiffs.getValuePtr(rvit.next().var(),pnum,0);
+    (*pnum)--;
+  }
+
+  static Stack<unsigned> path;
+  DHMap<unsigned,int>::Iterator dit(varDiffs);
+  while(dit.hasNext()) {
+    unsigned var;
+    int diff;
+    dit.next(var,diff);
+    if(diff>=0) {
+      continue;
+    }
+    path.reset();
+    ALWAYS(findVariable(l,var,path));
+    _groundPaths.push(path.size());
+    for(unsigned i=0;i<path.size();i++) {
+      _groundPaths.push(path[i]);
+    }
+  }
+
+  if(r.isVar()) {
+    // lσ properly contains rσ, so it is always heavier
+    _lex=Lex::NOT_GREATER;
+  } else if(l->functor()!=r.term()->functor()) {
+    _lex=kbo.compareFunctionPrecedences(l->functor(), r.term()->functor())==Result::GREATER ?
+	Lex::GREATER : Lex::NOT_GREATER;
+  } else {
+    _lex=Lex::ARGUMENTS;
+    while(*l->nthArgument(_firstArg)==*r.term()->nthArgument(_firstArg)) {
+      _firstArg++;
+    }
+  }
+}
+
+/**
+ * Push to @b path the indices of arguments on a path from @b t to an
+ * occurrence of the variable @b var and return true, or return false
+ * if @b var does not occur in @b t
+ */
+bool KBO::InstanceCheck::findVariable(Term* t, unsigned var, Stack<unsigned>& path)
+{
+  for(unsigned i=0;i<t->arity();i++) {
+    TermList arg=*t->nthArgument(i);
+    path.push(i);
+    if(arg.isVar() ? arg.var()==var : findVariable(arg.term(),var,path)) {
+      return true;
+    }
+    path.pop();
+  }
+  return false;
+}
+
+bool KBO::InstanceCheck::isGreater(TermList lS, TermList rS) const
+{
+  CALL("KBO::InstanceCheck::isGreater");
+  ASS(lS.isTerm());
+
+  bool res=evaluate(lS.term(),rS);
+  ASS_EQ(res, _kbo.compare(lS,rS)==Result::GREATER);
+  return res;
+}
+
+bool KBO::InstanceCheck::evaluate(Term* lS, TermList rS) const
+{
+  CALL("KBO::InstanceCheck::evaluate");
+
+  if(!_kbo.hasSharedWeight(lS) || (rS.isTerm() && !_kbo.hasSharedWeight(rS.term()))) {
+    return _kbo.compare(TermList(lS),rS)==Result::GREATER;
+  }
+
+  unsigned i=0;
+  while(i<_groundPaths.size()) {
+    unsigned len=_groundPaths[i++];
+    TermList s(lS);
+    for(unsigned j=0;j<len;j++) {
+      s=*s.term()->nthArgument(_groundPaths[i++]);
+    }
+    if(s.isVar() || !s.term()->ground()) {
+      // the variable condition depends on the variables of the instance
+      return _kbo.compare(TermList(lS),rS)==Result::GREATER;
+    }
+  }
+
+  unsigned lWeight=lS->weight();
+  unsigned rWeight=rS.isVar() ? 1 : rS.term()->weight();
+  if(lWeight!=rWeight) {
+    return lWeight>rWeight;
+  }
+  switch(_lex) {
+  case Lex::GREATER:
+    return true;
+  case Lex::NOT_GREATER:
+    return false;
+  case Lex::ARGUMENTS:
+    break;
+  }
+  Term* rt=rS.term();
+  for(unsigned j=_firstArg;j<lS->arity();j++) {
+    TermList la=*lS->nthArgument(j);
+    TermList ra=*rt->nthArgument(j);
+    if(la!=ra) {
+      return _kbo.compare(la,ra)==Result::GREATER;
+    }
+  }
+  return false;
+}
+
+/**
+ * When the option kbo_cache is on, return a check that decides most
+ * comparisons of lσ and rσ from the shared data of the instances,
+ * see KBO::InstanceCheck
+ */
+InstanceOrderingCheck* KBO::compileInstanceCheck(TermList l, TermList r) const
+{
+  CALL("KBO::compileInstanceCheck");
+
+  if(!_useCache || l.isVar() || l==r || !l.containsAllVariablesOf(r)) {
+    return 0;
+  }
+  return new InstanceCheck(*this, l.term(), r);
+}
+
 int KBO::functionSymbolWeight(unsigned fun) const
 {
   int weight = _defaultSymbolWeight;
@@ -38,6 +38,16 @@ using namespace Lib;
 
 /**
  * Class for instances of the Knuth-Bendix orderings
+ *
+ * When the option kbo_cache is on, the ordering takes the weights
+ * and the numbers of variable occurrences of shared terms from the term
+ * sharing instead of traversing the terms, so ground shared subterms are
+ * never traversed and comparisons with different weights are often
+ * decided without any traversal. The results of other comparisons of
+ * shared terms are kept in a small direct-mapped cache. Demodulators
+ * with incomparable sides get a check of their instances that mostly
+ * relies on the same shared data, see compileInstanceCheck().
+ *
  * @since 30/04/2008 flight Brussels-Tel Aviv
  */
 class KBO
@@ -52,6 +62,8 @@ public:
 
   using PrecedenceOrdering::compare;
   Result compare(TermList tl1, TermList tl2) const override;
+
+  InstanceOrderingCheck* compileInstanceCheck(TermList l, TermList r) const override;
 protected:
   Result comparePredicates(Literal* l1, Literal* l2) const override;
 
@@ -64,6 +76,9 @@ protected:
 
   int functionSymbolWeight(unsigned fun) const;
 
+  bool hasSharedWeight(Term* t) const;
+  bool compareBySharedData(Term* t1, Term* t2, Result& res) const;
+
   bool allConstantsHeavierThanVariables() const { return false; }
   bool existsZeroWeightUnaryFunction() const { return false; }
 
@@ -72,6 +87,25 @@ protected:
    * State used for comparing terms and literals
    */
   mutable State* _state;
+
+private:
+  class InstanceCheck;
+
+  Result compareTerms(Term* t1, Term* t2) const;
+
+  struct CacheEntry {
+    Term* t1;
+    Term* t2;
+    Result result;
+  };
+
+  /** True if the shared data of terms and the cache are used */
+  bool _useCache;
+  /**
+   * Results of comparisons of shared terms, the entry of a pair
+   * is given by the ids of the terms, see compare(TermList,TermList)
+   */
+  mutable DArray<CacheEntry> _cache;
 };
 
 }
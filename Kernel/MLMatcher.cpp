@@ -37,6 +37,8 @@
 #include "Lib/Stack.hpp"
 #include "Lib/TriangularArray.hpp"
 
+#include "Shell/Options.hpp"
+
 #include "Clause.hpp"
 #include "Matcher.hpp"
 #include "Term.hpp"
@@ -51,6 +53,12 @@ using namespace std;
 #endif
 
 #define TRACE_LONG_MATCHING 0
+
+/**
+ * Instance clauses of at most this length have the literals each base
+ * literal can be matched to kept in bitsets
+ */
+#define MLMATCHER_BITSET_LEN 64
 #if TRACE_LONG_MATCHING
 #include "Lib/Timer.hpp"
 #endif
@@ -503,6 +511,54 @@ MatchingData* getMatchingData(Literal** baseLits0, unsigned baseLen, Clause* ins
   return &s_matchingData;
 }
 
+typedef unsigned long long LitBitset;
+
+/**
+ * Try to find a literal for the @b b -th base literal among the literals
+ * in @b masks[b] that are not in @b visited, possibly moving the base
+ * literals that already have one to another one of theirs. Return true
+ * if successful. (An augmenting path of the Kuhn's algorithm.)
+ */
+bool augmentMatching(unsigned b, const LitBitset* masks, int* owners, LitBitset& visited)
+{
+  LitBitset cand=masks[b]&~visited;
+  while(cand) {
+    LitBitset bit=cand&(~cand+1);
+    cand^=bit;
+    visited|=bit;
+    unsigned pos=0;
+    while(!(bit&(1ull<<pos))) {
+      pos++;
+    }
+    if(owners[pos]==-1 || augmentMatching(owners[pos], masks, owners, visited)) {
+      owners[pos]=b;
+      return true;
+    }
+  }
+  return false;
+}
+
+/**
+ * Return true if each of the @b len base literals can be assigned a distinct
+ * instance literal from its bitset in @b masks (Hall's condition).
+ */
+bool haveDistinctAlternatives(const LitBitset* masks, unsigned len)
+{
+  CALL("haveDistinctAlternatives");
+
+  static int owners[MLMATCHER_BITSET_LEN];
+  for(unsigned i=0;i<MLMATCHER_BITSET_LEN;i++) {
+    owners[i]=-1;
+  }
+  for(unsigned b=0;b<len;b++) {
+    LitBitset visited=0;
+    if(!augmentMatching(b, masks, owners, visited)) {
+      return false;
+    }
+  }
+  return true;
+}
+
 }
 
 using namespace MLMatcher_AUX;
@@ -521,8 +577,35 @@ bool MLMatcher::canBeMatched(Literal** baseLits, unsigned baseLen, Clause* insta
   }
   unsigned instLen = instance->length();
 
+  //With bitsets, altMasks[bi] are the instance literals in the alternatives
+  //of the bi-th base literal and usedMasks[bi] are the instance literals
+  //taken by the base literals before the bi-th one. The matchRecord is
+  //used only without them.
+  static DArray<LitBitset> altMasks(32);
+  static DArray<LitBitset> usedMasks(32);
+  bool useBitsets=multiset && !resolvedLit && instLen<=MLMATCHER_BITSET_LEN && env.options->mlMatcherBitsets();
+  if(useBitsets) {
+    altMasks.ensure(md->len);
+    usedMasks.ensure(md->len+1);
+    for(unsigned bi=0;bi<md->len;bi++) {
+      LitBitset mask=0;
+      LiteralList::Iterator ait(md->alts[bi]);
+      while(ait.hasNext()) {
+	mask|=1ull<<instance->getLiteralPosition(ait.next());
+      }
+      if(!mask) {
+	return false;
+      }
+      altMasks[bi]=mask;
+    }
+    if(!haveDistinctAlternatives(altMasks.array(), md->len)) {
+      return false;
+    }
+    usedMasks[0]=0;
+  }
+
   static DArray<unsigned> matchRecord(32);
-  unsigned matchRecordLen=resolvedLit?2:instLen;
+  unsigned matchRecordLen=useBitsets?0:(resolvedLit?2:instLen);
   matchRecord.init(matchRecordLen,0xFFFFFFFF);
 
 
@@ -547,21 +630,43 @@ binding_start:
     }
 
     unsigned maxAlt=md->getRemainingInCurrent(currBLit);
-    while(md->nextAlts[currBLit]<maxAlt &&
-	    ( (multiset &&
-		    matchRecord[md->getAltRecordIndex(currBLit, md->nextAlts[currBLit])]<currBLit) ||
-	    !md->bindAlt(currBLit,md->nextAlts[currBLit]) ) ) {
-      md->nextAlts[currBLit]++;
+    if(useBitsets) {
+      //skip the alternatives whose literal is used already, or after whose
+      //binding some of the later base literals would have no literal left
+      while(md->nextAlts[currBLit]<maxAlt) {
+	LitBitset used=usedMasks[currBLit] |
+	    (1ull<<md->getAltRecordIndex(currBLit, md->nextAlts[currBLit]));
+	if(used!=usedMasks[currBLit]) {
+	  unsigned later=currBLit+1;
+	  while(later<matchedLen && (altMasks[later]&~used)) {
+	    later++;
+	  }
+	  if(later==matchedLen && md->bindAlt(currBLit,md->nextAlts[currBLit])) {
+	    usedMasks[currBLit+1]=used;
+	    break;
+	  }
+	}
+	md->nextAlts[currBLit]++;
+      }
+    } else {
+      while(md->nextAlts[currBLit]<maxAlt &&
+	      ( (multiset &&
+		      matchRecord[md->getAltRecordIndex(currBLit, md->nextAlts[currBLit])]<currBLit) ||
+	      !md->bindAlt(currBLit,md->nextAlts[currBLit]) ) ) {
+	md->nextAlts[currBLit]++;
+      }
     }
     if(md->nextAlts[currBLit] < maxAlt) {
-      unsigned matchRecordIndex=md->getAltRecordIndex(currBLit, md->nextAlts[currBLit]);
-      for(unsigned i=0;i<matchRecordLen;i++) {
-	if(matchRecord[i]==currBLit) {
-	  matchRecord[i]=0xFFFFFFFF;
+      if(!useBitsets) {
+	unsigned matchRecordIndex=md->getAltRecordIndex(currBLit, md->nextAlts[currBLit]);
+	for(unsigned i=0;i<matchRecordLen;i++) {
+	  if(matchRecord[i]==currBLit) {
+	    matchRecord[i]=0xFFFFFFFF;
+	  }
+	}
+	if(matchRecord[matchRecordIndex]>currBLit) {
+	  matchRecord[matchRecordIndex]=currBLit;
 	}
-      }
-      if(matchRecord[matchRecordIndex]>currBLit) {
-	matchRecord[matchRecordIndex]=currBLit;
       }
       md->nextAlts[currBLit]++;
       currBLit++;
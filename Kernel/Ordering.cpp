@@ -230,6 +230,14 @@ Ordering::Result Ordering::getEqualityArgumentOrder(Literal* eq) const
   return res;
 }
 
+/**
+ * The default has no cheaper check, instances are compared by compare()
+ */
+InstanceOrderingCheck* Ordering::compileInstanceCheck(TermList l, TermList r) const
+{
+  return 0;
+}
+
 //////////////////////////////////////////////////
 // PrecedenceOrdering class
 //////////////////////////////////////////////////
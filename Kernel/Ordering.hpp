@@ -111,6 +111,13 @@ public:
   static Ordering* tryGetGlobalOrdering();
 
   Result getEqualityArgumentOrder(Literal* eq) const;
+
+  /**
+   * Return a check whether lσ>rσ for instances of the terms @b l and @b r
+   * that is cheaper than comparing the instances, or zero if the ordering
+   * cannot prepare such a check. The caller owns the returned object.
+   */
+  virtual InstanceOrderingCheck* compileInstanceCheck(TermList l, TermList r) const;
 protected:
 
   Result compareEqualities(Literal* eq1, Literal* eq2) const;
@@ -157,6 +164,27 @@ private:
   static OrderingSP s_globalOrdering;
 }; // class Ordering
 
+/**
+ * A check whether lσ>rσ prepared for terms l and r by
+ * Ordering::compileInstanceCheck, so that it need not compare the
+ * instances lσ and rσ from scratch. Demodulators whose sides are
+ * incomparable use it to check each rewrite they are matched for.
+ */
+class InstanceOrderingCheck
+{
+public:
+  CLASS_NAME(InstanceOrderingCheck);
+  USE_ALLOCATOR(InstanceOrderingCheck);
+
+  virtual ~InstanceOrderingCheck() {}
+
+  /**
+   * Return true if @b lS is greater than @b rS, where @b lS and @b rS
+   * are lσ and rσ for the same substitution σ
+   */
+  virtual bool isGreater(TermList lS, TermList rS) const = 0;
+};
+
 // orderings that rely on symbol precedence
 class PrecedenceOrdering
 : public Ordering
@@ -32,6 +32,9 @@
 
 #include <cstring>
 #include <cstdlib>
+#if THREAD_SAFE_ALLOCATION
+#include <mutex>
+#endif
 #include "Lib/System.hpp"
 #include "Shell/UIHelper.hpp"
 
@@ -94,14 +97,37 @@ unsigned watchAddressLastValue = 0;
 using namespace Lib;
 using namespace Shell;
 
+#if THREAD_SAFE_ALLOCATION
+/** Protects the global page manager and the list of allocators */
+static std::mutex pageLock;
+# define PAGE_LOCK std::lock_guard<std::mutex> pageLockGuard(pageLock)
+# if VDEBUG
+/** Protects the descriptors, it is always taken before @b pageLock */
+static std::mutex descriptorLock;
+#  define DESCRIPTOR_LOCK std::lock_guard<std::mutex> descriptorLockGuard(descriptorLock)
+# else
+#  define DESCRIPTOR_LOCK
+# endif
+#else
+# define PAGE_LOCK
+# define DESCRIPTOR_LOCK
+#endif
+
 int Allocator::_initialised = 0;
 int Allocator::_total = 0;
 size_t Allocator::_memoryLimit;
 size_t Allocator::_tolerated;
-Allocator* Allocator::current;
 Allocator::Page* Allocator::_pages[MAX_PAGES];
 size_t Allocator::_usedMemory = 0;
 Allocator* Allocator::_all[MAX_ALLOCATORS];
+#if THREAD_SAFE_ALLOCATION
+thread_local Allocator* Allocator::current;
+Allocator* Allocator::_idle[MAX_ALLOCATORS];
+int Allocator::_idleCount = 0;
+Allocator::Page* Allocator::_myPages = 0;
+#else
+Allocator* Allocator::current;
+#endif
 
 #if VDEBUG
 unsigned Allocator::Descriptor::globalTimestamp;
@@ -156,8 +182,10 @@ Allocator::Allocator()
   }
   _reserveBytesAvailable = 0;
   _nextAvailableReserve = 0;
+#if ! THREAD_SAFE_ALLOCATION
   _myPages = 0;
 #endif
+#endif
 } // Allocator::Allocator
 
 /**
@@ -174,6 +202,44 @@ Lib::Allocator::~Allocator ()
   }
 } // Allocator::~allocator
 
+#if THREAD_SAFE_ALLOCATION
+/**
+ * Make the allocator of a finished thread, or a new allocator,
+ * the current allocator of this thread.
+ */
+Allocator::ThreadInitialiser::ThreadInitialiser()
+{
+  CALLC("Allocator::ThreadInitialiser::ThreadInitialiser",MAKE_CALLS);
+  ASS(!current);
+
+#if ! USE_SYSTEM_ALLOCATION
+  PAGE_LOCK;
+  if (_idleCount) {
+    current = _idle[--_idleCount];
+  }
+  else {
+    current = newAllocator();
+  }
+#endif
+} // ThreadInitialiser::ThreadInitialiser
+
+/**
+ * Keep the allocator of this thread for a thread created later. The
+ * free lists of the allocator remain valid, as the pages never leave
+ * the global manager.
+ */
+Allocator::ThreadInitialiser::~ThreadInitialiser()
+{
+  CALLC("Allocator::ThreadInitialiser::~ThreadInitialiser",MAKE_CALLS);
+
+#if ! USE_SYSTEM_ALLOCATION
+  PAGE_LOCK;
+  _idle[_idleCount++] = current;
+  current = 0;
+#endif
+} // ThreadInitialiser::~ThreadInitialiser
+#endif
+
 /**
  * Initialise all static structures and create a default allocator.
  * @since 10/01/2008 Manchester
@@ -350,6 +416,7 @@ void Allocator::deallocateKnown(void* obj,size_t size)
 #endif
 {
   CALLC("Allocator::deallocateKnown",MAKE_CALLS);
+  DESCRIPTOR_LOCK;
   ASS(obj);
 
 #if VDEBUG
@@ -424,6 +491,7 @@ void Allocator::deallocateUnknown(void* obj)
 #endif
 {
   CALLC("Allocator::deallocateUnknown",MAKE_CALLS);
+  DESCRIPTOR_LOCK;
 
 #if VDEBUG
   Descriptor* desc = Descriptor::find(obj);
@@ -568,6 +636,7 @@ Allocator::Page* Allocator::allocatePages(size_t size)
 #else
   size += PAGE_PREFIX_SIZE;
 
+  PAGE_LOCK;
   Page* result;
   size_t index = (size-1)/VPAGE_SIZE;
   size_t realSize = VPAGE_SIZE*(index+1);
@@ -701,6 +770,7 @@ void Allocator::deallocatePages(Page* page)
   ASSERTION_VIOLATION;
 #else
   CALLC("Allocator::deallocatePages",MAKE_CALLS);
+  PAGE_LOCK;
 
 #if VDEBUG
   Descriptor* desc = Descriptor::find(page);
@@ -770,6 +840,7 @@ void* Allocator::allocateKnown(size_t size)
 #endif
 {
   CALLC("Allocator::allocateKnown",MAKE_CALLS);
+  DESCRIPTOR_LOCK;
   ASS(size > 0);
 
   char* result = allocatePiece(size);
@@ -891,6 +962,7 @@ void* Allocator::allocateUnknown(size_t size)
 #endif
 {
   CALLC("Allocator::allocateUnknown",MAKE_CALLS);
+  DESCRIPTOR_LOCK;
   ASS(size>0);
 
   size += sizeof(Known);
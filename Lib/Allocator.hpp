@@ -43,6 +43,13 @@
 
 #define USE_PRECISE_CLASS_NAMES 0
 
+#ifndef THREAD_SAFE_ALLOCATION
+/** If set to 1, each thread allocates through an allocator of its own
+ *  and the global page manager is protected by a lock, see
+ *  Allocator::ThreadInitialiser */
+#define THREAD_SAFE_ALLOCATION 0
+#endif
+
 /** Page size in bytes */
 #define VPAGE_SIZE 131000
 /** maximal size of allocated multi-page (in pages) */
@@ -99,7 +106,11 @@ public:
   }
   /** The current allocator
    * - through which allocations by the here defined macros are channelled */
+#if THREAD_SAFE_ALLOCATION
+  static thread_local Allocator* current;
+#else
   static Allocator* current;
+#endif
 
 #if VDEBUG
   void* allocateKnown(size_t size,const char* className) ALLOC_SIZE_ATTR;
@@ -138,6 +149,24 @@ public:
     }
   }; // class Allocator::Initialiser
 
+#if THREAD_SAFE_ALLOCATION
+  /**
+   * Provides the thread creating it with an allocator of its own. Each
+   * thread other than the main one must create an instance before it
+   * allocates memory. When the instance is destroyed, the allocator is
+   * kept for the next thread, since other threads may still use the
+   * memory allocated through it.
+   *
+   * Pieces of memory may be deallocated by any thread, they are then
+   * put in the free lists of the deallocating thread.
+   */
+  class ThreadInitialiser {
+  public:
+    ThreadInitialiser();
+    ~ThreadInitialiser();
+  }; // class Allocator::ThreadInitialiser
+#endif
+
   static Allocator* newAllocator();
 
 private:
@@ -154,6 +183,12 @@ private:
   static int _total;
   /** > 0 if the global page manager has been initialised */
   static int _initialised;
+#if THREAD_SAFE_ALLOCATION
+  /** Allocators of threads that have finished */
+  static Allocator* _idle[MAX_ALLOCATORS];
+  /** Number of allocators in @b _idle */
+  static int _idleCount;
+#endif
 
   /**
    * A piece of memory whose size is known by procedures de-allocating
@@ -300,9 +335,17 @@ private:
    * Note that, essentially, sizeof(Known) = sizeof(void*).
    */
   Known* _freeList[REQUIRES_PAGE/4];
+#if THREAD_SAFE_ALLOCATION
+  /** All pages allocated by the allocators and not returned to the
+   *  global manager via deallocatePages (doubly linked). The list is shared,
+   *  since a page may be deallocated by another thread than the one
+   *  that allocated it.  */
+  static Page* _myPages;
+#else
   /** All pages allocated by this allocator and not returned to 
    *  the global manager via deallocatePages (doubly linked).  */
   Page* _myPages;
+#endif
   /** Number of bytes available on the reserve page */
   size_t _reserveBytesAvailable;
   /** next available known */
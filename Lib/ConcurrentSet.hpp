@@ -0,0 +1,313 @@
+
+/*
+ * File ConcurrentSet.hpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions.
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide.
+ */
+/**
+ * @file ConcurrentSet.hpp
+ * Defines class ConcurrentSet<Val,Hash> of sets of pointers that can be
+ * searched and extended by several threads at the same time.
+ */
+
+#ifndef __ConcurrentSet__
+#define __ConcurrentSet__
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <thread>
+
+#include "Forwards.hpp"
+
+#include "Allocator.hpp"
+#include "Reflection.hpp"
+
+namespace Lib {
+
+/**
+ * Set of pointers with a lock-free insert-or-find operation.
+ *
+ * The interface is a subset of that of Set<Val,Hash>: Hash has to provide
+ * Hash::hash(Val) and Hash::equals(Val,Val) (and Hash::hash(Key),
+ * Hash::equals(Val,Key) for find()). Elements cannot be removed.
+ *
+ * The set is an open-addressing table with linear probing. A value is
+ * published by a single compare-and-swap on an empty cell, so everything
+ * the inserting thread wrote to the object before calling insert() is
+ * visible to the threads that find the object. Hash codes are stored next
+ * to the values to avoid calling Hash::equals on most of the collisions.
+ *
+ * When the table gets half full, the thread that made it so copies the
+ * content to a table of twice the size. Copied cells are overwritten by
+ * a marker, and threads that run into the marker wait until the new table
+ * is installed. Replaced tables are only freed with the set, as other
+ * threads may still be reading them.
+ *
+ * The tables are allocated by malloc and the methods that can run
+ * concurrently do not use CALL, since neither the Allocator nor the tracer
+ * are thread-safe. Iteration and destruction must not overlap with other
+ * operations.
+ */
+template <typename Val,class Hash>
+class ConcurrentSet
+{
+  struct Table;
+public:
+  CLASS_NAME(ConcurrentSet);
+  USE_ALLOCATOR(ConcurrentSet);
+
+  /** Create a new set, @b initialCapacity must be a power of two */
+  explicit ConcurrentSet(size_t initialCapacity=1024)
+    : _size(0), _resizing(false)
+  {
+    CALL("ConcurrentSet::ConcurrentSet");
+    ASS_EQ(initialCapacity & (initialCapacity-1), 0);
+
+    _table.store(Table::create(initialCapacity, 0), std::memory_order_relaxed);
+  }
+
+  ~ConcurrentSet()
+  {
+    CALL("ConcurrentSet::~ConcurrentSet");
+
+    Table* table = _table.load(std::memory_order_relaxed);
+    while (table) {
+      Table* previous = table->previous;
+      Table::destroy(table);
+      table = previous;
+    }
+  }
+
+  /** Number of elements in the set */
+  size_t size() const
+  { return _size.load(std::memory_order_relaxed); }
+
+  /**
+   * If the set contains a value equal to @b key, return true
+   * and assign the value to @b result.
+   */
+  template<typename Key>
+  bool find(Key key, Val& result) const
+  {
+    unsigned code = codeOf(Hash::hash(key));
+    for (;;) {
+      Table* table = _table.load(std::memory_order_acquire);
+      size_t mask = table->capacity-1;
+      for (size_t idx = code & mask; ; idx = (idx+1) & mask) {
+        Val cur = table->values[idx].load(std::memory_order_acquire);
+        if (!cur) {
+          return false;
+        }
+        if (cur==moved()) {
+          break;
+        }
+        if (sameCode(table, idx, code) && Hash::equals(cur, key)) {
+          result = cur;
+          return true;
+        }
+      }
+      waitForResize(table);
+    }
+  }
+
+  /**
+   * If a value equal to @b val is not contained in the set, insert @b val
+   * in the set. Return the value equal to @b val from the set.
+   */
+  Val insert(Val val)
+  {
+    ASS(val);
+    ASS_NEQ(val, moved());
+
+    unsigned code = codeOf(Hash::hash(val));
+    for (;;) {
+      Table* table = _table.load(std::memory_order_acquire);
+      size_t mask = table->capacity-1;
+      for (size_t idx = code & mask; ; idx = (idx+1) & mask) {
+        Val cur = table->values[idx].load(std::memory_order_acquire);
+        if (!cur) {
+          if (table->values[idx].compare_exchange_strong(cur, val, std::memory_order_acq_rel,
+                std::memory_order_acquire)) {
+            table->codes[idx].store(code, std::memory_order_release);
+            size_t newSize = _size.fetch_add(1, std::memory_order_relaxed)+1;
+            if (2*newSize > table->capacity) {
+              tryResize(table);
+            }
+            return val;
+          }
+          // someone else got the cell first, cur now contains their value
+        }
+        if (cur==moved()) {
+          break;
+        }
+        if (sameCode(table, idx, code) && Hash::equals(cur, val)) {
+          return cur;
+        }
+      }
+      waitForResize(table);
+    }
+  }
+
+  /**
+   * Iterator over the elements of the set. The set must not be
+   * modified during the iteration.
+   */
+  class Iterator {
+  public:
+    DECL_ELEMENT_TYPE(Val);
+
+    explicit Iterator(const ConcurrentSet& set)
+      : _table(set._table.load(std::memory_order_acquire)), _idx(0) {}
+
+    bool hasNext()
+    {
+      while (_idx<_table->capacity) {
+        if (_table->values[_idx].load(std::memory_order_relaxed)) {
+          return true;
+        }
+        _idx++;
+      }
+      return false;
+    }
+
+    Val next()
+    {
+      ASS_L(_idx, _table->capacity);
+      return _table->values[_idx++].load(std::memory_order_relaxed);
+    }
+  private:
+    Table* _table;
+    size_t _idx;
+  };
+
+private:
+  struct Table {
+    /** Number of cells, a power of two */
+    size_t capacity;
+    /** The values, null for empty cells */
+    std::atomic<Val>* values;
+    /** Hash codes of the values, zero if not written yet */
+    std::atomic<unsigned>* codes;
+    /** The table that was replaced by this one */
+    Table* previous;
+
+    static Table* create(size_t capacity, Table* previous)
+    {
+      Table* res = static_cast<Table*>(malloc(sizeof(Table)));
+      void* values = calloc(capacity, sizeof(std::atomic<Val>));
+      void* codes = calloc(capacity, sizeof(std::atomic<unsigned>));
+      if (!res || !values || !codes) {
+        throw std::bad_alloc();
+      }
+      res->capacity = capacity;
+      res->values = static_cast<std::atomic<Val>*>(values);
+      res->codes = static_cast<std::atomic<unsigned>*>(codes);
+      res->previous = previous;
+      return res;
+    }
+
+    static void destroy(Table* table)
+    {
+      free(table->values);
+      free(table->codes);
+      free(table);
+    }
+  };
+
+  /** Marker of cells whose content was copied to a larger table */
+  static Val moved()
+  { return reinterpret_cast<Val>(static_cast<size_t>(1)); }
+
+  /** Zero is reserved for hash codes that were not written yet */
+  static unsigned codeOf(unsigned hash)
+  { return hash ? hash : 1; }
+
+  /**
+   * False if the value in the cell @b idx certainly has a hash code
+   * different from @b code.
+   */
+  static bool sameCode(Table* table, size_t idx, unsigned code)
+  {
+    unsigned stored = table->codes[idx].load(std::memory_order_acquire);
+    return !stored || stored==code;
+  }
+
+  /** Wait until the table @b table is no longer the current one */
+  void waitForResize(Table* table) const
+  {
+    while (_table.load(std::memory_order_acquire)==table) {
+      std::this_thread::yield();
+    }
+  }
+
+  /**
+   * Move the content of @b table into a table of twice the size,
+   * unless another thread is already doing it.
+   */
+  void tryResize(Table* table)
+  {
+    if (_table.load(std::memory_order_acquire)!=table || _resizing.exchange(true, std::memory_order_acquire)) {
+      return;
+    }
+    if (_table.load(std::memory_order_acquire)!=table) {
+      // the table was replaced while we were getting the flag
+      _resizing.store(false, std::memory_order_release);
+      return;
+    }
+
+    Table* newTable = Table::create(2*table->capacity, table);
+    size_t newMask = newTable->capacity-1;
+    for (size_t idx = 0; idx<table->capacity; idx++) {
+      Val cur = table->values[idx].load(std::memory_order_acquire);
+      while (!cur) {
+        if (table->values[idx].compare_exchange_strong(cur, moved(), std::memory_order_acq_rel,
+              std::memory_order_acquire)) {
+          break;
+        }
+      }
+      if (!cur) {
+        continue;
+      }
+      unsigned code = table->codes[idx].load(std::memory_order_acquire);
+      if (!code) {
+        // the inserting thread has not stored the code yet
+        code = codeOf(Hash::hash(cur));
+      }
+      table->values[idx].store(moved(), std::memory_order_release);
+
+      // no other thread writes into the new table before it is installed
+      size_t newIdx = code & newMask;
+      while (newTable->values[newIdx].load(std::memory_order_relaxed)) {
+        newIdx = (newIdx+1) & newMask;
+      }
+      newTable->values[newIdx].store(cur, std::memory_order_relaxed);
+      newTable->codes[newIdx].store(code, std::memory_order_relaxed);
+    }
+    _table.store(newTable, std::memory_order_release);
+    _resizing.store(false, std::memory_order_release);
+  }
+
+  /** The current table */
+  std::atomic<Table*> _table;
+  /** Number of elements */
+  std::atomic<size_t> _size;
+  /** True while a thread is moving the elements into a larger table */
+  std::atomic<bool> _resizing;
+}; // class ConcurrentSet
+
+}
+
+#endif // __ConcurrentSet__
@@ -225,6 +225,9 @@ void TimeCounter::outputSingleStat(TimeCounterUnit tcu, ostream& out)
   case Lib::TimeCounterUnit::TC_FORWARD_DEMODULATION:
     out<<"forward demodulation";
     break;
+  case Lib::TimeCounterUnit::TC_FORWARD_SIMPLIFICATION:
+    out<<"forward simplification";
+    break;
   case Lib::TimeCounterUnit::TC_FORWARD_SUBSUMPTION:
     out<<"forward subsumption";
     break;
@@ -65,6 +65,7 @@ enum class TimeCounterUnit
   TC_CONDENSATION,
   TC_INTERPRETED_EVALUATION,
   TC_INTERPRETED_SIMPLIFICATION,
+  TC_FORWARD_SIMPLIFICATION,
   TC_FORWARD_SUBSUMPTION,
   TC_FORWARD_SUBSUMPTION_RESOLUTION,
   TC_BACKWARD_SUBSUMPTION,
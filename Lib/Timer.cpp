@@ -120,7 +120,8 @@ timer_sigalrm_handler (int sig)
 
   timer_sigalrm_counter++;
 
-  if(Timer::s_timeLimitEnforcement && env.timeLimitReached()) {
+  // the first ticks can come before the Environment constructor has stored the timer
+  if(Timer::s_timeLimitEnforcement && env.timer && env.timeLimitReached()) {
     timeLimitReached();
   }
 
@@ -0,0 +1,1205 @@
+/*
+ * File CDCLSolver.cpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions.
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide.
+ */
+/**
+ * @file CDCLSolver.cpp
+ * Implements class CDCLSolver.
+ */
+
+#include <algorithm>
+#include <functional>
+#include <utility>
+
+#include "Shell/Options.hpp"
+
+#include "CDCLSolver.hpp"
+
+namespace SAT
+{
+
+using namespace std;
+
+const CDCLSolver::ClauseRef CDCLSolver::NO_REASON;
+const double CDCLSolver::VAR_DECAY = 0.95;
+
+/** backjumps over more levels than this backtrack chronologically instead */
+static const unsigned CHRONO_THRESHOLD = 100;
+
+/** restart when the fast LBD average exceeds the slow one by this factor */
+static const double RESTART_MARGIN = 1.1;
+static const unsigned RESTART_MIN_CONFLICTS = 50;
+/** but not when the trail is this much longer than usual (glucose blocking) */
+static const double RESTART_BLOCK_MARGIN = 1.4;
+static const unsigned RESTART_BLOCK_MIN_CONFLICTS = 10000;
+
+/** learnt clauses with LBD up to this value are never reduced */
+static const unsigned CORE_LBD = 2;
+static const unsigned REDUCE_BASE = 2000;
+static const unsigned REDUCE_INCREMENT = 300;
+
+static const unsigned INPROCESS_BASE = 5000;
+/** subsumption checks only clauses up to this size */
+static const unsigned SUBSUME_MAX_SIZE = 64;
+static const unsigned long SUBSUME_EFFORT = 10000000;
+static const unsigned long VIVIFY_MIN_EFFORT = 10000;
+
+CDCLSolver::CDCLSolver(const Options& opts, bool generateProofs)
+: _varCnt(0), _status(Status::SATISFIABLE), _unsat(false), _wasted(0),
+  _varInc(1), _heap(ActivityComparator(_activity)), _propagated(0), _stamp(0),
+  _ignored(NO_REASON), _fastLbd(0.03), _slowLbd(1e-5), _trailSize(1e-5),
+  _conflictsAtRestart(0), _nextReduce(REDUCE_BASE), _reductions(0),
+  _nextInprocess(INPROCESS_BASE), _inprocessings(0), _propagationsAtInprocess(0),
+  _simplifiedAt(0), _conflicts(0), _decisions(0), _propagations(0), _restarts(0),
+  _chronoBacktracks(0), _learntLits(0), _minimizedLits(0), _reducedClauses(0),
+  _subsumedClauses(0), _vivifiedClauses(0)
+{
+  CALL("CDCLSolver::CDCLSolver");
+
+  // slots for the unused variable 0
+  ensureVarCount(0);
+}
+
+/**
+ * Make the solver handle clauses with variables up to @b newVarCnt
+ */
+void CDCLSolver::ensureVarCount(unsigned newVarCnt)
+{
+  CALL("CDCLSolver::ensureVarCount");
+
+  if (newVarCnt < _varCnt) {
+    return;
+  }
+
+  _values.expand(2*(newVarCnt+1), 0);
+  _watches.expand(2*(newVarCnt+1));
+  _level.expand(newVarCnt+1, 0);
+  _reason.expand(newVarCnt+1, NO_REASON);
+  _phase.expand(newVarCnt+1, 0);
+  _seen.expand(newVarCnt+1, 0);
+  _activity.expand(newVarCnt+1, 0);
+  _heap.elMap().expand(newVarCnt+1);
+
+  for (unsigned v = _varCnt+1; v <= newVarCnt; v++) {
+    _heap.insert(v);
+  }
+  _varCnt = newVarCnt;
+}
+
+unsigned CDCLSolver::newVar()
+{
+  CALL("CDCLSolver::newVar");
+
+  ensureVarCount(_varCnt+1);
+  return _varCnt;
+}
+
+/**
+ * Copy the literals @b lits into the arena as a new clause.
+ */
+CDCLSolver::ClauseRef CDCLSolver::allocClause(const Stack<unsigned>& lits, bool learnt, unsigned lbd)
+{
+  CALL("CDCLSolver::allocClause");
+  ASS_GE(lits.size(),2);
+
+  ClauseRef cr = _arena.size();
+  _arena.push(lits.size());
+  _arena.push((learnt ? FLAG_LEARNT : 0) | (lbd << LBD_SHIFT));
+  _arena.push(0);
+  for (unsigned i = 0; i < lits.size(); i++) {
+    _arena.push(lits[i]);
+  }
+  return cr;
+}
+
+void CDCLSolver::attachClause(ClauseRef cr)
+{
+  CALL("CDCLSolver::attachClause");
+
+  unsigned* lits = clauseLits(cr);
+  bool binary = clauseSize(cr) == 2;
+  _watches[lits[0]].push(Watch(lits[1], cr, binary));
+  _watches[lits[1]].push(Watch(lits[0], cr, binary));
+}
+
+void CDCLSolver::removeWatch(unsigned lit, ClauseRef cr)
+{
+  CALL("CDCLSolver::removeWatch");
+
+  WatchStack& ws = _watches[lit];
+  for (unsigned i = 0; i < ws.size(); i++) {
+    if (ws[i].cref == cr) {
+      ws[i] = ws.top();
+      ws.pop();
+      return;
+    }
+  }
+  ASSERTION_VIOLATION;
+}
+
+/**
+ * Let the literals at positions @b pos0 and @b pos1 of @b cr be the watched ones.
+ */
+void CDCLSolver::rewatch(ClauseRef cr, unsigned pos0, unsigned pos1)
+{
+  CALL("CDCLSolver::rewatch");
+  ASS_NEQ(pos0,pos1);
+
+  unsigned* lits = clauseLits(cr);
+  removeWatch(lits[0], cr);
+  removeWatch(lits[1], cr);
+  std::swap(lits[0], lits[pos0]);
+  if (pos1 == 0) {
+    pos1 = pos0;
+  }
+  std::swap(lits[1], lits[pos1]);
+  attachClause(cr);
+}
+
+/**
+ * Return true if @b cr is the reason of an assignment above level 0
+ * (reasons at level 0 are never looked at and so can be deleted)
+ */
+bool CDCLSolver::locked(ClauseRef cr)
+{
+  unsigned lit = clauseLits(cr)[0];
+  return val(lit) > 0 && _reason[var(lit)] == cr && _level[var(lit)] > 0;
+}
+
+void CDCLSolver::markGarbage(ClauseRef cr)
+{
+  CALL("CDCLSolver::markGarbage");
+  ASS(!isGarbage(cr));
+
+  setFlag(cr, FLAG_GARBAGE);
+  _wasted += HEADER_SIZE+clauseSize(cr);
+}
+
+/**
+ * Compact the arena and rebuild the watch lists.
+ */
+void CDCLSolver::collectGarbage()
+{
+  CALL("CDCLSolver::collectGarbage");
+
+  if (!_wasted) {
+    return;
+  }
+
+  ClauseRef end = _arena.size();
+  ClauseRef to = 0;
+  for (ClauseRef cr = 0; cr < end; cr = nextClause(cr)) {
+    if (!isGarbage(cr)) {
+      _arena[cr+2] = to;
+      to += HEADER_SIZE+clauseSize(cr);
+    }
+  }
+
+  for (unsigned i = 0; i < _trail.size(); i++) {
+    unsigned v = var(_trail[i]);
+    ClauseRef r = _reason[v];
+    if (r == NO_REASON) {
+      continue;
+    }
+    if (isGarbage(r)) {
+      ASS_EQ(_level[v],0);
+      _reason[v] = NO_REASON;
+    } else {
+      _reason[v] = _arena[r+2];
+    }
+  }
+
+  for (unsigned lit = 2; lit < _watches.size(); lit++) {
+    _watches[lit].reset();
+  }
+
+  to = 0;
+  ClauseRef cr = 0;
+  while (cr < end) {
+    ClauseRef next = nextClause(cr);
+    if (!isGarbage(cr)) {
+      unsigned len = HEADER_SIZE+clauseSize(cr);
+      for (unsigned k = 0; k < len; k++) {
+        _arena[to+k] = _arena[cr+k];
+      }
+      attachClause(to);
+      to += len;
+    }
+    cr = next;
+  }
+  _arena.truncate(to);
+  _wasted = 0;
+}
+
+/**
+ * Add clause into the solver.
+ */
+void CDCLSolver::addClause(SATClause* cl)
+{
+  CALL("CDCLSolver::addClause");
+
+  // store to later generate the refutation
+  PrimitiveProofRecordingSATSolver::addClause(cl);
+
+  if (_unsat) {
+    return;
+  }
+  backtrack(0);
+
+  _clauseLits.reset();
+  unsigned clen = cl->length();
+  for (unsigned i = 0; i < clen; i++) {
+    unsigned lit = (*cl)[i].content();
+    ASS_G(var(lit),0); ASS_LE(var(lit),_varCnt);
+    if (val(lit) > 0) {
+      return;
+    }
+    if (val(lit) == 0) {
+      _clauseLits.push(lit);
+    }
+  }
+
+  if (_clauseLits.isEmpty()) {
+    _unsat = true;
+  } else if (_clauseLits.size() == 1) {
+    assign(_clauseLits[0], 0, NO_REASON);
+    if (propagate() != NO_REASON) {
+      _unsat = true;
+    }
+  } else {
+    attachClause(allocClause(_clauseLits, false, 0));
+  }
+}
+
+void CDCLSolver::assign(unsigned lit, unsigned lvl, ClauseRef reason)
+{
+  ASS_EQ(val(lit),0);
+
+  unsigned v = var(lit);
+  _values[lit] = 1;
+  _values[lit^1] = -1;
+  _level[v] = lvl;
+  _reason[v] = reason;
+  _trail.push(lit);
+}
+
+/**
+ * Undo all assignments above level @b lvl.
+ *
+ * Because of chronological backtracking, the trail may contain literals
+ * of lower levels among the undone ones. These stay assigned and are
+ * propagated again.
+ */
+void CDCLSolver::backtrack(unsigned lvl)
+{
+  CALL("CDCLSolver::backtrack");
+
+  if (decisionLevel() <= lvl) {
+    return;
+  }
+
+  unsigned start = _control[lvl];
+  unsigned j = start;
+  for (unsigned i = start; i < _trail.size(); i++) {
+    unsigned lit = _trail[i];
+    unsigned v = var(lit);
+    if (_level[v] > lvl) {
+      _values[lit] = 0;
+      _values[lit^1] = 0;
+      _reason[v] = NO_REASON;
+      _phase[v] = lit & 1;
+      if (!_heap.contains(v)) {
+        _heap.insert(v);
+      }
+    } else {
+      _trail[j++] = lit;
+    }
+  }
+  _trail.truncate(j);
+  _control.truncate(lvl);
+  if (_propagated > start) {
+    _propagated = start;
+  }
+}
+
+/**
+ * Propagate the assignments on the trail and return a conflicting clause
+ * (or NO_REASON).
+ *
+ * An implied literal gets the highest level of the other literals of its
+ * reason, which need not be the current decision level.
+ */
+CDCLSolver::ClauseRef CDCLSolver::propagate()
+{
+  CALL("CDCLSolver::propagate");
+
+  ClauseRef conflict = NO_REASON;
+  while (_propagated < _trail.size()) {
+    unsigned falseLit = _trail[_propagated++]^1;
+    unsigned falseLevel = level(falseLit);
+    _propagations++;
+
+    WatchStack& ws = _watches[falseLit];
+    Watch* i = ws.begin();
+    Watch* j = i;
+    Watch* end = ws.end();
+    while (i != end) {
+      Watch w = *i++;
+      signed char blockerVal = val(w.blocker);
+      if (blockerVal > 0) {
+        *j++ = w;
+        continue;
+      }
+      if (w.binary) {
+        *j++ = w;
+        if (blockerVal < 0) {
+          conflict = w.cref;
+          break;
+        }
+        unsigned* lits = clauseLits(w.cref);
+        lits[0] = w.blocker;
+        lits[1] = falseLit;
+        assign(w.blocker, falseLevel, w.cref);
+        continue;
+      }
+      ClauseRef cr = w.cref;
+      if (cr == _ignored) {
+        *j++ = w;
+        continue;
+      }
+      unsigned* lits = clauseLits(cr);
+      if (lits[0] == falseLit) {
+        lits[0] = lits[1];
+        lits[1] = falseLit;
+      }
+      ASS_EQ(lits[1],falseLit);
+
+      unsigned first = lits[0];
+      signed char firstVal = val(first);
+      if (first != w.blocker && firstVal > 0) {
+        *j++ = Watch(first, cr, false);
+        continue;
+      }
+
+      unsigned size = clauseSize(cr);
+      unsigned maxLevel = falseLevel;
+      unsigned k = 2;
+      for (; k < size; k++) {
+        unsigned lit = lits[k];
+        if (val(lit) >= 0) {
+          break;
+        }
+        maxLevel = std::max(maxLevel, level(lit));
+      }
+      if (k < size) {
+        lits[1] = lits[k];
+        lits[k] = falseLit;
+        _watches[lits[1]].push(Watch(first, cr, false));
+        continue;
+      }
+
+      *j++ = Watch(first, cr, false);
+      if (firstVal < 0) {
+        conflict = cr;
+        break;
+      }
+      assign(first, maxLevel, cr);
+    }
+    while (i != end) {
+      *j++ = *i++;
+    }
+    ws.truncate(j-ws.begin());
+
+    if (conflict != NO_REASON) {
+      break;
+    }
+  }
+  return conflict;
+}
+
+void CDCLSolver::bumpVariable(unsigned v)
+{
+  if ((_activity[v] += _varInc) > 1e100) {
+    for (unsigned u = 1; u <= _varCnt; u++) {
+      _activity[u] *= 1e-100;
+    }
+    _varInc *= 1e-100;
+  }
+  if (_heap.contains(v)) {
+    _heap.notifyDecrease(v);
+  }
+}
+
+/**
+ * Note that learnt clause @b cr took part in a conflict analysis and
+ * improve its LBD if possible.
+ */
+void CDCLSolver::bumpClause(ClauseRef cr)
+{
+  if (!isLearnt(cr)) {
+    return;
+  }
+  setFlag(cr, FLAG_USED);
+  unsigned lbd = clauseLbd(cr);
+  if (lbd > CORE_LBD) {
+    unsigned newLbd = computeLbd(clauseLits(cr), clauseSize(cr));
+    if (newLbd < lbd) {
+      setClauseLbd(cr, newLbd);
+    }
+  }
+}
+
+/**
+ * Return the number of distinct decision levels among @b lits.
+ */
+unsigned CDCLSolver::computeLbd(const unsigned* lits, unsigned size)
+{
+  if (_levelStamp.size() <= decisionLevel()) {
+    _levelStamp.expand(decisionLevel()+1, 0);
+  }
+  _stamp++;
+  unsigned res = 0;
+  for (unsigned i = 0; i < size; i++) {
+    unsigned lvl = level(lits[i]);
+    if (_levelStamp[lvl] != _stamp) {
+      _levelStamp[lvl] = _stamp;
+      res++;
+    }
+  }
+  return res;
+}
+
+/**
+ * Return true if @b lit of the learnt clause is implied by the other literals
+ * of the clause and so can be removed (the recursive minimisation of MiniSat).
+ */
+bool CDCLSolver::litRedundant(unsigned lit, unsigned abstractLevels)
+{
+  CALL("CDCLSolver::litRedundant");
+
+  _analyzeStack.reset();
+  _analyzeStack.push(lit);
+  unsigned top = _toClear.size();
+  while (_analyzeStack.isNonEmpty()) {
+    ClauseRef cr = _reason[var(_analyzeStack.pop())];
+    ASS_NEQ(cr,NO_REASON);
+    unsigned* lits = clauseLits(cr);
+    unsigned size = clauseSize(cr);
+    for (unsigned k = 1; k < size; k++) {
+      unsigned q = lits[k];
+      unsigned v = var(q);
+      if (_seen[v] || !_level[v]) {
+        continue;
+      }
+      if (_reason[v] != NO_REASON && (abstractLevel(v) & abstractLevels)) {
+        _seen[v] = 1;
+        _analyzeStack.push(q);
+        _toClear.push(q);
+      } else {
+        for (unsigned i = top; i < _toClear.size(); i++) {
+          _seen[var(_toClear[i])] = 0;
+        }
+        _toClear.truncate(top);
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+/**
+ * Analyse @b conflict, learn a clause and backtrack, so that propagation
+ * can continue. Return false if the conflict does not depend on any
+ * decision.
+ */
+bool CDCLSolver::analyze(ClauseRef conflict)
+{
+  CALL("CDCLSolver::analyze");
+
+  unsigned* lits = clauseLits(conflict);
+  unsigned size = clauseSize(conflict);
+  unsigned conflictLevel = 0;
+  unsigned count = 0;
+  unsigned forcedPos = 0;
+  for (unsigned k = 0; k < size; k++) {
+    unsigned lvl = level(lits[k]);
+    if (lvl > conflictLevel) {
+      conflictLevel = lvl;
+      count = 1;
+      forcedPos = k;
+    } else if (lvl == conflictLevel) {
+      count++;
+    }
+  }
+  if (conflictLevel == 0) {
+    return false;
+  }
+
+  if (count == 1) {
+    // the clause became unit below the level where it was noticed
+    // (possible after chronological backtracking), assign the literal properly
+    unsigned secondPos = forcedPos ? 0 : 1;
+    for (unsigned k = 0; k < size; k++) {
+      if (k != forcedPos && level(lits[k]) > level(lits[secondPos])) {
+        secondPos = k;
+      }
+    }
+    unsigned forced = lits[forcedPos];
+    unsigned secondLevel = level(lits[secondPos]);
+    backtrack(conflictLevel-1);
+    rewatch(conflict, forcedPos, secondPos);
+    assign(forced, secondLevel, conflict);
+    return true;
+  }
+
+  backtrack(conflictLevel);
+
+  // first UIP
+  _learnt.reset();
+  _learnt.push(0);
+  unsigned pathCount = 0;
+  unsigned index = _trail.size();
+  unsigned uip = 0;
+  ClauseRef cr = conflict;
+  do {
+    ASS_NEQ(cr,NO_REASON);
+    bumpClause(cr);
+    lits = clauseLits(cr);
+    size = clauseSize(cr);
+    for (unsigned k = (cr == conflict) ? 0 : 1; k < size; k++) {
+      unsigned q = lits[k];
+      unsigned v = var(q);
+      if (_seen[v] || !_level[v]) {
+        continue;
+      }
+      _seen[v] = 1;
+      bumpVariable(v);
+      if (_level[v] == conflictLevel) {
+        pathCount++;
+      } else {
+        _learnt.push(q);
+      }
+    }
+    do {
+      index--;
+    } while (!_seen[var(_trail[index])] || _level[var(_trail[index])] != conflictLevel);
+    uip = _trail[index];
+    cr = _reason[var(uip)];
+    _seen[var(uip)] = 0;
+    pathCount--;
+  } while (pathCount > 0);
+  _learnt[0] = uip^1;
+
+  // minimisation
+  _toClear.reset();
+  unsigned abstractLevels = 0;
+  for (unsigned i = 1; i < _learnt.size(); i++) {
+    _toClear.push(_learnt[i]);
+    abstractLevels |= abstractLevel(var(_learnt[i]));
+  }
+  unsigned j = 1;
+  for (unsigned i = 1; i < _learnt.size(); i++) {
+    unsigned q = _learnt[i];
+    if (_reason[var(q)] == NO_REASON || !litRedundant(q, abstractLevels)) {
+      _learnt[j++] = q;
+    }
+  }
+  _minimizedLits += _learnt.size()-j;
+  _learnt.truncate(j);
+  _learntLits += j;
+  for (unsigned i = 0; i < _toClear.size(); i++) {
+    _seen[var(_toClear[i])] = 0;
+  }
+
+  // the literal with the highest level will be the second watch
+  unsigned backjumpLevel = 0;
+  if (_learnt.size() > 1) {
+    unsigned maxPos = 1;
+    for (unsigned i = 2; i < _learnt.size(); i++) {
+      if (level(_learnt[i]) > level(_learnt[maxPos])) {
+        maxPos = i;
+      }
+    }
+    std::swap(_learnt[1], _learnt[maxPos]);
+    backjumpLevel = level(_learnt[1]);
+  }
+
+  unsigned lbd = computeLbd(_learnt.begin(), _learnt.size());
+  _fastLbd.update(lbd);
+  _slowLbd.update(lbd);
+
+  if (conflictLevel-backjumpLevel > CHRONO_THRESHOLD) {
+    _chronoBacktracks++;
+    backtrack(conflictLevel-1);
+  } else {
+    backtrack(backjumpLevel);
+  }
+
+  if (_learnt.size() == 1) {
+    assign(_learnt[0], 0, NO_REASON);
+  } else {
+    ClauseRef learnt = allocClause(_learnt, true, lbd);
+    attachClause(learnt);
+    assign(_learnt[0], backjumpLevel, learnt);
+  }
+  decayActivities();
+  return true;
+}
+
+/**
+ * Collect into _failedAssumptionBuffer the assumptions responsible for
+ * the assumption @b failedAssumption being false.
+ */
+void CDCLSolver::analyzeFinal(unsigned failedAssumption)
+{
+  CALL("CDCLSolver::analyzeFinal");
+
+  _failedAssumptionBuffer.reset();
+  _failedAssumptionBuffer.push(SATLiteral(failedAssumption));
+  if (level(failedAssumption) == 0) {
+    return;
+  }
+
+  _seen[var(failedAssumption)] = 1;
+  for (unsigned i = _trail.size(); i > _control[0]; ) {
+    i--;
+    unsigned lit = _trail[i];
+    unsigned v = var(lit);
+    if (!_seen[v]) {
+      continue;
+    }
+    _seen[v] = 0;
+    ClauseRef cr = _reason[v];
+    if (cr == NO_REASON) {
+      // a decision below the assumption levels is an assumption
+      ASS_G(_level[v],0);
+      _failedAssumptionBuffer.push(SATLiteral(lit));
+      continue;
+    }
+    unsigned* lits = clauseLits(cr);
+    unsigned size = clauseSize(cr);
+    for (unsigned k = 1; k < size; k++) {
+      if (level(lits[k]) > 0) {
+        _seen[var(lits[k])] = 1;
+      }
+    }
+  }
+}
+
+unsigned CDCLSolver::pickBranchLiteral()
+{
+  CALL("CDCLSolver::pickBranchLiteral");
+
+  while (!_heap.isEmpty()) {
+    unsigned v = _heap.pop();
+    if (!_values[v<<1]) {
+      return (v<<1) | _phase[v];
+    }
+  }
+  return 0;
+}
+
+/**
+ * Glucose style restarts: restart when the recent learnt clauses are
+ * of worse quality than the long-term average.
+ */
+bool CDCLSolver::restartDue()
+{
+  return _conflicts-_conflictsAtRestart >= RESTART_MIN_CONFLICTS &&
+      _fastLbd.value > RESTART_MARGIN*_slowLbd.value;
+}
+
+/**
+ * Delete about half of the learnt clauses outside the core, preferring
+ * those with high LBD and not used since the last reduction.
+ */
+void CDCLSolver::reduceDB()
+{
+  CALL("CDCLSolver::reduceDB");
+
+  static Stack<pair<unsigned long,ClauseRef> > candidates;
+  candidates.reset();
+
+  ClauseRef end = _arena.size();
+  for (ClauseRef cr = 0; cr < end; cr = nextClause(cr)) {
+    if (!isLearnt(cr) || isGarbage(cr) || clauseLbd(cr) <= CORE_LBD) {
+      continue;
+    }
+    if (_arena[cr+1] & FLAG_USED) {
+      clearFlag(cr, FLAG_USED);
+      continue;
+    }
+    if (locked(cr)) {
+      continue;
+    }
+    unsigned long key = ((unsigned long)clauseLbd(cr) << 32) | clauseSize(cr);
+    candidates.push(make_pair(key, cr));
+  }
+  std::sort(candidates.begin(), candidates.end(), greater<pair<unsigned long,ClauseRef> >());
+
+  unsigned toDelete = candidates.size()/2;
+  for (unsigned i = 0; i < toDelete; i++) {
+    markGarbage(candidates[i].second);
+  }
+  _reducedClauses += toDelete;
+  collectGarbage();
+
+  _reductions++;
+  _nextReduce = _conflicts+REDUCE_BASE+REDUCE_INCREMENT*_reductions;
+}
+
+/**
+ * At level 0, delete satisfied clauses and remove false literals from the rest.
+ */
+void CDCLSolver::removeSatisfied()
+{
+  CALL("CDCLSolver::removeSatisfied");
+  ASS_EQ(decisionLevel(),0);
+  ASS_EQ(_propagated,_trail.size());
+
+  if (_simplifiedAt == _trail.size()) {
+    return;
+  }
+  _simplifiedAt = _trail.size();
+
+  ClauseRef end = _arena.size();
+  for (ClauseRef cr = 0; cr < end; cr = nextClause(cr)) {
+    if (isGarbage(cr)) {
+      continue;
+    }
+    unsigned size = clauseSize(cr);
+    _clauseLits.reset();
+    bool satisfied = false;
+    for (unsigned k = 0; k < size; k++) {
+      unsigned lit = clauseLits(cr)[k];
+      if (val(lit) > 0) {
+        satisfied = true;
+        break;
+      }
+      if (val(lit) == 0) {
+        _clauseLits.push(lit);
+      }
+    }
+    if (satisfied) {
+      markGarbage(cr);
+    } else if (_clauseLits.size() < size) {
+      // after full propagation at level 0 at least the watched literals are unassigned
+      ASS_GE(_clauseLits.size(),2);
+      ClauseRef shortened = allocClause(_clauseLits, isLearnt(cr), std::min(clauseLbd(cr), (unsigned)_clauseLits.size()));
+      markGarbage(cr);
+      attachClause(shortened);
+    }
+  }
+}
+
+/**
+ * Forward subsumption of the clause database, a learnt clause that
+ * subsumes an input one becomes an input clause.
+ */
+void CDCLSolver::subsume()
+{
+  CALL("CDCLSolver::subsume");
+  ASS_EQ(decisionLevel(),0);
+
+  static Stack<pair<unsigned long,ClauseRef> > candidates;
+  candidates.reset();
+
+  ClauseRef end = _arena.size();
+  for (ClauseRef cr = 0; cr < end; cr = nextClause(cr)) {
+    if (!isGarbage(cr) && clauseSize(cr) <= SUBSUME_MAX_SIZE) {
+      // shorter first, input clauses before learnt ones of the same size
+      unsigned long key = ((unsigned long)clauseSize(cr) << 1) | (isLearnt(cr) ? 1 : 0);
+      candidates.push(make_pair(key, cr));
+    }
+  }
+  std::sort(candidates.begin(), candidates.end());
+
+  DArray<Stack<ClauseRef> > occurrences(_values.size());
+  DArray<unsigned char> marks;
+  marks.init(_values.size(), 0);
+
+  unsigned long effort = 0;
+  for (unsigned i = 0; i < candidates.size() && effort < SUBSUME_EFFORT; i++) {
+    ClauseRef cr = candidates[i].second;
+    unsigned* lits = clauseLits(cr);
+    unsigned size = clauseSize(cr);
+    for (unsigned k = 0; k < size; k++) {
+      marks[lits[k]] = 1;
+    }
+
+    bool subsumed = false;
+    for (unsigned k = 0; k < size && !subsumed; k++) {
+      Stack<ClauseRef>& occs = occurrences[lits[k]];
+      for (unsigned o = 0; o < occs.size(); o++) {
+        ClauseRef other = occs[o];
+        unsigned* otherLits = clauseLits(other);
+        unsigned otherSize = clauseSize(other);
+        unsigned m = 0;
+        while (m < otherSize && marks[otherLits[m]]) {
+          m++;
+        }
+        effort += m+1;
+        if (m == otherSize) {
+          subsumed = true;
+          if (!isLearnt(cr) && isLearnt(other)) {
+            clearFlag(other, FLAG_LEARNT);
+          }
+          break;
+        }
+      }
+    }
+
+    for (unsigned k = 0; k < size; k++) {
+      marks[lits[k]] = 0;
+    }
+
+    if (subsumed) {
+      markGarbage(cr);
+      _subsumedClauses++;
+      continue;
+    }
+    unsigned best = lits[0];
+    for (unsigned k = 1; k < size; k++) {
+      if (occurrences[lits[k]].size() < occurrences[best].size()) {
+        best = lits[k];
+      }
+    }
+    occurrences[best].push(cr);
+  }
+}
+
+/**
+ * Vivification of learnt clauses: assume the negation of the literals
+ * one by one and shorten the clause when propagation (ignoring the clause
+ * itself) shows that the remaining literals are not needed.
+ */
+void CDCLSolver::vivify()
+{
+  CALL("CDCLSolver::vivify");
+  ASS_EQ(decisionLevel(),0);
+
+  static Stack<pair<unsigned long,ClauseRef> > candidates;
+  candidates.reset();
+
+  ClauseRef end = _arena.size();
+  for (ClauseRef cr = 0; cr < end; cr = nextClause(cr)) {
+    if (isLearnt(cr) && !isGarbage(cr) && clauseSize(cr) > 2 && !(_arena[cr+1] & FLAG_VIVIFIED)) {
+      unsigned long key = ((unsigned long)clauseLbd(cr) << 32) | clauseSize(cr);
+      candidates.push(make_pair(key, cr));
+    }
+  }
+  std::sort(candidates.begin(), candidates.end());
+
+  unsigned long effort = std::max(VIVIFY_MIN_EFFORT, (_propagations-_propagationsAtInprocess)/10);
+  unsigned long limit = _propagations+effort;
+
+  for (unsigned i = 0; i < candidates.size() && _propagations < limit; i++) {
+    ClauseRef cr = candidates[i].second;
+    if (isGarbage(cr)) {
+      continue;
+    }
+    setFlag(cr, FLAG_VIVIFIED);
+
+    unsigned size = clauseSize(cr);
+    _clauseLits.reset();
+    bool satisfied = false;
+    for (unsigned k = 0; k < size; k++) {
+      unsigned lit = clauseLits(cr)[k];
+      if (val(lit) > 0) {
+        satisfied = true;
+        break;
+      }
+      _clauseLits.push(lit);
+    }
+    if (satisfied) {
+      markGarbage(cr);
+      continue;
+    }
+
+    _ignored = cr;
+    _learnt.reset();
+    for (unsigned k = 0; k < _clauseLits.size(); k++) {
+      unsigned lit = _clauseLits[k];
+      if (val(lit) < 0) {
+        // implied false by the previous literals
+        continue;
+      }
+      _learnt.push(lit);
+      if (val(lit) > 0) {
+        // implied true by the previous literals
+        break;
+      }
+      newDecisionLevel();
+      assign(lit^1, decisionLevel(), NO_REASON);
+      if (propagate() != NO_REASON) {
+        break;
+      }
+    }
+    backtrack(0);
+    _ignored = NO_REASON;
+
+    if (_learnt.size() == size) {
+      continue;
+    }
+    _vivifiedClauses++;
+    markGarbage(cr);
+    if (_learnt.isEmpty()) {
+      _unsat = true;
+      return;
+    }
+    if (_learnt.size() == 1) {
+      assign(_learnt[0], 0, NO_REASON);
+      if (propagate() != NO_REASON) {
+        _unsat = true;
+        return;
+      }
+    } else {
+      unsigned lbd = std::min(clauseLbd(cr), (unsigned)_learnt.size()-1);
+      ClauseRef shortened = allocClause(_learnt, isLearnt(cr), lbd);
+      setFlag(shortened, FLAG_VIVIFIED);
+      attachClause(shortened);
+    }
+  }
+}
+
+/**
+ * Simplify the clause database at level 0.
+ */
+void CDCLSolver::inprocess()
+{
+  CALL("CDCLSolver::inprocess");
+  ASS_EQ(decisionLevel(),0);
+
+  if (propagate() != NO_REASON) {
+    _unsat = true;
+    return;
+  }
+  removeSatisfied();
+  subsume();
+  vivify();
+  if (!_unsat) {
+    collectGarbage();
+  }
+
+  _inprocessings++;
+  _nextInprocess = _conflicts+INPROCESS_BASE*(_inprocessings+1);
+  _propagationsAtInprocess = _propagations;
+}
+
+void CDCLSolver::simplify()
+{
+  CALL("CDCLSolver::simplify");
+
+  if (_unsat) {
+    return;
+  }
+  backtrack(0);
+  if (propagate() != NO_REASON) {
+    _unsat = true;
+    return;
+  }
+  removeSatisfied();
+  collectGarbage();
+}
+
+/**
+ * The CDCL loop. Returns UNKNOWN when @b conflictCountLimit conflicts were
+ * encountered (with 0, only the assumptions are propagated).
+ */
+SATSolver::Status CDCLSolver::search(unsigned conflictCountLimit)
+{
+  CALL("CDCLSolver::search");
+
+  unsigned long conflictsAtStart = _conflicts;
+  for (;;) {
+    ClauseRef conflict = propagate();
+    if (conflict != NO_REASON) {
+      _conflicts++;
+      if (_conflicts > RESTART_BLOCK_MIN_CONFLICTS && _trail.size() > RESTART_BLOCK_MARGIN*_trailSize.value) {
+        _conflictsAtRestart = _conflicts;
+      }
+      _trailSize.update(_trail.size());
+      if (!analyze(conflict)) {
+        _unsat = true;
+        _failedAssumptionBuffer.reset();
+        return Status::UNSATISFIABLE;
+      }
+      continue;
+    }
+
+    if (restartDue()) {
+      _restarts++;
+      _conflictsAtRestart = _conflicts;
+      // the assumption levels are kept
+      backtrack(std::min(decisionLevel(), (unsigned)_assumptions.size()));
+    }
+    if (_conflicts >= _nextReduce) {
+      reduceDB();
+    }
+    if (_conflicts >= _nextInprocess) {
+      backtrack(0);
+      inprocess();
+      if (_unsat) {
+        _failedAssumptionBuffer.reset();
+        return Status::UNSATISFIABLE;
+      }
+      continue;
+    }
+
+    unsigned next = 0;
+    while (decisionLevel() < _assumptions.size()) {
+      unsigned assumption = _assumptions[decisionLevel()];
+      if (val(assumption) > 0) {
+        // a dummy level keeps levels and assumptions aligned
+        newDecisionLevel();
+      } else if (val(assumption) < 0) {
+        analyzeFinal(assumption);
+        return Status::UNSATISFIABLE;
+      } else {
+        next = assumption;
+        break;
+      }
+    }
+    if (!next) {
+      if (_conflicts-conflictsAtStart >= conflictCountLimit) {
+        return Status::UNKNOWN;
+      }
+      next = pickBranchLiteral();
+      if (!next) {
+        saveModel();
+        return Status::SATISFIABLE;
+      }
+      _decisions++;
+    }
+    newDecisionLevel();
+    assign(next, decisionLevel(), NO_REASON);
+  }
+}
+
+void CDCLSolver::saveModel()
+{
+  CALL("CDCLSolver::saveModel");
+
+  _model.expand(_varCnt+1);
+  for (unsigned v = 1; v <= _varCnt; v++) {
+    _model[v] = _values[(v<<1)|1];
+  }
+}
+
+SATSolver::Status CDCLSolver::solve(unsigned conflictCountLimit)
+{
+  CALL("CDCLSolver::solve");
+
+  if (_unsat) {
+    _failedAssumptionBuffer.reset();
+    _status = Status::UNSATISFIABLE;
+    return _status;
+  }
+
+  _status = search(conflictCountLimit);
+  backtrack(0);
+  return _status;
+}
+
+SATSolver::Status CDCLSolver::solveUnderAssumptions(const SATLiteralStack& assumps, unsigned conflictCountLimit, bool)
+{
+  CALL("CDCLSolver::solveUnderAssumptions");
+
+  ASS(!hasAssumptions());
+
+  SATLiteralStack::ConstIterator it(assumps);
+  while (it.hasNext()) {
+    addAssumption(it.next());
+  }
+  solve(conflictCountLimit);
+  _assumptions.reset();
+
+  return _status;
+}
+
+void CDCLSolver::addAssumption(SATLiteral lit)
+{
+  CALL("CDCLSolver::addAssumption");
+  ASS_G(lit.var(),0); ASS_LE(lit.var(),_varCnt);
+
+  _assumptions.push(lit.content());
+}
+
+void CDCLSolver::retractAllAssumptions()
+{
+  CALL("CDCLSolver::retractAllAssumptions");
+
+  _assumptions.reset();
+  _status = Status::UNKNOWN;
+}
+
+SATSolver::VarAssignment CDCLSolver::getAssignment(unsigned var)
+{
+  CALL("CDCLSolver::getAssignment");
+  ASS_EQ(_status, Status::SATISFIABLE);
+  ASS_G(var,0); ASS_LE(var,_varCnt);
+
+  if (var >= _model.size()) {
+    // new vars have been added but the model didn't grow yet
+    return VarAssignment::DONT_CARE;
+  }
+  return _model[var] > 0 ? VarAssignment::_TRUE : VarAssignment::_FALSE;
+}
+
+bool CDCLSolver::isZeroImplied(unsigned var)
+{
+  CALL("CDCLSolver::isZeroImplied");
+  ASS_G(var,0); ASS_LE(var,_varCnt);
+
+  // between calls to solve only the level 0 assignments are kept
+  return _values[var<<1] != 0 && _level[var] == 0;
+}
+
+void CDCLSolver::collectZeroImplied(SATLiteralStack& acc)
+{
+  CALL("CDCLSolver::collectZeroImplied");
+
+  for (unsigned i = 0; i < _trail.size(); i++) {
+    if (level(_trail[i]) == 0) {
+      acc.push(SATLiteral(_trail[i]));
+    }
+  }
+}
+
+SATClause* CDCLSolver::getZeroImpliedCertificate(unsigned)
+{
+  CALL("CDCLSolver::getZeroImpliedCertificate");
+
+  // Currently unused anyway (as with minisat).
+  return 0;
+}
+
+void CDCLSolver::printStatistics(ostream& out)
+{
+  CALL("CDCLSolver::printStatistics");
+
+  out << "c conflicts: " << _conflicts << endl;
+  out << "c decisions: " << _decisions << endl;
+  out << "c propagations: " << _propagations << endl;
+  out << "c restarts: " << _restarts << endl;
+  out << "c chronological backtracks: " << _chronoBacktracks << endl;
+  out << "c learnt literals: " << _learntLits << " (minimized away " << _minimizedLits << ")" << endl;
+  out << "c reduced clauses: " << _reducedClauses << " in " << _reductions << " reductions" << endl;
+  out << "c inprocessings: " << _inprocessings << " (subsumed " << _subsumedClauses
+      << ", vivified " << _vivifiedClauses << ")" << endl;
+}
+
+}
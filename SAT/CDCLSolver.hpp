@@ -0,0 +1,290 @@
+/*
+ * File CDCLSolver.hpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions.
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide.
+ */
+/**
+ * @file CDCLSolver.hpp
+ * Defines class CDCLSolver, a conflict driven clause learning SAT solver.
+ */
+
+#ifndef __CDCLSolver__
+#define __CDCLSolver__
+
+#include "Forwards.hpp"
+
+#include "Lib/Allocator.hpp"
+#include "Lib/ArrayMap.hpp"
+#include "Lib/DArray.hpp"
+#include "Lib/DynamicHeap.hpp"
+#include "Lib/Int.hpp"
+#include "Lib/Stack.hpp"
+
+#include "SATLiteral.hpp"
+#include "SATClause.hpp"
+#include "SATSolver.hpp"
+
+namespace SAT {
+
+using namespace Lib;
+using namespace Shell;
+
+/**
+ * A CDCL solver in the style of Glucose/CaDiCaL.
+ *
+ * Clauses are copied into a flat arena of unsigned words and referred to
+ * by their offsets; literals are represented by SATLiteral::content().
+ * The solver uses watch lists with blocking literals, EVSIDS with phase
+ * saving, recursive learnt clause minimisation, restarts driven by
+ * moving averages of LBD, LBD based clause database reduction,
+ * chronological backtracking and, at decision level 0, subsumption and
+ * vivification of learnt clauses.
+ *
+ * Assumptions are decided on the first decision levels, the failed ones
+ * are recovered by analysing the final conflict.
+ */
+class CDCLSolver : public PrimitiveProofRecordingSATSolver
+{
+public:
+  CLASS_NAME(CDCLSolver);
+  USE_ALLOCATOR(CDCLSolver);
+
+  CDCLSolver(const Options& opts, bool generateProofs=false);
+
+  /**
+   * Can be called only when all assumptions are retracted
+   *
+   * A requirement is that in a clause, each variable occurs at most once.
+   */
+  virtual void addClause(SATClause* cl) override;
+
+  /**
+   * Opportunity to perform in-processing of the clause database.
+   */
+  virtual void simplify() override;
+
+  virtual Status solve(unsigned conflictCountLimit) override;
+
+  virtual VarAssignment getAssignment(unsigned var) override;
+  virtual bool isZeroImplied(unsigned var) override;
+  virtual void collectZeroImplied(SATLiteralStack& acc) override;
+  virtual SATClause* getZeroImpliedCertificate(unsigned var) override;
+
+  virtual void ensureVarCount(unsigned newVarCnt) override;
+  virtual unsigned newVar() override;
+
+  virtual void suggestPolarity(unsigned var, unsigned pol) override
+  {
+    ASS_G(var,0); ASS_LE(var,_varCnt);
+    _phase[var] = pol;
+  }
+
+  virtual void addAssumption(SATLiteral lit) override;
+  virtual void retractAllAssumptions() override;
+  virtual bool hasAssumptions() const override { return _assumptions.isNonEmpty(); }
+
+  virtual void recordSource(unsigned satlitvar, Literal* lit) override {
+    // intentionally no-op
+  }
+
+  Status solveUnderAssumptions(const SATLiteralStack& assumps, unsigned conflictCountLimit, bool) override;
+
+  /** Print search statistics (used by the DIMACS front-ends) */
+  void printStatistics(ostream& out);
+
+private:
+  /** Offset of a clause in the arena */
+  typedef unsigned ClauseRef;
+  static const ClauseRef NO_REASON = 0xFFFFFFFFu;
+
+  struct Watch
+  {
+    Watch() {}
+    Watch(unsigned blocker, ClauseRef cref, bool binary)
+    : blocker(blocker), cref(cref), binary(binary) {}
+
+    /** literal of the clause whose truth makes visiting the clause unnecessary */
+    unsigned blocker;
+    ClauseRef cref;
+    /** for binary clauses the blocker is the other literal */
+    bool binary;
+  };
+  typedef Stack<Watch> WatchStack;
+
+  /**
+   * Clause layout in the arena: size, flags, forwarding offset (used
+   * only during garbage collection) and the literals. Watched literals
+   * are at positions 0 and 1 and for a reason clause the implied literal
+   * is at position 0.
+   */
+  enum {
+    HEADER_SIZE = 3,
+    FLAG_LEARNT = 1,
+    FLAG_GARBAGE = 2,
+    FLAG_USED = 4,
+    FLAG_VIVIFIED = 8,
+    LBD_SHIFT = 4
+  };
+
+  unsigned clauseSize(ClauseRef cr) const { return _arena[cr]; }
+  unsigned* clauseLits(ClauseRef cr) { return _arena.begin()+cr+HEADER_SIZE; }
+  bool isLearnt(ClauseRef cr) const { return _arena[cr+1] & FLAG_LEARNT; }
+  bool isGarbage(ClauseRef cr) const { return _arena[cr+1] & FLAG_GARBAGE; }
+  unsigned clauseLbd(ClauseRef cr) const { return _arena[cr+1] >> LBD_SHIFT; }
+  void setClauseLbd(ClauseRef cr, unsigned lbd)
+  { _arena[cr+1] = (_arena[cr+1] & ((1u<<LBD_SHIFT)-1)) | (lbd<<LBD_SHIFT); }
+  void setFlag(ClauseRef cr, unsigned flag) { _arena[cr+1] |= flag; }
+  void clearFlag(ClauseRef cr, unsigned flag) { _arena[cr+1] &= ~flag; }
+  ClauseRef nextClause(ClauseRef cr) const { return cr+HEADER_SIZE+clauseSize(cr); }
+
+  /** Value of a literal: 1 true, -1 false, 0 unassigned */
+  signed char val(unsigned lit) const { return _values[lit]; }
+  static unsigned var(unsigned lit) { return lit>>1; }
+  unsigned level(unsigned lit) const { return _level[var(lit)]; }
+  unsigned decisionLevel() const { return _control.size(); }
+
+  ClauseRef allocClause(const Stack<unsigned>& lits, bool learnt, unsigned lbd);
+  void attachClause(ClauseRef cr);
+  void removeWatch(unsigned lit, ClauseRef cr);
+  void rewatch(ClauseRef cr, unsigned pos0, unsigned pos1);
+  bool locked(ClauseRef cr);
+  void markGarbage(ClauseRef cr);
+  void collectGarbage();
+
+  void assign(unsigned lit, unsigned lvl, ClauseRef reason);
+  void newDecisionLevel() { _control.push(_trail.size()); }
+  void backtrack(unsigned lvl);
+  ClauseRef propagate();
+
+  bool analyze(ClauseRef conflict);
+  bool litRedundant(unsigned lit, unsigned abstractLevels);
+  unsigned abstractLevel(unsigned v) const { return 1u << (_level[v] & 31); }
+  unsigned computeLbd(const unsigned* lits, unsigned size);
+  void analyzeFinal(unsigned failedAssumption);
+
+  void bumpVariable(unsigned v);
+  void decayActivities() { _varInc /= VAR_DECAY; }
+  void bumpClause(ClauseRef cr);
+  unsigned pickBranchLiteral();
+
+  bool restartDue();
+  void reduceDB();
+  void removeSatisfied();
+  void subsume();
+  void vivify();
+  void inprocess();
+
+  Status search(unsigned conflictCountLimit);
+  void saveModel();
+
+  static const double VAR_DECAY;
+
+  struct ActivityComparator
+  {
+    ActivityComparator(DArray<double>& act) : _act(act) {}
+
+    Comparison compare(unsigned v1, unsigned v2)
+    {
+      //DynamicHeap is minimal and we want maximum, so we need to swap
+      //the arguments
+      return Int::compare(_act[v2], _act[v1]);
+    }
+    DArray<double>& _act;
+  };
+
+  /** Exponential moving average with bias correction */
+  struct Ema
+  {
+    Ema(double alpha) : alpha(alpha), biased(0), exp(1), value(0) {}
+    void update(double x)
+    {
+      biased += alpha*(x-biased);
+      exp *= 1-alpha;
+      value = biased/(1-exp);
+    }
+    double alpha;
+    double biased;
+    double exp;
+    double value;
+  };
+
+  unsigned _varCnt;
+  Status _status;
+  /** set once the empty clause has been derived */
+  bool _unsat;
+
+  Stack<unsigned> _arena;
+  /** number of arena words occupied by garbage clauses */
+  size_t _wasted;
+
+  DArray<signed char> _values;
+  DArray<WatchStack> _watches;
+  DArray<unsigned> _level;
+  DArray<ClauseRef> _reason;
+  DArray<unsigned char> _phase;
+  DArray<unsigned char> _seen;
+  DArray<double> _activity;
+  double _varInc;
+  DynamicHeap<unsigned, ActivityComparator, ArrayMap<size_t> > _heap;
+
+  Stack<unsigned> _trail;
+  /** trail size at the start of each decision level */
+  Stack<unsigned> _control;
+  unsigned _propagated;
+
+  /** literals (as content) assumed by the next call to solve */
+  Stack<unsigned> _assumptions;
+  /** the model after a satisfiable solve */
+  DArray<signed char> _model;
+
+  /** scratch stacks of the conflict analysis */
+  Stack<unsigned> _learnt;
+  Stack<unsigned> _toClear;
+  Stack<unsigned> _analyzeStack;
+  Stack<unsigned> _clauseLits;
+  DArray<unsigned> _levelStamp;
+  unsigned _stamp;
+
+  /** clause ignored by propagation while it is being vivified */
+  ClauseRef _ignored;
+
+  Ema _fastLbd;
+  Ema _slowLbd;
+  Ema _trailSize;
+  unsigned long _conflictsAtRestart;
+
+  unsigned long _nextReduce;
+  unsigned _reductions;
+  unsigned long _nextInprocess;
+  unsigned _inprocessings;
+  unsigned long _propagationsAtInprocess;
+  /** number of level 0 assignments at the last removal of satisfied clauses */
+  unsigned _simplifiedAt;
+
+  unsigned long _conflicts;
+  unsigned long _decisions;
+  unsigned long _propagations;
+  unsigned long _restarts;
+  unsigned long _chronoBacktracks;
+  unsigned long _learntLits;
+  unsigned long _minimizedLits;
+  unsigned long _reducedClauses;
+  unsigned long _subsumedClauses;
+  unsigned long _vivifiedClauses;
+};
+
+}
+
+#endif // __CDCLSolver__
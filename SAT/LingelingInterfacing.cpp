@@ -0,0 +1,274 @@
+/*
+ * File LingelingInterfacing.cpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions.
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide.
+ */
+/**
+ * @file LingelingInterfacing.cpp
+ * Implements class LingelingInterfacing
+ */
+
+#include <algorithm>
+#include <climits>
+
+#include "Shell/Options.hpp"
+
+#include "LingelingInterfacing.hpp"
+
+namespace SAT
+{
+
+using namespace Shell;
+using namespace Lib;
+
+LingelingInterfacing::LingelingInterfacing(const Shell::Options& opts, bool generateProofs):
+  _status(Status::SATISFIABLE), _varCnt(0), _freezeAll(true)
+{
+  CALL("LingelingInterfacing::LingelingInterfacing");
+
+  _solver = lglinit();
+  lglsetopt(_solver, "verbose", -1);
+  _varState.expand(1, UNUSED);
+}
+
+LingelingInterfacing::~LingelingInterfacing()
+{
+  CALL("LingelingInterfacing::~LingelingInterfacing");
+
+  lglrelease(_solver);
+}
+
+/**
+ * Make the solver handle clauses with variables up to @b newVarCnt
+ */
+void LingelingInterfacing::ensureVarCount(unsigned newVarCnt)
+{
+  CALL("LingelingInterfacing::ensureVarCount");
+
+  if (newVarCnt > _varCnt) {
+    ASS_L(newVarCnt,(unsigned)INT_MAX);
+    _varCnt = newVarCnt;
+    _varState.expand(_varCnt+1, UNUSED);
+  }
+}
+
+unsigned LingelingInterfacing::newVar()
+{
+  CALL("LingelingInterfacing::newVar");
+
+  ensureVarCount(_varCnt+1);
+  return _varCnt;
+}
+
+/**
+ * Mark @b var as passed to Lingeling, freezing it if @b freeze is true
+ * or if all variables are to be frozen.
+ *
+ * A frozen variable can be used in clauses and assumptions after
+ * any call to solve.
+ */
+void LingelingInterfacing::useVar(unsigned var, bool freeze)
+{
+  CALL("LingelingInterfacing::useVar");
+  ASS_G(var,0); ASS_LE(var,_varCnt);
+
+  if (_varState[var] == FROZEN) {
+    return;
+  }
+  // the variable may have been eliminated by an earlier call to solve
+  ASS(lglusable(_solver,(int)var));
+  if (freeze || _freezeAll) {
+    lglfreeze(_solver, (int)var);
+    _varState[var] = FROZEN;
+  } else {
+    _varState[var] = USED;
+  }
+}
+
+void LingelingInterfacing::suggestPolarity(unsigned var, unsigned pol)
+{
+  CALL("LingelingInterfacing::suggestPolarity");
+  ASS_G(var,0); ASS_LE(var,_varCnt);
+
+  // setting the phase passes the variable to Lingeling, so only do it
+  // for variables which will not become unusable
+  if (_freezeAll) {
+    useVar(var, true);
+  }
+  if (_varState[var] == FROZEN) {
+    lglsetphase(_solver, pol ? (int)var : -(int)var);
+  }
+}
+
+void LingelingInterfacing::simplify()
+{
+  CALL("LingelingInterfacing::simplify");
+
+  lglsimp(_solver, 1);
+}
+
+SATSolver::Status LingelingInterfacing::solveUnderAssumptions(const SATLiteralStack& assumps, unsigned conflictCountLimit, bool)
+{
+  CALL("LingelingInterfacing::solveUnderAssumptions");
+
+  ASS(!hasAssumptions());
+
+  // load assumptions:
+  SATLiteralStack::ConstIterator it(assumps);
+  while (it.hasNext()) {
+    addAssumption(it.next());
+  }
+
+  solveModuloAssumptionsAndSetStatus(conflictCountLimit);
+
+  if (_status == SATSolver::Status::UNSATISFIABLE) {
+    // collect the assumptions Lingeling used to derive the conflict
+    _failedAssumptionBuffer.reset();
+    SATLiteralStack::ConstIterator ait(_assumptions);
+    while (ait.hasNext()) {
+      SATLiteral lit = ait.next();
+      if (lglfailed(_solver, vampireLit2Lingeling(lit))) {
+        _failedAssumptionBuffer.push(lit);
+      }
+    }
+  }
+
+  _assumptions.reset();
+
+  return _status;
+}
+
+/**
+ * Solve modulo assumptions and set status.
+ * @b conflictCountLimit as with addAssumption.
+ */
+void LingelingInterfacing::solveModuloAssumptionsAndSetStatus(unsigned conflictCountLimit)
+{
+  CALL("LingelingInterfacing::solveModuloAssumptionsAndSetStatus");
+
+  // assumptions are consumed by each call to lglsat
+  SATLiteralStack::ConstIterator it(_assumptions);
+  while (it.hasNext()) {
+    lglassume(_solver, vampireLit2Lingeling(it.next()));
+  }
+
+  // treating UINT_MAX as \infty
+  lglsetopt(_solver, "clim", conflictCountLimit == UINT_MAX ? -1 : (int)std::min(conflictCountLimit, (unsigned)INT_MAX));
+  int res = lglsat(_solver);
+
+  if (res == LGL_SATISFIABLE) {
+    _status = Status::SATISFIABLE;
+
+    // the model has to be read before the next clause is added
+    _model.expand(_varCnt+1);
+    for (unsigned var = 1; var <= _varCnt; var++) {
+      _model[var] = (signed char)lglderef(_solver, (int)var);
+    }
+  } else if (res == LGL_UNSATISFIABLE) {
+    _status = Status::UNSATISFIABLE;
+  } else {
+    _status = Status::UNKNOWN;
+  }
+}
+
+/**
+ * Add clause into the solver.
+ *
+ */
+void LingelingInterfacing::addClause(SATClause* cl)
+{
+  CALL("LingelingInterfacing::addClause");
+
+  // store to later generate the refutation
+  PrimitiveProofRecordingSATSolver::addClause(cl);
+
+  ASS(_assumptions.isEmpty());
+
+  unsigned clen=cl->length();
+  for(unsigned i=0;i<clen;i++) {
+    SATLiteral l = (*cl)[i];
+    useVar(l.var(), false);
+    lgladd(_solver, vampireLit2Lingeling(l));
+  }
+  lgladd(_solver, 0);
+}
+
+/**
+ * Perform solving and return status.
+ */
+SATSolver::Status LingelingInterfacing::solve(unsigned conflictCountLimit)
+{
+  CALL("LingelingInterfacing::solve");
+
+  solveModuloAssumptionsAndSetStatus(conflictCountLimit);
+  return _status;
+}
+
+void LingelingInterfacing::addAssumption(SATLiteral lit)
+{
+  CALL("LingelingInterfacing::addAssumption");
+
+  // assumed variables have to stay usable for the later calls
+  useVar(lit.var(), true);
+  _assumptions.push(lit);
+}
+
+SATSolver::VarAssignment LingelingInterfacing::getAssignment(unsigned var)
+{
+  CALL("LingelingInterfacing::getAssignment");
+  ASS_EQ(_status, Status::SATISFIABLE);
+  ASS_G(var,0); ASS_LE(var,_varCnt);
+
+  if (var >= _model.size()) {
+    // new vars have been added but the model didn't grow yet
+    return VarAssignment::DONT_CARE;
+  }
+  return _model[var] > 0 ? VarAssignment::_TRUE : VarAssignment::_FALSE;
+}
+
+bool LingelingInterfacing::isZeroImplied(unsigned var)
+{
+  CALL("LingelingInterfacing::isZeroImplied");
+  ASS_G(var,0); ASS_LE(var,_varCnt);
+
+  // lglfixed would pass an unused variable to Lingeling
+  return _varState[var] != UNUSED && lglfixed(_solver, (int)var) != 0;
+}
+
+void LingelingInterfacing::collectZeroImplied(SATLiteralStack& acc)
+{
+  CALL("LingelingInterfacing::collectZeroImplied");
+
+  for (unsigned var = 1; var <= _varCnt; var++) {
+    if (_varState[var] == UNUSED) {
+      continue;
+    }
+    int val = lglfixed(_solver, (int)var);
+    if (val) {
+      acc.push(SATLiteral(var, val > 0 ? 1 : 0));
+    }
+  }
+}
+
+SATClause* LingelingInterfacing::getZeroImpliedCertificate(unsigned)
+{
+  CALL("LingelingInterfacing::getZeroImpliedCertificate");
+
+  // Currently unused anyway, see MinisatInterfacing
+
+  return 0;
+}
+
+}//end SAT namespace
@@ -0,0 +1,160 @@
+/*
+ * File LingelingInterfacing.hpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions.
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide.
+ */
+/**
+ * @file LingelingInterfacing.hpp
+ * Defines class LingelingInterfacing
+ */
+#ifndef __LingelingInterfacing__
+#define __LingelingInterfacing__
+
+#include "Lib/DArray.hpp"
+
+#include "SATSolver.hpp"
+#include "SATLiteral.hpp"
+#include "SATClause.hpp"
+
+extern "C" {
+#include "lglib.h"
+}
+
+namespace SAT{
+
+/**
+ * Interface to the bundled Lingeling solver.
+ *
+ * Lingeling may eliminate variables which are not frozen, after which
+ * they must not occur in new clauses or assumptions. By default every
+ * variable is frozen when it is first passed to Lingeling, which keeps
+ * the solver fully incremental. A client which adds all its clauses
+ * before the first call to solve can allow elimination by calling
+ * enableVariableElimination().
+ */
+class LingelingInterfacing : public PrimitiveProofRecordingSATSolver
+{
+public:
+  CLASS_NAME(LingelingInterfacing);
+  USE_ALLOCATOR(LingelingInterfacing);
+
+  LingelingInterfacing(const Shell::Options& opts, bool generateProofs=false);
+  ~LingelingInterfacing();
+
+  /**
+   * Can be called only when all assumptions are retracted
+   *
+   * A requirement is that in a clause, each variable occurs at most once.
+   */
+  virtual void addClause(SATClause* cl) override;
+
+  /**
+   * Opportunity to perform in-processing of the clause database.
+   *
+   * (Lingeling runs its preprocessing without searching.)
+   */
+  virtual void simplify() override;
+
+  /**
+   * Let Lingeling eliminate the variables that do not occur in assumptions.
+   * After the first call to solve, clauses can then only be added over
+   * variables that have not been used so far.
+   */
+  void enableVariableElimination() { _freezeAll = false; }
+
+  virtual Status solve(unsigned conflictCountLimit) override;
+
+  /**
+   * If status is @c SATISFIABLE, return assignment of variable @c var
+   */
+  virtual VarAssignment getAssignment(unsigned var) override;
+
+  /**
+   * Return true if the assignment of @c var is implied at the top level
+   */
+  virtual bool isZeroImplied(unsigned var) override;
+  /**
+   * Collect zero-implied literals.
+   *
+   * @see isZeroImplied()
+   */
+  virtual void collectZeroImplied(SATLiteralStack& acc) override;
+  /**
+   * Lingeling does not provide certificates, return 0.
+   */
+  virtual SATClause* getZeroImpliedCertificate(unsigned var) override;
+
+  virtual void ensureVarCount(unsigned newVarCnt) override;
+
+  virtual unsigned newVar() override;
+
+  virtual void suggestPolarity(unsigned var, unsigned pol) override;
+
+  /**
+   * Add an assumption into the solver.
+   */
+  virtual void addAssumption(SATLiteral lit) override;
+
+  virtual void retractAllAssumptions() override {
+    _assumptions.reset();
+    _status = Status::UNKNOWN;
+  };
+
+  virtual bool hasAssumptions() const override {
+    return _assumptions.isNonEmpty();
+  };
+
+  virtual void recordSource(unsigned satlitvar, Literal* lit) override {
+    // intentionally no-op
+  };
+
+  Status solveUnderAssumptions(const SATLiteralStack& assumps, unsigned conflictCountLimit, bool) override;
+
+protected:
+  void solveModuloAssumptionsAndSetStatus(unsigned conflictCountLimit = UINT_MAX);
+
+  int vampireLit2Lingeling(SATLiteral vlit) {
+    ASS_G(vlit.var(),0); ASS_LE(vlit.var(),_varCnt);
+    return vlit.isPositive() ? (int)vlit.var() : -(int)vlit.var();
+  }
+
+  void useVar(unsigned var, bool freeze);
+
+private:
+  Status _status;
+  LGL* _solver;
+  unsigned _varCnt;
+
+  /** freeze every variable, not only the assumed ones */
+  bool _freezeAll;
+
+  enum VarState {
+    /** not passed to Lingeling yet */
+    UNUSED = 0,
+    /** may be eliminated at the next call to solve */
+    USED = 1,
+    FROZEN = 2
+  };
+  /** for each variable, its VarState */
+  DArray<unsigned char> _varState;
+
+  SATLiteralStack _assumptions;
+  /** the model after a satisfiable call, indexed by variable */
+  DArray<signed char> _model;
+};
+
+}//end SAT namespace
+
+#endif /*__LingelingInterfacing__*/
@@ -65,6 +65,12 @@ public:
     _solver.simplify();
   }
 
+  /**
+   * Do not eliminate variables, so that clauses over any variable
+   * can still be added after the solver was called.
+   */
+  void disableVariableElimination() { _solver.use_elim = false; }
+
   virtual Status solve(unsigned conflictCountLimit) override;
   
   /**
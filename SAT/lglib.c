@@ -46,47 +46,47 @@
 
 #define MAPLOGLEVEL(LEVEL) (LEVEL)
 
-#define LOG(LEVEL,FMT,ARGS) \
+#define LOG(LEVEL,FMT,...) \
 do { \
   if (MAPLOGLEVEL(LEVEL) > lgl->opts->log.val) break; \
-  lglogstart (lgl, MAPLOGLEVEL(LEVEL), FMT, ##ARGS); \
+  lglogstart (lgl, MAPLOGLEVEL(LEVEL), FMT, ##__VA_ARGS__); \
   lglogend (lgl); \
 } while (0)
 
-#define LOGCLS(LEVEL,CLS,FMT,ARGS) \
+#define LOGCLS(LEVEL,CLS,FMT,...) \
 do { \
   const int * P; \
   if (MAPLOGLEVEL(LEVEL) > lgl->opts->log.val) break; \
-  lglogstart (lgl, MAPLOGLEVEL(LEVEL), FMT, ##ARGS); \
+  lglogstart (lgl, MAPLOGLEVEL(LEVEL), FMT, ##__VA_ARGS__); \
   for (P = (CLS); *P; P++) fprintf (lgl->out, " %d", *P); \
   lglogend (lgl); \
 } while (0)
 
-#define LOGMCLS(LEVEL,CLS,FMT,ARGS) \
+#define LOGMCLS(LEVEL,CLS,FMT,...) \
 do { \
   const int * P; \
   if (MAPLOGLEVEL(LEVEL) > lgl->opts->log.val) break; \
-  lglogstart (lgl, MAPLOGLEVEL(LEVEL), FMT, ##ARGS); \
+  lglogstart (lgl, MAPLOGLEVEL(LEVEL), FMT, ##__VA_ARGS__); \
   for (P = (CLS); *P; P++) fprintf (lgl->out, " %d", lglm2i (lgl, *P)); \
   lglogend (lgl); \
 } while (0)
 
-#define LOGRESOLVENT(LEVEL,FMT,ARGS) \
+#define LOGRESOLVENT(LEVEL,FMT,...) \
 do { \
   const int * P; \
   if (MAPLOGLEVEL(LEVEL) > lgl->opts->log.val) break; \
-  lglogstart (lgl, MAPLOGLEVEL(LEVEL), FMT, ##ARGS); \
+  lglogstart (lgl, MAPLOGLEVEL(LEVEL), FMT, ##__VA_ARGS__); \
   for (P = lgl->resolvent.start; P < lgl->resolvent.top; P++) \
     fprintf (lgl->out, " %d", *P); \
   lglogend (lgl); \
 } while (0)
 
-#define LOGREASON(LEVEL,LIT,REASON0,REASON1,FMT,ARGS) \
+#define LOGREASON(LEVEL,LIT,REASON0,REASON1,FMT,...) \
 do { \
   int TAG, TMP, RED, G; \
   const int * C, * P; \
   if (MAPLOGLEVEL(LEVEL) > lgl->opts->log.val) break; \
-  lglogstart (lgl, MAPLOGLEVEL(LEVEL), FMT, ##ARGS); \
+  lglogstart (lgl, MAPLOGLEVEL(LEVEL), FMT, ##__VA_ARGS__); \
   TMP = ((REASON0) >> RMSHFT); \
   RED = ((REASON0) & REDCS); \
   TAG = ((REASON0) & MASKCS); \
@@ -116,19 +116,19 @@ do { \
   lglogend (lgl); \
 } while (0)
 
-#define LOGDSCHED(LEVEL,LIT,FMT,ARGS) \
+#define LOGDSCHED(LEVEL,LIT,FMT,...) \
   do { \
     int POS; \
     if (MAPLOGLEVEL(LEVEL) > lgl->opts->log.val) break; \
     POS = *lgldpos (lgl, LIT); \
     lglogstart (lgl, MAPLOGLEVEL(LEVEL), "dsched[%d] = %d ", POS, LIT); \
-    fprintf (lgl->out, FMT, ##ARGS); \
+    fprintf (lgl->out, FMT, ##__VA_ARGS__); \
     fprintf (lgl->out, \
       " score %s", lglscr2str (lgl, lglqvar (lgl, LIT)->score)); \
     lglogend (lgl); \
   } while (0)
 
-#define LOGESCHED(LEVEL,LIT,FMT,ARGS) \
+#define LOGESCHED(LEVEL,LIT,FMT,...) \
 do { \
   int POS; \
   EVar * EV; \
@@ -136,17 +136,17 @@ do { \
   POS = *lglepos (lgl, LIT); \
   EV = lglevar (lgl, LIT); \
   lglogstart (lgl, MAPLOGLEVEL(LEVEL), "esched[%d] = %d ", POS, LIT); \
-  fprintf (lgl->out, FMT, ##ARGS); \
+  fprintf (lgl->out, FMT, ##__VA_ARGS__); \
   fprintf (lgl->out, " score"); \
   fprintf (lgl->out, " occ %d %d", EV->occ[0], EV->occ[1]); \
   lglogend (lgl); \
 } while (0)
 
-#define LOGEQN(LEVEL,EQN,FMT,ARGS) \
+#define LOGEQN(LEVEL,EQN,FMT,...) \
 do { \
   const int * P, * START; \
   if (MAPLOGLEVEL(LEVEL) > lgl->opts->log.val) break; \
-  lglogstart (lgl, MAPLOGLEVEL(LEVEL), FMT, ##ARGS); \
+  lglogstart (lgl, MAPLOGLEVEL(LEVEL), FMT, ##__VA_ARGS__); \
   START = lgl->gauss->xors.start + (EQN); \
   assert (START < lgl->gauss->xors.top); \
   for (P = START; *P > 1; P++) fprintf (lgl->out, " %d", *P); \
@@ -158,27 +158,27 @@ do { \
 #else /* end of then start of else part of 'ifndef NLGLOG' */
 /*------------------------------------------------------------------------*/
 
-#define LOG(ARGS...) do { } while (0)
-#define LOGCLS(ARGS...) do { } while (0)
-#define LOGMCLS(ARGS...) do { } while (0)
-#define LOGRESOLVENT(ARGS...) do { } while (0)
-#define LOGREASON(ARGS...) do { } while (0)
-#define LOGDSCHED(ARGS...) do { } while (0)
-#define LOGESCHED(ARGS...) do { } while (0)
-#define LOGEQN(ARGS...) do { } while (0)
+#define LOG(...) do { } while (0)
+#define LOGCLS(...) do { } while (0)
+#define LOGMCLS(...) do { } while (0)
+#define LOGRESOLVENT(...) do { } while (0)
+#define LOGREASON(...) do { } while (0)
+#define LOGDSCHED(...) do { } while (0)
+#define LOGESCHED(...) do { } while (0)
+#define LOGEQN(...) do { } while (0)
 
 /*------------------------------------------------------------------------*/
 #endif /* end of else part of 'ifndef NLGLOG' */
 /*------------------------------------------------------------------------*/
 
-#define ABORTIF(COND,FMT,ARGS) \
+#define ABORTIF(COND,FMT,...) \
 do { \
   if (!(COND)) break; \
   fprintf (stderr, "*** API usage error of '%s' in '%s'", \
 	   __FILE__, __FUNCTION__); \
   if (lgl && lgl->tid >= 0) fprintf (stderr, " (tid %d)", lgl->tid); \
   fputs (": ", stderr); \
-  fprintf (stderr, FMT, ##ARGS); \
+  fprintf (stderr, FMT, ##__VA_ARGS__); \
   fputc ('\n', stderr); \
   fflush (stderr); \
   lglabort (lgl); \
@@ -248,10 +248,10 @@ do { \
 
 /*------------------------------------------------------------------------*/
 
-#define TRAPI(MSG,ARGS) \
+#define TRAPI(MSG,...) \
 do { \
   if (!lgl->apitrace) break; \
-  lgltrapi (lgl, MSG, ##ARGS); \
+  lgltrapi (lgl, MSG, ##__VA_ARGS__); \
 } while (0)
 
 #define LGLCHKACT(ACT) \
@@ -256,13 +256,12 @@ bool AWPassiveClauseContainer::byWeight(int balance)
 }
 
 /**
- * Return the next selected clause and remove it from the queue.
- * @since 31/12/2007 Manchester
+ * Update the age-weight ratio and the balance for the next selection.
+ * Return true if the clause should be selected by weight.
  */
-Clause* AWPassiveClauseContainer::popSelected()
+bool AWPassiveClauseContainer::nextSelectionByWeight()
 {
-  CALL("AWPassiveClauseContainer::popSelected");
-  ASS( ! isEmpty());
+  CALL("AWPassiveClauseContainer::nextSelectionByWeight");
 
   auto shape = _opt.ageWeightRatioShape();
   unsigned frequency = _opt.ageWeightRatioShapeFrequency();
@@ -290,15 +289,32 @@ Clause* AWPassiveClauseContainer::popSelected()
    }
   }
   //std::cerr << _ageRatio << "\t" << _weightRatio << std::endl;
-  _size--;
 
-  Clause* cl;
   if (byWeight(_balance)) {
     _balance -= _ageRatio;
+    return true;
+  } else {
+    _balance += _weightRatio;
+    return false;
+  }
+}
+
+/**
+ * Return the next selected clause and remove it from the queue.
+ * @since 31/12/2007 Manchester
+ */
+Clause* AWPassiveClauseContainer::popSelected()
+{
+  CALL("AWPassiveClauseContainer::popSelected");
+  ASS( ! isEmpty());
+
+  _size--;
+
+  Clause* cl;
+  if (nextSelectionByWeight()) {
     cl = _weightQueue.pop();
     _ageQueue.remove(cl);
   } else {
-    _balance += _weightRatio;
     cl = _ageQueue.pop();
     _weightQueue.remove(cl);
   }
@@ -310,11 +326,34 @@ Clause* AWPassiveClauseContainer::popSelected()
   return cl;
 } // AWPassiveClauseContainer::popSelected
 
+/**
+ * True if the current limits may cause some passive clauses to be discarded
+ */
+bool AWPassiveClauseContainer::limitsCanDiscard() const
+{
+  CALL("AWPassiveClauseContainer::limitsCanDiscard");
+
+  return (ageLimited() || !_ageRatio) && (weightLimited() || !_weightRatio);
+}
+
+/**
+ * True if the passive clause @b cl should be discarded under the current limits
+ */
+bool AWPassiveClauseContainer::exceedsLimits(Clause* cl) const
+{
+  CALL("AWPassiveClauseContainer::exceedsLimits");
+
+  if (!fulfilsAgeLimit(cl) && !fulfilsWeightLimit(cl)) {
+    return true;
+  }
+  return !childrenPotentiallyFulfilLimits(cl, cl->length());
+}
+
 void AWPassiveClauseContainer::onLimitsUpdated()
 {
   CALL("AWPassiveClauseContainer::onLimitsUpdated");
 
-  if ( (!ageLimited() && _ageRatio) || (!weightLimited() && _weightRatio) ) {
+  if (!limitsCanDiscard()) {
     return;
   }
 
@@ -327,12 +366,19 @@ void AWPassiveClauseContainer::onLimitsUpdated()
   ClauseQueue::Iterator wit(_weightQueue);
   while (wit.hasNext()) {
     Clause* cl=wit.next();
-    if (!fulfilsAgeLimit(cl) && !fulfilsWeightLimit(cl)) {
-      toRemove.push(cl);
-    } else if (!childrenPotentiallyFulfilLimits(cl, cl->length())) {
+    if (exceedsLimits(cl)) {
       toRemove.push(cl);
     }
   }
+  discardOverLimits(toRemove);
+}
+
+/**
+ * Remove the clauses in @b toRemove, which exceed the limits, from the container
+ */
+void AWPassiveClauseContainer::discardOverLimits(Stack<Clause*>& toRemove)
+{
+  CALL("AWPassiveClauseContainer::discardOverLimits");
 
 #if OUTPUT_LRS_DETAILS
   if (toRemove.isNonEmpty()) {
@@ -434,6 +480,18 @@ bool AWPassiveClauseContainer::setLimitsFromSimulation()
 {
   CALL("AWPassiveClauseContainer::setLimitsFromSimulation");
 
+  return setLimitsFromSimulation(!_simulationCurrAgeIt.hasNext(), !_simulationCurrWeightIt.hasNext());
+}
+
+/**
+ * Set the limits from the clauses at which the simulation stopped.
+ * @b ageQueueExhausted and @b weightQueueExhausted tell whether
+ * the simulation got to the end of the respective queue.
+ */
+bool AWPassiveClauseContainer::setLimitsFromSimulation(bool ageQueueExhausted, bool weightQueueExhausted)
+{
+  CALL("AWPassiveClauseContainer::setLimitsFromSimulation/2");
+
   ASS(_simulationCurrAgeCl != nullptr || _simulationCurrWeightCl == nullptr);
   ASS(_simulationCurrAgeCl == nullptr || _simulationCurrWeightCl != nullptr);
   if (_simulationCurrAgeCl == nullptr)
@@ -453,7 +511,7 @@ bool AWPassiveClauseContainer::setLimitsFromSimulation()
   // compute limits for age-queue
   if (_ageRatio != 0)
   {
-    if (_simulationCurrAgeIt.hasNext())
+    if (!ageQueueExhausted)
     {
       // the age-queue is in use and the simulation didn't get to the end of the age-queue => set limits on age-queue
       maxAgeQueueAge = _simulationCurrAgeCl->age();
@@ -476,7 +534,7 @@ bool AWPassiveClauseContainer::setLimitsFromSimulation()
   // compute limits for weight-queue
   if (_weightRatio != 0)
   {
-    if (_simulationCurrWeightIt.hasNext())
+    if (!weightQueueExhausted)
     {
       // the weight-queue is in use and the simulation didn't get to the end of the weight-queue => set limits on weight-queue
       maxWeightQueueWeight = _simulationCurrWeightCl->weightForClauseSelection(_opt);
@@ -94,7 +94,9 @@ public:
 
   static Comparison compareWeight(Clause* cl1, Clause* cl2, const Shell::Options& opt);
 
-private:
+protected:
+  bool nextSelectionByWeight();
+
   /** The age queue, empty if _ageRatio=0 */
   AgeQueue _ageQueue;
   /** The weight queue, empty if _weightRatio=0 */
@@ -123,8 +125,12 @@ public:
   bool setLimitsFromSimulation() override;
 
   void onLimitsUpdated() override;
-private:
+protected:
   bool setLimits(unsigned newAgeSelectionMaxAge, unsigned newAgeSelectionMaxWeight, unsigned newWeightSelectionMaxWeight, unsigned newWeightSelectionMaxAge);
+  bool setLimitsFromSimulation(bool ageQueueExhausted, bool weightQueueExhausted);
+  bool limitsCanDiscard() const;
+  bool exceedsLimits(Clause* cl) const;
+  void discardOverLimits(Stack<Clause*>& toRemove);
 
   int _simulationBalance;
   ClauseQueue::Iterator _simulationCurrAgeIt;
@@ -0,0 +1,256 @@
+
+/*
+ * File BucketPassiveClauseContainer.cpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions.
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide.
+ */
+/**
+ * @file BucketPassiveClauseContainer.cpp
+ * Implements class BucketPassiveClauseContainer.
+ */
+
+#include "Kernel/Clause.hpp"
+#include "Kernel/CompactClause.hpp"
+#include "Shell/Options.hpp"
+
+#include "BucketPassiveClauseContainer.hpp"
+
+namespace Saturation
+{
+using namespace Lib;
+using namespace Kernel;
+
+unsigned AgeBucketQueue::key(Clause* cl)
+{
+  if (BucketPassiveClauseContainer::isCompactEntry(cl)) {
+    return BucketPassiveClauseContainer::entryRecord(cl)->age();
+  }
+  return cl->age();
+}
+
+/**
+ * The clause number, also of compacted clauses
+ */
+static unsigned entryNumber(Clause* entry)
+{
+  if (BucketPassiveClauseContainer::isCompactEntry(entry)) {
+    return BucketPassiveClauseContainer::entryRecord(entry)->number();
+  }
+  return entry->number();
+}
+
+unsigned AgeBucketQueue::id(Clause* cl)
+{
+  return entryNumber(cl);
+}
+
+unsigned WeightBucketQueue::key(Clause* cl)
+{
+  if (BucketPassiveClauseContainer::isCompactEntry(cl)) {
+    return BucketPassiveClauseContainer::entryRecord(cl)->weightForClauseSelection();
+  }
+  return cl->weightForClauseSelection(_opt);
+}
+
+unsigned WeightBucketQueue::id(Clause* cl)
+{
+  return entryNumber(cl);
+}
+
+BucketPassiveClauseContainer::BucketPassiveClauseContainer(bool isOutermost, const Shell::Options& opt, vstring name) :
+  AWPassiveClauseContainer(isOutermost, opt, name),
+  // other clause containers and the indices of the other saturation
+  // algorithms may refer to passive clauses by their address
+  _compact(opt.compactPassive() && isOutermost &&
+      opt.saturationAlgorithm() == Options::SaturationAlgorithm::DISCOUNT &&
+      opt.mode() != Options::Mode::CONSEQUENCE_ELIMINATION && !opt.showSymbolElimination()),
+  _weightBuckets(opt),
+  _simulationAgeBucketIt(_ageBuckets),
+  _simulationWeightBucketIt(_weightBuckets)
+{
+}
+
+BucketPassiveClauseContainer::~BucketPassiveClauseContainer()
+{
+  ClauseBucketQueue::Iterator cit(_ageRatio ? static_cast<ClauseBucketQueue&>(_ageBuckets) : _weightBuckets);
+  while (cit.hasNext())
+  {
+    Clause* cl=cit.next();
+    if (isCompactEntry(cl)) {
+      entryRecord(cl)->destroy();
+      continue;
+    }
+    ASS(!_isOutermost || cl->store()==Clause::Store::PASSIVE);
+    cl->setStore(Clause::Store::NONE);
+  }
+}
+
+void BucketPassiveClauseContainer::add(Clause* cl)
+{
+  CALL("BucketPassiveClauseContainer::add");
+  ASS(_ageRatio > 0 || _weightRatio > 0);
+  ASS(cl->store() == Clause::Store::PASSIVE);
+
+  Clause* entry = cl;
+  if (_compact) {
+    // the clause must be announced while it still exists
+    addedEvent.fire(cl);
+    if (CompactClause::canCompact(cl)) {
+      entry = compactEntry(CompactClause::fromClause(cl, _opt));
+    }
+  }
+
+  if (_ageRatio) {
+    _ageBuckets.insert(entry);
+  }
+  if (_weightRatio) {
+    _weightBuckets.insert(entry);
+  }
+  _size++;
+
+  if (_isOutermost && !_compact)
+  {
+    addedEvent.fire(cl);
+  }
+}
+
+void BucketPassiveClauseContainer::remove(Clause* cl)
+{
+  CALL("BucketPassiveClauseContainer::remove");
+  if (_isOutermost)
+  {
+    ASS(cl->store()==Clause::Store::PASSIVE);
+  }
+  ASS(_ageRatio > 0 || _weightRatio > 0);
+  bool wasRemoved; // will be assigned, since at least one of the following checks succeeds
+  if (_ageRatio) {
+    wasRemoved = _ageBuckets.remove(cl);
+  }
+  if (_weightRatio) {
+    wasRemoved = _weightBuckets.remove(cl);
+  }
+
+  if (wasRemoved) {
+    _size--;
+  }
+
+  if (_isOutermost)
+  {
+    removedEvent.fire(cl);
+    ASS(cl->store()!=Clause::Store::PASSIVE);
+  }
+}
+
+Clause* BucketPassiveClauseContainer::popSelected()
+{
+  CALL("BucketPassiveClauseContainer::popSelected");
+  ASS( ! isEmpty());
+
+  _size--;
+
+  Clause* cl;
+  if (nextSelectionByWeight()) {
+    cl = _weightBuckets.pop();
+    _ageBuckets.remove(cl);
+  } else {
+    cl = _ageBuckets.pop();
+    _weightBuckets.remove(cl);
+  }
+
+  if (isCompactEntry(cl)) {
+    cl = entryRecord(cl)->materialize();
+    cl->setStore(Clause::Store::PASSIVE);
+  }
+
+  if (_isOutermost) {
+    selectedEvent.fire(cl);
+  }
+
+  return cl;
+}
+
+void BucketPassiveClauseContainer::onLimitsUpdated()
+{
+  CALL("BucketPassiveClauseContainer::onLimitsUpdated");
+
+  if (!limitsCanDiscard()) {
+    return;
+  }
+
+  static Stack<Clause*> toRemove(256);
+  ClauseBucketQueue::Iterator wit(_weightBuckets);
+  while (wit.hasNext()) {
+    Clause* cl=wit.next();
+    // compacted clauses are kept, the limits are only used by LRS anyway
+    if (!isCompactEntry(cl) && exceedsLimits(cl)) {
+      toRemove.push(cl);
+    }
+  }
+  discardOverLimits(toRemove);
+}
+
+void BucketPassiveClauseContainer::simulationInit()
+{
+  CALL("BucketPassiveClauseContainer::simulationInit");
+  ASS(!_compact);
+
+  _simulationBalance = _balance;
+
+  _simulationAgeBucketIt = ClauseBucketQueue::Iterator(_ageBuckets);
+  _simulationWeightBucketIt = ClauseBucketQueue::Iterator(_weightBuckets);
+  _simulationCurrAgeCl = _simulationAgeBucketIt.hasNext() ? _simulationAgeBucketIt.next() : nullptr;
+  _simulationCurrWeightCl = _simulationWeightBucketIt.hasNext() ? _simulationWeightBucketIt.next() : nullptr;
+
+  // see AWPassiveClauseContainer::simulationInit
+  ASS(_simulationCurrAgeCl != nullptr || _simulationCurrWeightCl == nullptr);
+  ASS(_simulationCurrAgeCl == nullptr || _simulationCurrWeightCl != nullptr);
+}
+
+bool BucketPassiveClauseContainer::simulationHasNext()
+{
+  CALL("BucketPassiveClauseContainer::simulationHasNext");
+
+  ASS(_simulationCurrAgeCl != nullptr || _simulationCurrWeightCl == nullptr);
+  ASS(_simulationCurrAgeCl == nullptr || _simulationCurrWeightCl != nullptr);
+  if (_simulationCurrAgeCl == nullptr)
+  {
+    // degenerate case, both containers are empty, so return false
+    return false;
+  }
+
+  // skip the clauses deleted in the simulation, see AWPassiveClauseContainer::simulationHasNext
+  while (_simulationCurrAgeCl->hasAux() && _simulationAgeBucketIt.hasNext())
+  {
+    _simulationCurrAgeCl = _simulationAgeBucketIt.next();
+  }
+  while (_simulationCurrWeightCl->hasAux() && _simulationWeightBucketIt.hasNext())
+  {
+    _simulationCurrWeightCl = _simulationWeightBucketIt.next();
+  }
+
+  ASS(!_simulationCurrAgeCl->hasAux() || _simulationCurrWeightCl->hasAux());
+  ASS(_simulationCurrAgeCl->hasAux() || !_simulationCurrWeightCl->hasAux());
+
+  return !_simulationCurrAgeCl->hasAux();
+}
+
+bool BucketPassiveClauseContainer::setLimitsFromSimulation()
+{
+  CALL("BucketPassiveClauseContainer::setLimitsFromSimulation");
+
+  return AWPassiveClauseContainer::setLimitsFromSimulation(!_simulationAgeBucketIt.hasNext(), !_simulationWeightBucketIt.hasNext());
+}
+
+}
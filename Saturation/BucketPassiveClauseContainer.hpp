@@ -0,0 +1,118 @@
+
+/*
+ * File BucketPassiveClauseContainer.hpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions.
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide.
+ */
+/**
+ * @file BucketPassiveClauseContainer.hpp
+ * Defines class BucketPassiveClauseContainer.
+ */
+
+#ifndef __BucketPassiveClauseContainer__
+#define __BucketPassiveClauseContainer__
+
+#include "Kernel/ClauseBucketQueue.hpp"
+
+#include "AWPassiveClauseContainer.hpp"
+
+namespace Saturation {
+
+using namespace Kernel;
+
+/** Bucket queue of clauses ordered by age */
+class AgeBucketQueue
+: public ClauseBucketQueue
+{
+protected:
+  unsigned key(Clause* cl) override;
+  unsigned id(Clause* cl) override;
+};
+
+/** Bucket queue of clauses ordered by weight */
+class WeightBucketQueue
+: public ClauseBucketQueue
+{
+public:
+  WeightBucketQueue(const Options& opt) : _opt(opt) {}
+protected:
+  unsigned key(Clause* cl) override;
+  unsigned id(Clause* cl) override;
+private:
+  const Shell::Options& _opt;
+};
+
+/**
+ * Age-weight passive container that keeps the clauses in bucket queues
+ * instead of the skip lists of AWPassiveClauseContainer, so that
+ * insertion, selection and removal take constant time. Clauses of the
+ * same age (weight) are selected in the order in which they were added.
+ *
+ * The selection ratio and the limits of the LRS are those of
+ * AWPassiveClauseContainer.
+ *
+ * With the option compact_passive, clauses that nothing else refers to
+ * are replaced by CompactClause records until they are selected. The
+ * queues then contain the records tagged by the lowest bit of the
+ * pointer, see compactEntry().
+ */
+class BucketPassiveClauseContainer
+: public AWPassiveClauseContainer
+{
+public:
+  CLASS_NAME(BucketPassiveClauseContainer);
+  USE_ALLOCATOR(BucketPassiveClauseContainer);
+
+  BucketPassiveClauseContainer(bool isOutermost, const Shell::Options& opt, vstring name);
+  ~BucketPassiveClauseContainer();
+
+  void add(Clause* cl) override;
+  void remove(Clause* cl) override;
+
+  Clause* popSelected() override;
+  /** True if there are no passive clauses */
+  bool isEmpty() const override
+  { return _ageBuckets.isEmpty() && _weightBuckets.isEmpty(); }
+
+  void simulationInit() override;
+  bool simulationHasNext() override;
+  bool setLimitsFromSimulation() override;
+
+  void onLimitsUpdated() override;
+
+  /** True if @b entry of a queue is a compacted clause */
+  static bool isCompactEntry(Clause* entry)
+  { return reinterpret_cast<size_t>(entry) & 1; }
+  static Clause* compactEntry(CompactClause* cc)
+  { return reinterpret_cast<Clause*>(reinterpret_cast<size_t>(cc) | 1); }
+  static CompactClause* entryRecord(Clause* entry)
+  { return reinterpret_cast<CompactClause*>(reinterpret_cast<size_t>(entry) & ~static_cast<size_t>(1)); }
+
+private:
+  /** True if clauses may be compacted */
+  bool _compact;
+
+  /** The age queue, empty if _ageRatio=0 */
+  AgeBucketQueue _ageBuckets;
+  /** The weight queue, empty if _weightRatio=0 */
+  WeightBucketQueue _weightBuckets;
+
+  ClauseBucketQueue::Iterator _simulationAgeBucketIt;
+  ClauseBucketQueue::Iterator _simulationWeightBucketIt;
+}; // class BucketPassiveClauseContainer
+
+}
+
+#endif
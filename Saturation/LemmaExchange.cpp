@@ -0,0 +1,377 @@
+
+/*
+ * File LemmaExchange.cpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions.
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide.
+ */
+/**
+ * @file LemmaExchange.cpp
+ * Implements class LemmaExchange.
+ */
+
+#include <cerrno>
+#include <cstring>
+
+#ifdef _WIN32
+#else
+#include <unistd.h>
+#include <sys/mman.h>
+#endif
+
+#include "Lib/Environment.hpp"
+#include "Lib/Exception.hpp"
+#include "Lib/Hash.hpp"
+
+#include "Kernel/Clause.hpp"
+#include "Kernel/ColorHelper.hpp"
+#include "Kernel/Inference.hpp"
+#include "Kernel/Signature.hpp"
+#include "Kernel/SortHelper.hpp"
+#include "Kernel/Sorts.hpp"
+
+#include "Shell/Statistics.hpp"
+
+#include "SaturationAlgorithm.hpp"
+
+#include "LemmaExchange.hpp"
+
+/** Number of words of the shared buffer, the memory is committed lazily by the OS */
+#define LEMMA_EXCHANGE_CAPACITY (1u<<24)
+
+/** Number of header words of each record: the record length, the publishing process,
+ * the input type and the clause length */
+#define RECORD_HEADER_LENGTH 4
+
+namespace Saturation
+{
+
+using namespace Lib;
+using namespace Kernel;
+
+LemmaExchange* LemmaExchange::s_instance = 0;
+
+/**
+ * Create the exchange in the portfolio parent process. Must be called
+ * before the first slice is forked and after the problem was parsed and
+ * normalised.
+ */
+LemmaExchange::LemmaExchange()
+: _buf(0), _mappedSize(0), _writeLock(1), _readPos(0), _salg(0), _maxWeight(0), _maxImports(0), _pid(0)
+{
+  CALL("LemmaExchange::LemmaExchange");
+  ASS(!s_instance);
+
+  _functions = env.signature->functions();
+  _predicates = env.signature->predicates();
+  _sorts = env.sorts->count();
+
+#ifdef _WIN32
+  // there are no forked slices to talk to
+#else
+  _mappedSize = sizeof(Buffer) + LEMMA_EXCHANGE_CAPACITY*sizeof(unsigned);
+  errno = 0;
+  void* mem = mmap(0, _mappedSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+  if (mem==MAP_FAILED) {
+    SYSTEM_FAIL("Cannot map shared memory for the lemma exchange.", errno);
+  }
+  _buf = ::new(mem) Buffer;
+  _buf->used = 0;
+  _buf->capacity = LEMMA_EXCHANGE_CAPACITY;
+#endif
+  _writeLock.set(0,1);
+
+  s_instance = this;
+}
+
+LemmaExchange::~LemmaExchange()
+{
+  CALL("LemmaExchange::~LemmaExchange");
+  ASS_EQ(s_instance,this);
+
+#ifdef _WIN32
+#else
+  if (_buf) {
+    munmap(_buf, _mappedSize);
+  }
+#endif
+  s_instance = 0;
+}
+
+/**
+ * Start publishing activated clauses of weight at most @b maxWeight of the
+ * saturation algorithm @b salg and importing the lemmas of other slices into it,
+ * at most @b maxImports at a time.
+ */
+void LemmaExchange::attach(SaturationAlgorithm* salg, unsigned maxWeight, unsigned maxImports)
+{
+  CALL("LemmaExchange::attach");
+  ASS(!_salg);
+
+  _salg = salg;
+  _maxWeight = maxWeight;
+  _maxImports = maxImports;
+#ifdef _WIN32
+#else
+  _pid = getpid();
+#endif
+}
+
+void LemmaExchange::detach()
+{
+  CALL("LemmaExchange::detach");
+  ASS(_salg);
+
+  _salg = 0;
+}
+
+/**
+ * Return true if clause @b cl is worth making available to other slices
+ *
+ * We share only short units and ground clauses that do not depend on
+ * splitting assumptions and that were really derived, not just read
+ * from the input (or imported from other slices).
+ */
+bool LemmaExchange::shouldPublish(Clause* cl)
+{
+  CALL("LemmaExchange::shouldPublish");
+
+  if (cl->age()==0 || cl->weight()>_maxWeight || !cl->noSplits() ||
+      cl->color()!=COLOR_TRANSPARENT || cl->isTheoryAxiom()) {
+    return false;
+  }
+  if (cl->length()==1) {
+    return true;
+  }
+  unsigned clen = cl->length();
+  for (unsigned i=0; i<clen; i++) {
+    if (!(*cl)[i]->ground()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void LemmaExchange::onClauseActivated(Clause* cl)
+{
+  CALL("LemmaExchange::onClauseActivated");
+
+  if (!_buf || !shouldPublish(cl)) {
+    return;
+  }
+  if (encodeClause(cl)) {
+    publish();
+  }
+}
+
+/**
+ * Encode term @b t into @b _record. Return false if @b t contains
+ * a symbol that is not shared by all the slices.
+ *
+ * Variables are encoded as odd numbers, functions as even numbers
+ * followed by their arguments. The variables are renumbered by
+ * @b _varNumbers.
+ */
+bool LemmaExchange::encodeTerm(TermList t)
+{
+  CALL("LemmaExchange::encodeTerm");
+
+  if (t.isOrdinaryVar()) {
+    unsigned var;
+    _varNumbers.findOrInsert(t.var(), var, _varNumbers.size());
+    _record.push((var<<1) | 1);
+    return true;
+  }
+  if (t.isSpecialVar()) {
+    return false;
+  }
+  Term* trm = t.term();
+  if (trm->isSpecial() || trm->functor()>=_functions) {
+    return false;
+  }
+  _record.push(trm->functor()<<1);
+  for (TermList* arg = trm->args(); !arg->isEmpty(); arg = arg->next()) {
+    if (!encodeTerm(*arg)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * Encode clause @b cl into @b _record including the record header.
+ * Return false if the clause cannot be exchanged.
+ */
+bool LemmaExchange::encodeClause(Clause* cl)
+{
+  CALL("LemmaExchange::encodeClause");
+
+  _record.reset();
+  _varNumbers.reset();
+  _record.push(0); // the record length, filled in at the end
+  _record.push(_pid);
+  _record.push(static_cast<unsigned>(cl->inputType()));
+  _record.push(cl->length());
+
+  unsigned clen = cl->length();
+  for (unsigned i=0; i<clen; i++) {
+    Literal* lit = (*cl)[i];
+    if (lit->functor()>=_predicates) {
+      return false;
+    }
+    _record.push((lit->functor()<<1) | (lit->polarity() ? 1 : 0));
+    if (lit->isEquality()) {
+      unsigned sort = SortHelper::getEqualityArgumentSort(lit);
+      if (sort>=_sorts) {
+        return false;
+      }
+      _record.push(sort);
+    }
+    for (TermList* arg = lit->args(); !arg->isEmpty(); arg = arg->next()) {
+      if (!encodeTerm(*arg)) {
+        return false;
+      }
+    }
+  }
+  _record[0] = _record.size();
+  return true;
+}
+
+/**
+ * Append the record in @b _record to the shared buffer. If the buffer
+ * is full, the record is silently dropped.
+ */
+void LemmaExchange::publish()
+{
+  CALL("LemmaExchange::publish");
+
+  _writeLock.dec(0);
+  size_t pos = _buf->used.load(std::memory_order_relaxed);
+  bool fits = pos + _record.size() <= _buf->capacity;
+  if (fits) {
+    memcpy(_buf->data+pos, _record.begin(), _record.size()*sizeof(unsigned));
+    _buf->used.store(pos+_record.size(), std::memory_order_release);
+  }
+  _writeLock.inc(0);
+
+  if (fits) {
+    env.statistics->exportedLemmas++;
+  }
+}
+
+TermList LemmaExchange::decodeTerm(const unsigned*& ptr)
+{
+  CALL("LemmaExchange::decodeTerm");
+
+  unsigned code = *(ptr++);
+  if (code & 1) {
+    return TermList(code>>1, false);
+  }
+  unsigned functor = code>>1;
+  unsigned arity = env.signature->functionArity(functor);
+  if (!arity) {
+    return TermList(Term::createConstant(functor));
+  }
+  size_t argsStart = _args.size();
+  for (unsigned i=0; i<arity; i++) {
+    TermList arg = decodeTerm(ptr);
+    _args.push(arg);
+  }
+  Term* res = Term::create(functor, arity, _args.begin()+argsStart);
+  _args.truncate(argsStart);
+  return TermList(res);
+}
+
+Literal* LemmaExchange::decodeLiteral(const unsigned*& ptr)
+{
+  CALL("LemmaExchange::decodeLiteral");
+
+  unsigned code = *(ptr++);
+  unsigned pred = code>>1;
+  bool polarity = code & 1;
+  if (pred==0) {
+    unsigned sort = *(ptr++);
+    TermList lhs = decodeTerm(ptr);
+    TermList rhs = decodeTerm(ptr);
+    return Literal::createEquality(polarity, lhs, rhs, sort);
+  }
+  unsigned arity = env.signature->predicateArity(pred);
+  size_t argsStart = _args.size();
+  for (unsigned i=0; i<arity; i++) {
+    TermList arg = decodeTerm(ptr);
+    _args.push(arg);
+  }
+  Literal* res = Literal::create(pred, arity, polarity, false, _args.begin()+argsStart);
+  _args.truncate(argsStart);
+  return res;
+}
+
+/**
+ * Create a clause of input type @b inputType from the encoded literals at @b rec
+ */
+Clause* LemmaExchange::decodeClause(UnitInputType inputType, const unsigned* rec, unsigned litCnt)
+{
+  CALL("LemmaExchange::decodeClause");
+
+  Clause* res = new(litCnt) Clause(litCnt,
+      NonspecificInference0(inputType,InferenceRule::IMPORTED_LEMMA));
+  for (unsigned i=0; i<litCnt; i++) {
+    (*res)[i] = decodeLiteral(rec);
+  }
+  return res;
+}
+
+unsigned LemmaExchange::RecordHash::hash(const unsigned* rec)
+{
+  return Hash::hash(reinterpret_cast<const unsigned char*>(rec+2), (rec[0]-2)*sizeof(unsigned));
+}
+
+bool LemmaExchange::RecordHash::equals(const unsigned* rec1, const unsigned* rec2)
+{
+  return rec1[0]==rec2[0] && !memcmp(rec1+2, rec2+2, (rec1[0]-2)*sizeof(unsigned));
+}
+
+/**
+ * Add clauses published by other slices since the last call
+ * to the saturation algorithm as new clauses. Lemmas that were
+ * already imported are skipped, and at most @b _maxImports lemmas
+ * are added, the rest are left for the next calls.
+ */
+void LemmaExchange::importLemmas()
+{
+  CALL("LemmaExchange::importLemmas");
+  ASS(_salg);
+
+  if (!_buf) {
+    return;
+  }
+  size_t end = _buf->used.load(std::memory_order_acquire);
+  unsigned imported = 0;
+  while (_readPos<end && imported<_maxImports) {
+    const unsigned* rec = _buf->data+_readPos;
+    unsigned recLen = rec[0];
+    ASS_GE(recLen, RECORD_HEADER_LENGTH);
+    _readPos += recLen;
+
+    if (rec[1]==_pid || _imported.insert(rec)!=rec) {
+      continue;
+    }
+    Clause* cl = decodeClause(static_cast<UnitInputType>(rec[2]), rec+RECORD_HEADER_LENGTH, rec[3]);
+    imported++;
+    env.statistics->importedLemmas++;
+    _salg->addNewClause(cl);
+  }
+}
+
+}
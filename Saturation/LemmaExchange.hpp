@@ -0,0 +1,153 @@
+
+/*
+ * File LemmaExchange.hpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions.
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide.
+ */
+/**
+ * @file LemmaExchange.hpp
+ * Defines class LemmaExchange for sharing lemmas among portfolio slices.
+ */
+
+#ifndef __LemmaExchange__
+#define __LemmaExchange__
+
+#include <atomic>
+
+#include "Forwards.hpp"
+
+#include "Lib/Allocator.hpp"
+#include "Lib/DHMap.hpp"
+#include "Lib/Set.hpp"
+#include "Lib/Stack.hpp"
+#include "Lib/Sys/Semaphore.hpp"
+
+#include "Kernel/Term.hpp"
+#include "Kernel/Unit.hpp"
+
+namespace Saturation {
+
+using namespace Lib;
+using namespace Kernel;
+
+/**
+ * Channel through which the slices of a portfolio run publish small
+ * derived clauses (units and ground clauses) and import the clauses
+ * published by the other slices.
+ *
+ * The object is created by the portfolio parent before the first slice is
+ * forked. Clauses are stored in an append-only block of shared memory, so
+ * also slices started later can import lemmas of slices that have already
+ * finished. Writers are serialized by a semaphore, readers only follow the
+ * published end of the buffer.
+ *
+ * Clauses are transferred in terms of symbol numbers. Only symbols that
+ * existed when the exchange was created (i.e. the symbols of the parsed
+ * and normalised problem, which are the same in all the slices) may occur
+ * in exchanged clauses; symbols introduced by the slices themselves
+ * (skolem functions, names, splitting predicates) differ from slice to
+ * slice.
+ *
+ * The variables of a clause are numbered in the order of their first
+ * occurrence, so that a lemma published by several slices is imported
+ * only once.
+ */
+class LemmaExchange {
+public:
+  CLASS_NAME(LemmaExchange);
+  USE_ALLOCATOR(LemmaExchange);
+
+  LemmaExchange();
+  ~LemmaExchange();
+
+  /**
+   * Return the exchange of the current portfolio run, or zero if
+   * there is none.
+   */
+  static LemmaExchange* instance() { return s_instance; }
+
+  void attach(SaturationAlgorithm* salg, unsigned maxWeight, unsigned maxImports);
+  void detach();
+
+  void onClauseActivated(Clause* cl);
+  void importLemmas();
+
+private:
+  /**
+   * The part of the exchange that lives in the shared memory.
+   *
+   * @b used is the number of words of @b data that contain complete
+   * records. It only grows and is written only while holding the
+   * semaphore.
+   */
+  struct Buffer {
+    std::atomic<size_t> used;
+    size_t capacity;
+    unsigned data[1];
+  };
+
+  /** Compares records by their content, without the publishing process */
+  struct RecordHash {
+    static unsigned hash(const unsigned* rec);
+    static bool equals(const unsigned* rec1, const unsigned* rec2);
+  };
+
+  bool shouldPublish(Clause* cl);
+  bool encodeClause(Clause* cl);
+  bool encodeTerm(TermList t);
+  void publish();
+
+  Clause* decodeClause(UnitInputType inputType, const unsigned* rec, unsigned litCnt);
+  Literal* decodeLiteral(const unsigned*& ptr);
+  TermList decodeTerm(const unsigned*& ptr);
+
+  static LemmaExchange* s_instance;
+
+  Buffer* _buf;
+  /** Size of the shared memory block in bytes */
+  size_t _mappedSize;
+  /** Serializes the writers */
+  Sys::Semaphore _writeLock;
+
+  /** Position in @b _buf->data up to which the current process imported the lemmas */
+  size_t _readPos;
+
+  /** Number of functions in the signature when the exchange was created */
+  unsigned _functions;
+  /** Number of predicates in the signature when the exchange was created */
+  unsigned _predicates;
+  /** Number of sorts when the exchange was created */
+  unsigned _sorts;
+
+  SaturationAlgorithm* _salg;
+  unsigned _maxWeight;
+  /** Maximal number of lemmas added by one call to importLemmas() */
+  unsigned _maxImports;
+  /** Process id of the slice, records published by the slice itself are not imported */
+  unsigned _pid;
+
+  /** The records imported so far, they point into @b _buf */
+  Set<const unsigned*,RecordHash> _imported;
+
+  /** Record that is being encoded */
+  Stack<unsigned> _record;
+  /** Numbers of the variables of the clause that is being encoded */
+  DHMap<unsigned,unsigned> _varNumbers;
+  Stack<TermList> _args;
+};
+
+}
+
+#endif // __LemmaExchange__
@@ -83,11 +83,13 @@
 
 #include "ConsequenceFinder.hpp"
 #include "LabelFinder.hpp"
+#include "LemmaExchange.hpp"
 #include "Splitter.hpp"
 #include "SymElOutput.hpp"
 #include "SaturationAlgorithm.hpp"
 #include "ManCSPassiveClauseContainer.hpp"
 #include "AWPassiveClauseContainer.hpp"
+#include "BucketPassiveClauseContainer.hpp"
 #include "PredicateSplitPassiveClauseContainer.hpp"
 #include "Discount.hpp"
 #include "LRS.hpp"
@@ -104,12 +106,17 @@ using namespace Saturation;
 #define REPORT_FW_SIMPL 0
 /** Print information about performed backward simplifications */
 #define REPORT_BW_SIMPL 0
+/** Activations generating at least this many clauses are counted as heavy in the statistics */
+#define HEAVY_ACTIVATION_CHILDREN 1000
 
 
 SaturationAlgorithm* SaturationAlgorithm::s_instance = 0;
 
 std::unique_ptr<PassiveClauseContainer> makeLevel0(bool isOutermost, const Options& opt, vstring name)
 {
+  if (opt.passiveBucketQueues()) {
+    return Lib::make_unique<BucketPassiveClauseContainer>(isOutermost, opt, name + "BQ");
+  }
   return Lib::make_unique<AWPassiveClauseContainer>(isOutermost, opt, name + "AWQ");
 }
 
@@ -199,7 +206,7 @@ SaturationAlgorithm::SaturationAlgorithm(Problem& prb, const Options& opt)
   : MainLoop(prb, opt),
     _clauseActivationInProgress(false),
     _fwSimplifiers(0), _bwSimplifiers(0), _splitter(0),
-    _consFinder(0), _labelFinder(0), _symEl(0), _answerLiteralManager(0),
+    _consFinder(0), _labelFinder(0), _symEl(0), _lemmaExchange(0), _answerLiteralManager(0),
     _instantiation(0),
 #if VZ3
     _theoryInstSimp(0),
@@ -274,6 +281,9 @@ SaturationAlgorithm::~SaturationAlgorithm()
   if (_symEl) {
     delete _symEl;
   }
+  if (_lemmaExchange) {
+    _lemmaExchange->detach();
+  }
 
   _active->detach();
   _passive->detach();
@@ -748,6 +758,9 @@ void SaturationAlgorithm::init()
   if (_symEl) {
     _symEl->init(this);
   }
+  if (_lemmaExchange) {
+    _lemmaExchange->attach(this, _opt.lemmaExchangeWeight(), _opt.lemmaExchangeImports());
+  }
 
   _startTime=env.timer->elapsedMilliseconds();
 }
@@ -933,12 +946,15 @@ bool SaturationAlgorithm::forwardSimplify(Clause* cl)
     return false;
   }
 
-  FwSimplList::Iterator fsit(_fwSimplifiers);
+  {
+    // the time spent in the engines, the retention of the clause is not included
+    TimeCounter tc(Lib::TimeCounterUnit::TC_FORWARD_SIMPLIFICATION);
 
-  while (fsit.hasNext()) {
-    ForwardSimplificationEngine* fse=fsit.next();
+    FwSimplList::Iterator fsit(_fwSimplifiers);
+
+    while (fsit.hasNext()) {
+      ForwardSimplificationEngine* fse=fsit.next();
 
-    {
       Clause* replacement = 0;
       ClauseIterator premises = ClauseIterator::getEmpty();
 
@@ -1109,11 +1125,17 @@ bool SaturationAlgorithm::activate(Clause* cl)
   env.statistics->activeClauses++;
   _active->add(cl);
 
+  if (_lemmaExchange) {
+    _lemmaExchange->onClauseActivated(cl);
+  }
+
 
     ClauseIterator toAdd= pvi(getConcatenatedIterator(instances,_generator->generateClauses(cl)));
 
+    unsigned childCnt=0;
     while (toAdd.hasNext()) {
       Clause* genCl=toAdd.next();
+      childCnt++;
 
       addNewClause(genCl);
 
@@ -1127,6 +1149,13 @@ bool SaturationAlgorithm::activate(Clause* cl)
       }
     }
 
+    if (childCnt>env.statistics->maxActivationChildren) {
+      env.statistics->maxActivationChildren=childCnt;
+    }
+    if (childCnt>=HEAVY_ACTIVATION_CHILDREN) {
+      env.statistics->heavyActivations++;
+    }
+
   _clauseActivationInProgress=false;
 
 
@@ -1240,6 +1269,10 @@ void SaturationAlgorithm::doOneAlgorithmStep()
 {
   CALL("SaturationAlgorithm::doOneAlgorithmStep");
 
+  if (_lemmaExchange) {
+    _lemmaExchange->importLemmas();
+  }
+
   doUnprocessedLoop();
 
   if (_passive->isEmpty()) {
@@ -1547,6 +1580,9 @@ SaturationAlgorithm* SaturationAlgorithm::createFromOptions(Problem& prb, const
   if (opt.showSymbolElimination()) {
     res->_symEl=new SymElOutput();
   }
+  if (opt.lemmaExchange()) {
+    res->_lemmaExchange = LemmaExchange::instance();
+  }
   if (opt.questionAnswering()==Options::QuestionAnsweringMode::ANSWER_LITERAL) {
     res->_answerLiteralManager = AnswerLiteralManager::getInstance();
   }
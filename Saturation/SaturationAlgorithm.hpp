@@ -205,6 +205,7 @@ protected:
   ConsequenceFinder* _consFinder;
   LabelFinder* _labelFinder;
   SymElOutput* _symEl;
+  LemmaExchange* _lemmaExchange;
   AnswerLiteralManager* _answerLiteralManager;
   Instantiation* _instantiation;
 #if VZ3
@@ -52,6 +52,8 @@
 #include "SAT/BufferedSolver.hpp"
 #include "SAT/FallbackSolverWrapper.hpp"
 #include "SAT/MinisatInterfacing.hpp"
+#include "SAT/CDCLSolver.hpp"
+#include "SAT/LingelingInterfacing.hpp"
 #include "SAT/Z3Interfacing.hpp"
 
 #include "DP/ShortConflictMetaDP.hpp"
@@ -83,6 +85,12 @@ void SplittingBranchSelector::init()
     case Options::SatSolver::MINISAT:
       _solver = new MinisatInterfacing(_parent.getOptions(),true);
       break;      
+    case Options::SatSolver::CDCL:
+      _solver = new CDCLSolver(_parent.getOptions(),true);
+      break;
+    case Options::SatSolver::LINGELING:
+      _solver = new LingelingInterfacing(_parent.getOptions(),true);
+      break;
 #if VZ3
     case Options::SatSolver::Z3:
       { BYPASSING_ALLOCATOR
@@ -194,6 +194,33 @@ void Options::Options::init()
         Or(_mode.is(equal(Mode::SMTCOMP)))->
         Or(_mode.is(equal(Mode::PORTFOLIO)))));
 
+    _splitMemoryLimit = BoolOptionValue("split_memory_limit","sml",false);
+    _splitMemoryLimit.description = "When running in portfolio mode on several cores, make memory_limit apply to the whole portfolio "
+      "rather than to each slice. Memory used by the parsed and normalised problem, which is shared by all slices, is counted "
+      "only once and the rest is divided among the slices running at the same time.";
+    _lookup.insert(&_splitMemoryLimit);
+    _splitMemoryLimit.reliesOn(_multicore.is(notEqual(1u)));
+
+    _lemmaExchange = BoolOptionValue("lemma_exchange","lex",false);
+    _lemmaExchange.description = "When running in portfolio mode, let the slices publish small derived unit and ground clauses "
+      "and add the clauses published by other slices to their own search.";
+    _lookup.insert(&_lemmaExchange);
+    _lemmaExchange.reliesOnHard(_mode.is(equal(Mode::CASC)->
+        Or(_mode.is(equal(Mode::CASC_SAT)))->
+        Or(_mode.is(equal(Mode::SMTCOMP)))->
+        Or(_mode.is(equal(Mode::PORTFOLIO)))));
+
+    _lemmaExchangeWeight = UnsignedOptionValue("lemma_exchange_weight","lexw",20);
+    _lemmaExchangeWeight.description = "Maximal weight of a clause published through lemma_exchange";
+    _lookup.insert(&_lemmaExchangeWeight);
+    _lemmaExchangeWeight.reliesOn(_lemmaExchange.is(equal(true)));
+
+    _lemmaExchangeImports = UnsignedOptionValue("lemma_exchange_imports","lexi",100);
+    _lemmaExchangeImports.description = "Maximal number of lemmas imported through lemma_exchange in one step of the saturation loop, the rest are imported in the next steps";
+    _lookup.insert(&_lemmaExchangeImports);
+    _lemmaExchangeImports.reliesOn(_lemmaExchange.is(equal(true)));
+    _lemmaExchangeImports.addHardConstraint(greaterThan(0u));
+
     _ltbLearning = ChoiceOptionValue<LTBLearning>("ltb_learning","ltbl",LTBLearning::OFF,{"on","off","biased"});
     _ltbLearning.description = "Perform learning in LTB mode";
     _lookup.insert(&_ltbLearning);
@@ -842,6 +869,35 @@ void Options::Options::init()
     _fmbEnumerationStrategy.setExperimental();
     _lookup.insert(&_fmbEnumerationStrategy);
 
+    _fmbIncremental = BoolOptionValue("fmb_incremental","fmbi",false);
+    _fmbIncremental.description = "Keep the SAT solver and the instances of the clauses when the model sizes grow. The constraints that only hold for the current sizes are switched on by assumptions.";
+    _fmbIncremental.reliesOn(_fmbEnumerationStrategy.is(notEqual(FMBEnumerationStrategy::CONTOUR)));
+    _fmbIncremental.setExperimental();
+    _lookup.insert(&_fmbIncremental);
+
+    _fmbLazyInstances = BoolOptionValue("fmb_lazy_instances","fmbli",false);
+    _fmbLazyInstances.description = "Add the instances of the clauses only when the candidate model found by the SAT solver violates them, and solve again until no instance is violated.";
+    _fmbLazyInstances.reliesOn(_fmbIncremental.is(equal(false)));
+    _fmbLazyInstances.setExperimental();
+    _lookup.insert(&_fmbLazyInstances);
+
+    _fmbInstanceMemoryLimit = UnsignedOptionValue("fmb_instance_memory_limit","fmbiml",0);
+    _fmbInstanceMemoryLimit.description = "If the instances of the clauses for the current model sizes are estimated to take more than this many MB in the SAT solver, add them lazily as with fmb_lazy_instances. 0 means no limit.";
+    _fmbInstanceMemoryLimit.reliesOn(_fmbIncremental.is(equal(false)));
+    _fmbInstanceMemoryLimit.setExperimental();
+    _lookup.insert(&_fmbInstanceMemoryLimit);
+
+    _fmbWorkers = UnsignedOptionValue("fmb_workers","fmbw",1);
+    _fmbWorkers.description = "The number of model sizes tried at the same time, each in its own forked process. The nogoods learnt from the sizes without a model are collected by the parent process, which hands out the next sizes to try.";
+    _fmbWorkers.reliesOn(_fmbEnumerationStrategy.is(notEqual(FMBEnumerationStrategy::CONTOUR)));
+    _fmbWorkers.reliesOn(_fmbIncremental.is(equal(false)));
+    _fmbWorkers.setExperimental();
+    _lookup.insert(&_fmbWorkers);
+#ifdef _WIN32
+    // there is no fork on Windows
+    _fmbWorkers.addHardConstraint(lessThanEq(1u));
+#endif
+
     _selection = SelectionOptionValue("selection","s",10);
     _selection.description=
     "Selection methods 2,3,4,10,11 are complete by virtue of extending Maximal i.e. they select the best among maximal. Methods 1002,1003,1004,1010,1011 relax this restriction and are therefore not complete.\n"
@@ -893,6 +949,17 @@ void Options::Options::init()
     _lookup.insert(&_ageWeightRatioShapeFrequency);
     _ageWeightRatioShapeFrequency.tag(OptionTag::SATURATION);
 
+    _passiveBucketQueues = BoolOptionValue("passive_bucket_queues","pbq",false);
+    _passiveBucketQueues.description = "Keep the passive clauses in queues with one bucket per age and per weight instead of in skip lists. Clauses of the same age (weight) are then selected in the order in which they were generated.";
+    _lookup.insert(&_passiveBucketQueues);
+    _passiveBucketQueues.tag(OptionTag::SATURATION);
+
+    _compactPassive = BoolOptionValue("compact_passive","cps",false);
+    _compactPassive.description = "Keep passive clauses as compact records and build the clause objects again when the clauses are selected. The saving is small: a record is 56 bytes smaller than the clause object on 64-bit builds, while the literals and the inference are kept as they are. Only clauses that nothing else refers to are compacted, and only with the discount saturation algorithm.";
+    _lookup.insert(&_compactPassive);
+    _compactPassive.reliesOn(_passiveBucketQueues.is(equal(true)));
+    _compactPassive.tag(OptionTag::SATURATION);
+
     _useTheorySplitQueues = BoolOptionValue("theory_split_queue","thsq",false);
     _useTheorySplitQueues.description = "Turn on clause selection using multiple queues containing different clauses (split by amount of theory reasoning)";
     _lookup.insert(&_useTheorySplitQueues);
@@ -1168,6 +1235,20 @@ void Options::Options::init()
 	    _backwardSubsumption.reliesOn(_saturationAlgorithm.is(notEqual(SaturationAlgorithm::INST_GEN))->Or<Subsumption>(_instGenWithResolution.is(equal(true))));
 	    _backwardSubsumption.setRandomChoices({"on","off"});
 
+	    _featureVectorSubsumption = BoolOptionValue("feature_vector_subsumption","fvs",false);
+	    _featureVectorSubsumption.description=
+		     "Find the clauses that may be subsumed by a non-unit clause in backward subsumption through an index of the feature vectors of the clauses (counts and depths of symbols), instead of through the instances of one of its literals";
+	    _featureVectorSubsumption.setExperimental();
+	    _lookup.insert(&_featureVectorSubsumption);
+	    _featureVectorSubsumption.tag(OptionTag::INFERENCES);
+
+	    _mlMatcherBitsets = BoolOptionValue("mlmatcher_bitsets","mlmb",false);
+	    _mlMatcherBitsets.description=
+		     "In multi-literal matching for subsumption, keep the literals of the instance clause that each literal of the subsuming clause can be matched to in bitsets. Candidates are refuted early when the literals cannot be matched to distinct literals, and the search skips literals that are already used through the bitsets";
+	    _mlMatcherBitsets.setExperimental();
+	    _lookup.insert(&_mlMatcherBitsets);
+	    _mlMatcherBitsets.tag(OptionTag::INFERENCES);
+
 	    _backwardSubsumptionResolution = ChoiceOptionValue<Subsumption>("backward_subsumption_resolution","bsr",
 									    Subsumption::OFF,{"off","on","unit_only"});
 	    _backwardSubsumptionResolution.description=
@@ -1304,6 +1385,13 @@ void Options::Options::init()
 	    _lookup.insert(&_forwardDemodulation);
 	    _forwardDemodulation.tag(OptionTag::INFERENCES);
 	    _forwardDemodulation.setRandomChoices({"all","all","all","off","preordered"});
+
+    _forwardDemodulationCache = BoolOptionValue("forward_demodulation_cache","fdc",false);
+    _forwardDemodulationCache.description="Remember the terms that forward demodulation found in normal form until new demodulators are added, and skip them in other clauses.";
+    _forwardDemodulationCache.setExperimental();
+    _lookup.insert(&_forwardDemodulationCache);
+    _forwardDemodulationCache.reliesOn(_forwardDemodulation.is(notEqual(Demodulation::OFF)));
+    _forwardDemodulationCache.tag(OptionTag::INFERENCES);
     
     _forwardLiteralRewriting = BoolOptionValue("forward_literal_rewriting","flr",false);
     _forwardLiteralRewriting.description="Perform forward literal rewriting.";
@@ -1326,6 +1414,20 @@ void Options::Options::init()
     _forwardSubsumptionResolution    .reliesOn(_saturationAlgorithm.is(notEqual(SaturationAlgorithm::INST_GEN))->Or<bool>(_instGenWithResolution.is(equal(true))));
     _forwardSubsumptionResolution.setRandomChoices({"on","off"});
 
+    _flatSubsumptionIndex = BoolOptionValue("flat_subsumption_index","fsi",false);
+    _flatSubsumptionIndex.description="Look up generalizations of literals for forward subsumption and subsumption resolution in read-only flattened copies of the substitution trees. A copy is made again after the tree is modified and enough queries were made to it.";
+    _flatSubsumptionIndex.setExperimental();
+    _lookup.insert(&_flatSubsumptionIndex);
+    _flatSubsumptionIndex.tag(OptionTag::INFERENCES);
+
+    _fingerprintIndex = ChoiceOptionValue<FingerprintIndexUse>("fingerprint_index","",
+                                                                FingerprintIndexUse::OFF,
+                                                                {"off","superposition","demodulation","all"});
+    _fingerprintIndex.description="Keep the terms for superposition, demodulation or both in fingerprint indexes instead of substitution trees and code trees. Not used with unification with abstraction.";
+    _fingerprintIndex.setExperimental();
+    _lookup.insert(&_fingerprintIndex);
+    _fingerprintIndex.tag(OptionTag::INFERENCES);
+
     _hyperSuperposition = BoolOptionValue("hyper_superposition","",false);
     _hyperSuperposition.description=
     "Simplifying inference that attempts to do several rewritings at once if it will eliminate literals of the original clause (now we aim just for elimination by equality resolution)";
@@ -1724,12 +1826,15 @@ void Options::Options::init()
 
     _satSolver = ChoiceOptionValue<SatSolver>("sat_solver","sas",SatSolver::MINISAT,
 #if VZ3
-            {"minisat","vampire","z3"});
+            {"minisat","vampire","cdcl","lingeling","z3"});
 #else
-    {"minisat","vampire"});
+    {"minisat","vampire","cdcl","lingeling"});
 #endif
     _satSolver.description=
-    "Select the SAT solver to be used throughout the solver. This will be used in AVATAR (for splitting) when the saturation algorithm is discount,lrs or otter and in instance generation for selection and global subsumption.";
+    "Select the SAT solver to be used throughout the solver. This will be used in AVATAR (for splitting) when the saturation algorithm is discount,lrs or otter and in instance generation for selection and global subsumption."
+    " The cdcl solver (a built-in CDCL solver with LBD based clause management, chronological backtracking"
+    " and inprocessing) and lingeling (the bundled Lingeling solver with its stronger preprocessing) are also"
+    " used by the finite model builder and by --mode sat_solver.";
     _lookup.insert(&_satSolver);
     _satSolver.tag(OptionTag::SAT);
     _satSolver.setRandomChoices(
@@ -1872,6 +1977,13 @@ void Options::Options::init()
     _termOrdering.tag(OptionTag::SATURATION);
     _lookup.insert(&_termOrdering);
 
+    _kboCache = BoolOptionValue("kbo_cache","kboc",false);
+    _kboCache.description="Let the Knuth-Bendix ordering use the weights and variable counts stored in shared terms to avoid traversing them, remember the results of recent comparisons of shared terms, and prepare cheaper ordering checks for demodulators with incomparable sides.";
+    _kboCache.setExperimental();
+    _lookup.insert(&_kboCache);
+    _kboCache.reliesOn(_termOrdering.is(equal(TermOrdering::KBO)));
+    _kboCache.tag(OptionTag::SATURATION);
+
     _symbolPrecedence = ChoiceOptionValue<SymbolPrecedence>("symbol_precedence","sp",SymbolPrecedence::ARITY,
                                                             {"arity","occurrence","reverse_arity","scramble",
                                                              "frequency","reverse_frequency",
@@ -514,9 +514,11 @@ public:
   /** Possible values for sat_solver */
   enum class SatSolver : unsigned int {
      MINISAT = 0,
-     VAMPIRE = 1
+     VAMPIRE = 1,
+     CDCL = 2,
+     LINGELING = 3
 #if VZ3
-     ,Z3 = 2
+     ,Z3 = 4
 #endif
   };
 
@@ -569,6 +571,14 @@ public:
     PREORDERED = 2
   };
 
+  /** Indexes of terms that are fingerprint indexes instead of substitution or code trees */
+  enum class FingerprintIndexUse : unsigned int {
+    OFF = 0,
+    SUPERPOSITION = 1,
+    DEMODULATION = 2,
+    ALL = 3
+  };
+
   enum class Subsumption : unsigned int {
     OFF = 0,
     ON = 1,
@@ -1854,6 +1864,10 @@ public:
   unsigned fmbDetectSortBoundsTimeLimit() const { return _fmbDetectSortBoundsTimeLimit.actualValue; }
   unsigned fmbSizeWeightRatio() const { return _fmbSizeWeightRatio.actualValue; }
   FMBEnumerationStrategy fmbEnumerationStrategy() const { return _fmbEnumerationStrategy.actualValue; }
+  bool fmbIncremental() const { return _fmbIncremental.actualValue; }
+  bool fmbLazyInstances() const { return _fmbLazyInstances.actualValue; }
+  unsigned fmbInstanceMemoryLimit() const { return _fmbInstanceMemoryLimit.actualValue; }
+  unsigned fmbWorkers() const { return _fmbWorkers.actualValue; }
 
   bool flattenTopLevelConjunctions() const { return _flattenTopLevelConjunctions.actualValue; }
   LTBLearning ltbLearning() const { return _ltbLearning.actualValue; }
@@ -1864,6 +1878,10 @@ public:
   void setSchedule(Schedule newVal) {  _schedule.actualValue = newVal; }
   unsigned multicore() const { return _multicore.actualValue; }
   void setMulticore(unsigned newVal) { _multicore.actualValue = newVal; }
+  bool splitMemoryLimit() const { return _splitMemoryLimit.actualValue; }
+  bool lemmaExchange() const { return _lemmaExchange.actualValue; }
+  unsigned lemmaExchangeWeight() const { return _lemmaExchangeWeight.actualValue; }
+  unsigned lemmaExchangeImports() const { return _lemmaExchangeImports.actualValue; }
   InputSyntax inputSyntax() const { return _inputSyntax.actualValue; }
   void setInputSyntax(InputSyntax newVal) { _inputSyntax.actualValue = newVal; }
   bool normalize() const { return _normalize.actualValue; }
@@ -1939,8 +1957,13 @@ public:
   bool latexUseDefault() const { return _latexUseDefaultSymbols.actualValue; }
   LiteralComparisonMode literalComparisonMode() const { return _literalComparisonMode.actualValue; }
   bool forwardSubsumptionResolution() const { return _forwardSubsumptionResolution.actualValue; }
+  bool flatSubsumptionIndex() const { return _flatSubsumptionIndex.actualValue; }
+  FingerprintIndexUse fingerprintIndex() const { return _fingerprintIndex.actualValue; }
+  bool featureVectorSubsumption() const { return _featureVectorSubsumption.actualValue; }
+  bool mlMatcherBitsets() const { return _mlMatcherBitsets.actualValue; }
   //void setForwardSubsumptionResolution(bool newVal) { _forwardSubsumptionResolution = newVal; }
   Demodulation forwardDemodulation() const { return _forwardDemodulation.actualValue; }
+  bool forwardDemodulationCache() const { return _forwardDemodulationCache.actualValue; }
   bool binaryResolution() const { return _binaryResolution.actualValue; }
   bool bfnt() const { return _bfnt.actualValue; }
   void setBfnt(bool newVal) { _bfnt.actualValue = newVal; }
@@ -1966,6 +1989,7 @@ public:
   void setSimulatedTimeLimit(int newVal) { _simulatedTimeLimit.actualValue = newVal; }
   int maxInferenceDepth() const { return _maxInferenceDepth.actualValue; }
   TermOrdering termOrdering() const { return _termOrdering.actualValue; }
+  bool kboCache() const { return _kboCache.actualValue; }
   SymbolPrecedence symbolPrecedence() const { return _symbolPrecedence.actualValue; }
   SymbolPrecedenceBoost symbolPrecedenceBoost() const { return _symbolPrecedenceBoost.actualValue; }
   IntroducedSymbolPrecedence introducedSymbolPrecedence() const { return _introducedSymbolPrecedence.actualValue; }
@@ -2002,6 +2026,8 @@ public:
   void setWeightRatio(int v){ _ageWeightRatio.otherValue = v; }
 	AgeWeightRatioShape ageWeightRatioShape() const { return _ageWeightRatioShape.actualValue; }
 	int ageWeightRatioShapeFrequency() const { return _ageWeightRatioShapeFrequency.actualValue; }
+  bool passiveBucketQueues() const { return _passiveBucketQueues.actualValue; }
+  bool compactPassive() const { return _compactPassive.actualValue; }
   bool literalMaximalityAftercheck() const { return _literalMaximalityAftercheck.actualValue; }
   bool superpositionFromVariables() const { return _superpositionFromVariables.actualValue; }
   EqualityProxy equalityProxy() const { return _equalityProxy.actualValue; }
@@ -2258,6 +2284,8 @@ private:
   RatioOptionValue _ageWeightRatio;
 	ChoiceOptionValue<AgeWeightRatioShape> _ageWeightRatioShape;
 	UnsignedOptionValue _ageWeightRatioShapeFrequency;
+  BoolOptionValue _passiveBucketQueues;
+  BoolOptionValue _compactPassive;
   BoolOptionValue _useTheorySplitQueues;
   StringOptionValue _theorySplitQueueRatios;
   StringOptionValue _theorySplitQueueCutoffs;
@@ -2324,12 +2352,21 @@ private:
   UnsignedOptionValue _fmbDetectSortBoundsTimeLimit;
   UnsignedOptionValue _fmbSizeWeightRatio;
   ChoiceOptionValue<FMBEnumerationStrategy> _fmbEnumerationStrategy;
-
+  BoolOptionValue _fmbIncremental;
+  BoolOptionValue _fmbLazyInstances;
+  UnsignedOptionValue _fmbInstanceMemoryLimit;
+  UnsignedOptionValue _fmbWorkers;
+
+  BoolOptionValue _flatSubsumptionIndex;
+  ChoiceOptionValue<FingerprintIndexUse> _fingerprintIndex;
+  BoolOptionValue _featureVectorSubsumption;
+  BoolOptionValue _mlMatcherBitsets;
   BoolOptionValue _flattenTopLevelConjunctions;
   StringOptionValue _forbiddenOptions;
   BoolOptionValue _forceIncompleteness;
   StringOptionValue _forcedOptions;
   ChoiceOptionValue<Demodulation> _forwardDemodulation;
+  BoolOptionValue _forwardDemodulationCache;
   BoolOptionValue _forwardLiteralRewriting;
   BoolOptionValue _forwardSubsumption;
   BoolOptionValue _forwardSubsumptionResolution;
@@ -2406,6 +2443,10 @@ private:
   ChoiceOptionValue<Mode> _mode;
   ChoiceOptionValue<Schedule> _schedule;
   UnsignedOptionValue _multicore;
+  BoolOptionValue _splitMemoryLimit;
+  BoolOptionValue _lemmaExchange;
+  UnsignedOptionValue _lemmaExchangeWeight;
+  UnsignedOptionValue _lemmaExchangeImports;
 
   StringOptionValue _namePrefix;
   IntOptionValue _naming;
@@ -2510,6 +2551,7 @@ private:
   ChoiceOptionValue<Statistics> _statistics;
   BoolOptionValue _superpositionFromVariables;
   ChoiceOptionValue<TermOrdering> _termOrdering;
+  BoolOptionValue _kboCache;
   ChoiceOptionValue<SymbolPrecedence> _symbolPrecedence;
   ChoiceOptionValue<SymbolPrecedenceBoost> _symbolPrecedenceBoost;
   ChoiceOptionValue<IntroducedSymbolPrecedence> _introducedSymbolPrecedence;
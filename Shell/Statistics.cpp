@@ -96,6 +96,8 @@ Statistics::Statistics()
     backwardSubsumptionResolution(0),
     forwardDemodulations(0),
     forwardDemodulationsToEqTaut(0),
+    forwardDemodulationCacheHits(0),
+    forwardDemodulationCacheMisses(0),
     backwardDemodulations(0),
     backwardDemodulationsToEqTaut(0),
     forwardLiteralRewrites(0),
@@ -110,16 +112,23 @@ Statistics::Statistics()
     equationalTautologies(0),
     forwardSubsumed(0),
     backwardSubsumed(0),
+    forwardSubsumptionSignatureRejections(0),
+    backwardSubsumptionSignatureRejections(0),
     taDistinctnessSimplifications(0),
     taDistinctnessTautologyDeletions(0),
     taInjectivitySimplifications(0),
     taNegativeInjectivitySimplifications(0),
     taAcyclicityGeneratedDisequalities(0),
     generatedClauses(0),
+    maxActivationChildren(0),
+    heavyActivations(0),
     passiveClauses(0),
     activeClauses(0),
     extensionalityClauses(0),
     discardedNonRedundantClauses(0),
+    childrenDiscardedBeforeAllocation(0),
+    exportedLemmas(0),
+    importedLemmas(0),
     inferencesBlockedForOrderingAftercheck(0),
     smtReturnedUnknown(false),
     smtDidNotEvaluate(false),
@@ -264,9 +273,12 @@ void Statistics::print(ostream& out)
 
   HEADING("Saturation",activeClauses+passiveClauses+extensionalityClauses+
       generatedClauses+finalActiveClauses+finalPassiveClauses+finalExtensionalityClauses+
-      discardedNonRedundantClauses+inferencesSkippedDueToColors+inferencesBlockedForOrderingAftercheck);
+      discardedNonRedundantClauses+inferencesSkippedDueToColors+inferencesBlockedForOrderingAftercheck+
+      exportedLemmas+importedLemmas);
   COND_OUT("Initial clauses", initialClauses);
   COND_OUT("Generated clauses", generatedClauses);
+  COND_OUT("Most clauses generated by one activation", maxActivationChildren);
+  COND_OUT("Heavy activations", heavyActivations);
   COND_OUT("Active clauses", activeClauses);
   COND_OUT("Passive clauses", passiveClauses);
   COND_OUT("Extensionality clauses", extensionalityClauses);
@@ -275,8 +287,11 @@ void Statistics::print(ostream& out)
   COND_OUT("Final passive clauses", finalPassiveClauses);
   COND_OUT("Final extensionality clauses", finalExtensionalityClauses);
   COND_OUT("Discarded non-redundant clauses", discardedNonRedundantClauses);
+  COND_OUT("Clause allocations avoided", childrenDiscardedBeforeAllocation);
   COND_OUT("Inferences skipped due to colors", inferencesSkippedDueToColors);
   COND_OUT("Inferences blocked due to ordering aftercheck", inferencesBlockedForOrderingAftercheck);
+  COND_OUT("Exported lemmas", exportedLemmas);
+  COND_OUT("Imported lemmas", importedLemmas);
   SEPARATOR;
 
 
@@ -289,6 +304,8 @@ void Statistics::print(ostream& out)
   COND_OUT("Fw subsumption resolutions", forwardSubsumptionResolution);
   COND_OUT("Bw subsumption resolutions", backwardSubsumptionResolution);
   COND_OUT("Fw demodulations", forwardDemodulations);
+  COND_OUT("Fw demodulation normal form cache hits", forwardDemodulationCacheHits);
+  COND_OUT("Fw demodulation normal form cache misses", forwardDemodulationCacheMisses);
   COND_OUT("Bw demodulations", backwardDemodulations);
   COND_OUT("Fw literal rewrites", forwardLiteralRewrites);
   COND_OUT("Inner rewrites", innerRewrites);
@@ -306,6 +323,8 @@ void Statistics::print(ostream& out)
   COND_OUT("Deep equational tautologies", deepEquationalTautologies);
   COND_OUT("Forward subsumptions", forwardSubsumed);
   COND_OUT("Backward subsumptions", backwardSubsumed);
+  COND_OUT("Fw subsumption signature rejections", forwardSubsumptionSignatureRejections);
+  COND_OUT("Bw subsumption signature rejections", backwardSubsumptionSignatureRejections);
   COND_OUT("Fw demodulations to eq. taut.", forwardDemodulationsToEqTaut);
   COND_OUT("Bw demodulations to eq. taut.", backwardDemodulationsToEqTaut);
   COND_OUT("Inner rewrites to eq. taut.", innerRewritesToEqTaut);
@@ -217,6 +217,10 @@ public:
   unsigned forwardDemodulations;
   /** number of forward demodulations into equational tautologies */
   unsigned forwardDemodulationsToEqTaut;
+  /** number of terms forward demodulation skipped as they were known to be in normal form */
+  unsigned forwardDemodulationCacheHits;
+  /** number of terms forward demodulation looked up in the index with the normal form cache on */
+  unsigned forwardDemodulationCacheMisses;
   /** number of backward demodulations */
   unsigned backwardDemodulations;
   /** number of backward demodulations into equational tautologies */
@@ -247,6 +251,10 @@ public:
   unsigned forwardSubsumed;
   /** number of backward subsumed clauses */
   unsigned backwardSubsumed;
+  /** number of candidates for forward subsumption whose signature did not allow it */
+  unsigned forwardSubsumptionSignatureRejections;
+  /** number of candidates for backward subsumption whose signature did not allow it */
+  unsigned backwardSubsumptionSignatureRejections;
 
   /** statistics of term algebra rules */
   unsigned taDistinctnessSimplifications;
@@ -258,6 +266,10 @@ public:
   // Saturation
   /** all clauses ever occurring in the unprocessed queue */
   unsigned generatedClauses;
+  /** most clauses generated by the activation of a single clause */
+  unsigned maxActivationChildren;
+  /** activations of clauses that generated at least 1000 clauses (see SaturationAlgorithm::activate) */
+  unsigned heavyActivations;
   /** all passive clauses */
   unsigned passiveClauses;
   /** all active clauses */
@@ -266,6 +278,14 @@ public:
   unsigned extensionalityClauses;
 
   unsigned discardedNonRedundantClauses;
+  /** resolvents and superpositions discarded while their literals were
+   *  collected, before a clause was allocated for them */
+  unsigned childrenDiscardedBeforeAllocation;
+
+  /** clauses published to other portfolio slices */
+  unsigned exportedLemmas;
+  /** clauses imported from other portfolio slices */
+  unsigned importedLemmas;
 
   unsigned inferencesBlockedForOrderingAftercheck;
 
@@ -0,0 +1,122 @@
+
+/*
+ * File RandomTerms.cpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions. 
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide. 
+ */
+/**
+ * @file RandomTerms.cpp
+ * Implements class RandomTerms.
+ */
+
+#include "Lib/Environment.hpp"
+#include "Lib/Random.hpp"
+#include "Lib/Stack.hpp"
+
+#include "Kernel/Clause.hpp"
+#include "Kernel/Inference.hpp"
+#include "Kernel/Signature.hpp"
+#include "Kernel/Sorts.hpp"
+
+#include "RandomTerms.hpp"
+
+namespace Test
+{
+
+RandomTerms::RandomTerms()
+{
+  f = env.signature->addFunction("f",2);
+  g = env.signature->addFunction("g",1);
+  h = env.signature->addFunction("h",2);
+  k = env.signature->addFunction("k",3);
+  a = env.signature->addFunction("a",0);
+  b = env.signature->addFunction("b",0);
+  c = env.signature->addFunction("c",0);
+  p = env.signature->addPredicate("p",1);
+  q = env.signature->addPredicate("q",1);
+  r = env.signature->addPredicate("r",2);
+}
+
+/**
+ * Return a random term of depth at most @b depth. The term is one of the
+ * variables X0 to X@b vars-1 with the probability 1/@b varRatio, and it
+ * is ground if @b varRatio is zero.
+ */
+TermList RandomTerms::term(unsigned depth, unsigned varRatio, unsigned vars)
+{
+  CALL("RandomTerms::term");
+
+  if (varRatio && !Random::getInteger(varRatio)) {
+    return TermList(Random::getInteger(vars), false);
+  }
+  switch (Random::getInteger(depth ? 9 : 3)) {
+  case 0:
+    return TermList(Term::createConstant(a));
+  case 1:
+    return TermList(Term::createConstant(b));
+  case 2:
+    return TermList(Term::createConstant(c));
+  case 3:
+  case 4:
+    return TermList(Term::create1(g, term(depth-1, varRatio, vars)));
+  case 5:
+  case 6:
+    return TermList(Term::create2(f, term(depth-1, varRatio, vars), term(depth-1, varRatio, vars)));
+  case 7:
+    return TermList(Term::create2(h, term(depth-1, varRatio, vars), term(depth-1, varRatio, vars)));
+  default: {
+    TermList args[3];
+    for (unsigned i=0; i<3; i++) {
+      args[i] = term(depth-1, varRatio, vars);
+    }
+    return TermList(Term::create(k, 3, args));
+  }
+  }
+}
+
+/**
+ * Return a random literal with arguments of depth at most @b depth,
+ * see term(). If @b equality is true, a quarter of the literals are
+ * equalities.
+ */
+Literal* RandomTerms::literal(unsigned depth, unsigned varRatio, bool equality)
+{
+  CALL("RandomTerms::literal");
+
+  bool polarity = Random::getBit();
+  TermList arg = term(depth, varRatio);
+  if (equality && !Random::getInteger(4)) {
+    return Literal::createEquality(polarity, arg, term(depth, varRatio),
+        (unsigned)Sorts::DefaultSorts::SRT_DEFAULT);
+  }
+  switch (Random::getInteger(3)) {
+  case 0:
+    return Literal::create(p, 1, polarity, false, &arg);
+  case 1:
+    return Literal::create(q, 1, polarity, false, &arg);
+  default:
+    return Literal::create2(r, polarity, arg, term(depth, varRatio));
+  }
+}
+
+/** Return an input clause with the literals @b lits */
+Clause* RandomTerms::clause(Stack<Literal*>& lits)
+{
+  CALL("RandomTerms::clause");
+
+  return Clause::fromStack(lits, NonspecificInference0(UnitInputType::AXIOM,InferenceRule::INPUT));
+}
+
+}
@@ -0,0 +1,57 @@
+
+/*
+ * File RandomTerms.hpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions. 
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide. 
+ */
+/**
+ * @file RandomTerms.hpp
+ * Defines class RandomTerms.
+ */
+
+#ifndef __RandomTerms__
+#define __RandomTerms__
+
+#include "Forwards.hpp"
+
+#include "Kernel/Term.hpp"
+
+namespace Test {
+
+using namespace Lib;
+using namespace Kernel;
+
+/**
+ * Random terms, literals and clauses over a small fixed signature, for
+ * the unit tests and the benchmarks. The constructor adds the symbols to
+ * env.signature. The results depend only on the seed of Lib::Random.
+ */
+class RandomTerms {
+public:
+  RandomTerms();
+
+  TermList term(unsigned depth, unsigned varRatio, unsigned vars=4);
+  Literal* literal(unsigned depth, unsigned varRatio, bool equality=false);
+  static Clause* clause(Stack<Literal*>& lits);
+
+  /** Function symbols f/2, g/1, h/2, k/3 and the constants a, b, c */
+  unsigned f, g, h, k, a, b, c;
+  /** Predicate symbols p/1, q/1 and r/2 */
+  unsigned p, q, r;
+};
+
+}
+
+#endif // __RandomTerms__
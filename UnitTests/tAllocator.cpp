@@ -0,0 +1,132 @@
+
+/*
+ * File tAllocator.cpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions.
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide.
+ */
+/**
+ * @file tAllocator.cpp
+ * Tests of the Allocator with pieces deallocated by other threads.
+ *
+ * Each thread allocates a batch of small pieces, which are then deallocated
+ * by the next thread. Several threads are used only in builds with
+ * THREAD_SAFE_ALLOCATION=1. The throughput is measured in
+ * Benchmarks/bAllocator.cpp.
+ */
+
+#include <pthread.h>
+
+#include "Lib/Allocator.hpp"
+#include "Lib/DArray.hpp"
+
+#include "Test/UnitTesting.hpp"
+
+#define UNIT_ID allocator
+UT_CREATE;
+
+using namespace Lib;
+
+namespace {
+
+/** Number of pieces allocated by a thread in a round */
+const unsigned PIECES = 10000;
+const unsigned ROUNDS = 3;
+
+struct Worker {
+  void** pieces;
+  /** The worker that deallocates the pieces of this one */
+  Worker* next;
+};
+
+/** Size of the @b i-th piece of a batch, between 8 and 256 bytes */
+size_t pieceSize(unsigned i)
+{
+  return 8*(1+(i*2654435761u>>27));
+}
+
+void* allocatePieces(void* arg)
+{
+#if THREAD_SAFE_ALLOCATION
+  Allocator::ThreadInitialiser init;
+#endif
+  Worker* w = static_cast<Worker*>(arg);
+  for (unsigned i=0; i<PIECES; i++) {
+    size_t size = pieceSize(i);
+    void* mem = ALLOC_KNOWN(size,"tAllocator");
+    *static_cast<unsigned*>(mem) = i;
+    w->pieces[i] = mem;
+  }
+  return 0;
+}
+
+void* deallocatePieces(void* arg)
+{
+#if THREAD_SAFE_ALLOCATION
+  Allocator::ThreadInitialiser init;
+#endif
+  Worker* w = static_cast<Worker*>(arg)->next;
+  for (unsigned i=0; i<PIECES; i++) {
+    ASS_EQ(*static_cast<unsigned*>(w->pieces[i]), i);
+    DEALLOC_KNOWN(w->pieces[i],pieceSize(i),"tAllocator");
+  }
+  return 0;
+}
+
+void runThreads(DArray<Worker>& workers, void* (*fn)(void*))
+{
+  unsigned threadCnt = workers.size();
+  DArray<pthread_t> threads(threadCnt);
+  for (unsigned t=0; t<threadCnt; t++) {
+    int err = pthread_create(&threads[t], 0, fn, &workers[t]);
+    ASS_EQ(err,0);
+  }
+  for (unsigned t=0; t<threadCnt; t++) {
+    pthread_join(threads[t], 0);
+  }
+}
+
+/**
+ * Let @b threadCnt threads allocate pieces and deallocate the pieces of
+ * the previous thread, checking that no piece was overwritten
+ */
+void exchangePieces(unsigned threadCnt)
+{
+  DArray<void*> pieces(threadCnt*PIECES);
+  DArray<Worker> workers(threadCnt);
+  for (unsigned t=0; t<threadCnt; t++) {
+    workers[t].pieces = pieces.array()+t*PIECES;
+    workers[t].next = &workers[(t+1)%threadCnt];
+  }
+
+  for (unsigned r=0; r<ROUNDS; r++) {
+    runThreads(workers, allocatePieces);
+    runThreads(workers, deallocatePieces);
+  }
+}
+
+}
+
+TEST_FUN(allocator_cross_thread)
+{
+#if THREAD_SAFE_ALLOCATION
+  const unsigned maxThreads = 4;
+#else
+  const unsigned maxThreads = 1;
+#endif
+
+  for (unsigned threadCnt = 1; threadCnt<=maxThreads; threadCnt *= 2) {
+    exchangePieces(threadCnt);
+  }
+}
@@ -0,0 +1,132 @@
+
+/*
+ * File tClauseBucketQueue.cpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions.
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide.
+ */
+/**
+ * @file tClauseBucketQueue.cpp
+ * Tests of ClauseBucketQueue. It is compared against the skip list of
+ * ClauseQueue in Benchmarks/bClauseBucketQueue.cpp.
+ *
+ * The queue only compares the keys and the addresses of the clauses,
+ * so the clauses are fake pointers whose keys are kept in an array.
+ * The id of a fake clause is its index.
+ */
+
+#include "Lib/DArray.hpp"
+
+#include "Kernel/ClauseBucketQueue.hpp"
+
+#include "Test/UnitTesting.hpp"
+
+#define UNIT_ID clauseBucketQueue
+UT_CREATE;
+
+using namespace Lib;
+using namespace Kernel;
+
+namespace {
+
+/** Keys of the fake clauses */
+DArray<unsigned> keys;
+
+Clause* fakeClause(unsigned i)
+{
+  return reinterpret_cast<Clause*>(static_cast<size_t>(i+1)*8);
+}
+
+unsigned fakeKey(Clause* c)
+{
+  return keys[reinterpret_cast<size_t>(c)/8-1];
+}
+
+/** Initialize @b cnt keys between 0 and 255 */
+void initKeys(unsigned cnt)
+{
+  keys.ensure(cnt);
+  for (unsigned i=0; i<cnt; i++) {
+    keys[i] = (i*2654435761u)>>24;
+  }
+}
+
+class BucketQueue
+: public ClauseBucketQueue
+{
+protected:
+  unsigned key(Clause* c) override
+  { return fakeKey(c); }
+  unsigned id(Clause* c) override
+  { return reinterpret_cast<size_t>(c)/8-1; }
+};
+
+}
+
+TEST_FUN(clauseBucketQueue_order)
+{
+  initKeys(1000);
+  BucketQueue queue;
+
+  for (unsigned i=0; i<1000; i++) {
+    queue.insert(fakeClause(i));
+  }
+  ASS(queue.remove(fakeClause(5)));
+  ASS(!queue.remove(fakeClause(5)));
+  ASS_EQ(queue.size(), 999);
+
+  unsigned iterated = 0;
+  Clause* prev = 0;
+  BucketQueue::Iterator it(queue);
+  while (it.hasNext()) {
+    Clause* c = it.next();
+    ASS_NEQ(c, fakeClause(5));
+    if (prev) {
+      // clauses with the same key come in the order of insertion
+      ASS(fakeKey(prev)<fakeKey(c) || (fakeKey(prev)==fakeKey(c) && prev<c));
+    }
+    prev = c;
+    iterated++;
+  }
+  ASS_EQ(iterated, 999);
+
+  queue.insert(fakeClause(5));
+  ASS_EQ(queue.size(), 1000);
+  queue.removeAll();
+  ASS(queue.isEmpty());
+}
+
+TEST_FUN(clauseBucketQueue_churn)
+{
+  initKeys(1000);
+  BucketQueue queue;
+
+  // the positions of the clauses that left the queue are dropped,
+  // so the same ids can be inserted again many times
+  for (unsigned round=0; round<100; round++) {
+    for (unsigned i=0; i<1000; i++) {
+      queue.insert(fakeClause(i));
+    }
+    for (unsigned i=round%2; i<1000; i+=2) {
+      ALWAYS(queue.remove(fakeClause(i)));
+    }
+    unsigned lastKey = 0;
+    while (!queue.isEmpty()) {
+      Clause* c = queue.pop();
+      ASS_GE(fakeKey(c), lastKey);
+      lastKey = fakeKey(c);
+      ASS(!queue.remove(c));
+    }
+  }
+}
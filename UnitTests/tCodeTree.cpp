@@ -0,0 +1,186 @@
+
+/*
+ * File tCodeTree.cpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions.
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide.
+ */
+/**
+ * @file tCodeTree.cpp
+ * Tests of the retrieval from code trees, see Benchmarks/bCodeTree.cpp
+ * for the timing.
+ *
+ * The generalizations of random terms are retrieved from a term code tree
+ * and from a substitution tree, and they must be the same. Random clauses
+ * are put into a clause code tree together with their instances, and the
+ * clause must be among the subsuming clauses of its instance.
+ */
+
+#include <algorithm>
+
+#include "Lib/DArray.hpp"
+#include "Lib/Random.hpp"
+#include "Lib/Stack.hpp"
+
+#include "Kernel/Clause.hpp"
+#include "Kernel/SubstHelper.hpp"
+#include "Kernel/Substitution.hpp"
+#include "Kernel/Term.hpp"
+
+#include "Indexing/CodeTreeInterfaces.hpp"
+#include "Indexing/TermSubstitutionTree.hpp"
+
+#include "Test/RandomTerms.hpp"
+#include "Test/UnitTesting.hpp"
+
+#define UNIT_ID code_tree
+UT_CREATE;
+
+using namespace std;
+using namespace Lib;
+using namespace Kernel;
+using namespace Indexing;
+using namespace Test;
+
+namespace {
+
+const unsigned TERMS = 3000;
+const unsigned TERM_QUERIES = 3000;
+const unsigned CLAUSES = 2000;
+
+/** Index whose clauses are added by the test rather than by a container */
+class TestSubsumptionIndex
+: public CodeTreeSubsumptionIndex
+{
+public:
+  void add(Clause* cl) { handleClause(cl, true); }
+};
+
+/**
+ * Insert the same @b TERMS random non-variable terms from @b rt into
+ * both indexes and store @b TERM_QUERIES ground queries into @b queries
+ */
+void fillTerms(RandomTerms& rt, TermIndexingStructure& codeTree, TermIndexingStructure& substTree,
+    Stack<TermList>& queries)
+{
+  for (unsigned i=0; i<TERMS; i++) {
+    TermList t;
+    do {
+      t = rt.term(3, 8);
+    } while (t.isVar());
+    Stack<Literal*> lits;
+    lits.push(Literal::create(rt.p, 1, true, false, &t));
+    Clause* cl = RandomTerms::clause(lits);
+    codeTree.insert(t, (*cl)[0], cl);
+    substTree.insert(t, (*cl)[0], cl);
+  }
+
+  while (queries.size()<TERM_QUERIES) {
+    TermList t = rt.term(3, 0);
+    if (t.isTerm()) {
+      queries.push(t);
+    }
+  }
+}
+
+/**
+ * Add @b CLAUSES random clauses from @b rt to @b index and store them
+ * into @b bases, and store an instance of each of them with some extra
+ * literals into @b instances
+ */
+void fillClauses(RandomTerms& rt, TestSubsumptionIndex& index, DArray<Clause*>& bases, DArray<Clause*>& instances)
+{
+  bases.ensure(CLAUSES);
+  instances.ensure(CLAUSES);
+  for (unsigned i=0; i<CLAUSES; i++) {
+    Stack<Literal*> lits;
+    unsigned len = 1+Random::getInteger(3);
+    for (unsigned j=0; j<len; j++) {
+      lits.push(rt.literal(2, 8));
+    }
+    bases[i] = RandomTerms::clause(lits);
+    index.add(bases[i]);
+
+    Substitution subst;
+    for (unsigned var=0; var<4; var++) {
+      subst.bind(var, rt.term(1, 0));
+    }
+    Stack<Literal*> ilits;
+    for (unsigned j=0; j<len; j++) {
+      ilits.push(SubstHelper::apply(lits[j], subst));
+    }
+    unsigned extra = Random::getInteger(3);
+    for (unsigned j=0; j<extra; j++) {
+      ilits.push(rt.literal(2, 0));
+    }
+    instances[i] = RandomTerms::clause(ilits);
+  }
+}
+
+/** Store the sorted numbers of the clauses with generalizations of @b query into @b res */
+void generalizations(TermIndexingStructure& is, TermList query, Stack<unsigned>& res)
+{
+  res.reset();
+  TermQueryResultIterator rit = is.getGeneralizations(query, true);
+  while (rit.hasNext()) {
+    res.push(rit.next().clause->number());
+  }
+  sort(res.begin(), res.end());
+}
+
+}
+
+TEST_FUN(code_tree_term_retrieval)
+{
+  RandomTerms rt;
+  Random::setSeed(1);
+
+  CodeTreeTIS codeTree;
+  TermSubstitutionTree substTree;
+  Stack<TermList> queries;
+  fillTerms(rt, codeTree, substTree, queries);
+
+  Stack<unsigned> ctRes;
+  Stack<unsigned> stRes;
+  for (unsigned i=0; i<queries.size(); i++) {
+    generalizations(codeTree, queries[i], ctRes);
+    generalizations(substTree, queries[i], stRes);
+    ASS_EQ(ctRes.size(), stRes.size());
+    for (unsigned j=0; j<ctRes.size(); j++) {
+      ASS_EQ(ctRes[j], stRes[j]);
+    }
+  }
+}
+
+TEST_FUN(code_tree_subsumption)
+{
+  RandomTerms rt;
+  Random::setSeed(1);
+
+  TestSubsumptionIndex index;
+  DArray<Clause*> bases;
+  DArray<Clause*> instances;
+  fillClauses(rt, index, bases, instances);
+
+  for (unsigned i=0; i<CLAUSES; i++) {
+    bool found = false;
+    ClauseSResResultIterator rit = index.getSubsumingOrSResolvingClauses(instances[i], false);
+    while (rit.hasNext()) {
+      if (rit.next().clause == bases[i]) {
+        found = true;
+      }
+    }
+    ASS(found);
+  }
+}
@@ -0,0 +1,179 @@
+
+/*
+ * File tConcurrentSet.cpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions.
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide.
+ */
+/**
+ * @file tConcurrentSet.cpp
+ * Tests of ConcurrentSet. The insertion throughput is measured in
+ * Benchmarks/bConcurrentSet.cpp.
+ */
+
+#include <pthread.h>
+
+#include "Lib/ConcurrentSet.hpp"
+#include "Lib/DArray.hpp"
+#include "Lib/Hash.hpp"
+
+#include "Test/UnitTesting.hpp"
+
+#define UNIT_ID concurrentSet
+UT_CREATE;
+
+using namespace Lib;
+
+namespace {
+
+/**
+ * Stand-in for a term: a functor with two arguments. The set compares
+ * the nodes by content, so there are as many copies of each node as there
+ * are threads inserting it, and only one copy may end up in the set.
+ */
+struct Node {
+  unsigned functor;
+  unsigned args[2];
+};
+
+/** Hash of nodes, it must not use CALL as it is called from several threads */
+struct NodeHash {
+  static unsigned hash(const Node* n)
+  {
+    unsigned res = HashUtils::combine(2166136261u, n->functor);
+    res = HashUtils::combine(res, n->args[0]);
+    return HashUtils::combine(res, n->args[1]);
+  }
+  static bool equals(const Node* n1, const Node* n2)
+  {
+    return n1->functor==n2->functor && n1->args[0]==n2->args[0] && n1->args[1]==n2->args[1];
+  }
+};
+
+typedef ConcurrentSet<Node*,NodeHash> NodeSet;
+
+void initNode(Node& n, unsigned i)
+{
+  n.functor = i%7;
+  n.args[0] = i;
+  n.args[1] = i*31;
+}
+
+struct Worker {
+  NodeSet* set;
+  /** Nodes inserted by this worker */
+  Node* nodes;
+  /** Representatives returned by the set */
+  Node** results;
+  unsigned cnt;
+  /** The worker inserts the nodes starting from this one */
+  unsigned start;
+};
+
+void* insertNodes(void* arg)
+{
+  Worker* w = static_cast<Worker*>(arg);
+  for (unsigned i=0; i<w->cnt; i++) {
+    unsigned idx = (w->start+i)%w->cnt;
+    w->results[idx] = w->set->insert(&w->nodes[idx]);
+  }
+  return 0;
+}
+
+/**
+ * Let @b threadCnt threads insert their own copies of @b cnt distinct
+ * nodes into a set and check that they all got the same representatives.
+ */
+void insertInParallel(unsigned threadCnt, unsigned cnt)
+{
+  NodeSet set;
+  DArray<Node> nodes(threadCnt*cnt);
+  DArray<Node*> results(threadCnt*cnt);
+  DArray<Worker> workers(threadCnt);
+  DArray<pthread_t> threads(threadCnt);
+
+  for (unsigned t=0; t<threadCnt; t++) {
+    for (unsigned i=0; i<cnt; i++) {
+      initNode(nodes[t*cnt+i], i);
+    }
+    workers[t].set = &set;
+    workers[t].nodes = nodes.array()+t*cnt;
+    workers[t].results = results.array()+t*cnt;
+    workers[t].cnt = cnt;
+    workers[t].start = t*(cnt/threadCnt);
+  }
+
+  for (unsigned t=0; t<threadCnt; t++) {
+    int err = pthread_create(&threads[t], 0, insertNodes, &workers[t]);
+    ASS_EQ(err,0);
+  }
+  for (unsigned t=0; t<threadCnt; t++) {
+    pthread_join(threads[t], 0);
+  }
+
+  ASS_EQ(set.size(), cnt);
+  for (unsigned i=0; i<cnt; i++) {
+    Node* rep = results[i];
+    ASS(NodeHash::equals(rep, &nodes[i]));
+    for (unsigned t=1; t<threadCnt; t++) {
+      ASS_EQ(results[t*cnt+i], rep);
+    }
+    Node* found;
+    ALWAYS(set.find(&nodes[i], found));
+    ASS_EQ(found, rep);
+  }
+}
+
+}
+
+TEST_FUN(concurrentSet_sequential)
+{
+  const unsigned cnt = 100000;
+  NodeSet set(16);
+  DArray<Node> nodes(cnt);
+  DArray<Node> copies(cnt);
+
+  for (unsigned i=0; i<cnt; i++) {
+    initNode(nodes[i], i);
+    initNode(copies[i], i);
+    ASS_EQ(set.insert(&nodes[i]), &nodes[i]);
+  }
+  ASS_EQ(set.size(), cnt);
+
+  for (unsigned i=0; i<cnt; i++) {
+    ASS_EQ(set.insert(&copies[i]), &nodes[i]);
+  }
+  ASS_EQ(set.size(), cnt);
+
+  Node missing;
+  initNode(missing, cnt);
+  Node* found;
+  ASS(!set.find(&missing, found));
+
+  unsigned iterated = 0;
+  NodeSet::Iterator it(set);
+  while (it.hasNext()) {
+    Node* n = it.next();
+    ASS_EQ(n, &nodes[n->args[0]]);
+    iterated++;
+  }
+  ASS_EQ(iterated, cnt);
+}
+
+TEST_FUN(concurrentSet_threads)
+{
+  for (unsigned threadCnt = 1; threadCnt<=8; threadCnt *= 2) {
+    insertInParallel(threadCnt, 20000);
+  }
+}
@@ -0,0 +1,121 @@
+
+/*
+ * File tFeatureVectorIndex.cpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions.
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide.
+ */
+/**
+ * @file tFeatureVectorIndex.cpp
+ * Tests of FeatureVectorIndex.
+ *
+ * Random clauses are put into the index together with clauses they
+ * subsume, each subsumed clause must be among the candidates of the
+ * clause that subsumes it, and the index must leave out most of the
+ * other clauses.
+ */
+
+#include "Lib/DArray.hpp"
+#include "Lib/Random.hpp"
+#include "Lib/Stack.hpp"
+
+#include "Kernel/Clause.hpp"
+#include "Kernel/SubstHelper.hpp"
+#include "Kernel/Substitution.hpp"
+#include "Kernel/Term.hpp"
+
+#include "Indexing/FeatureVectorIndex.hpp"
+
+#include "Test/RandomTerms.hpp"
+#include "Test/UnitTesting.hpp"
+
+#define UNIT_ID feature_vector_index
+UT_CREATE;
+
+using namespace std;
+using namespace Lib;
+using namespace Kernel;
+using namespace Indexing;
+using namespace Test;
+
+namespace {
+
+const unsigned CLAUSES = 2000;
+
+/** Index whose clauses are added by the test rather than by a container */
+class TestIndex
+: public FeatureVectorIndex
+{
+public:
+  void add(Clause* cl) { handleClause(cl, true); }
+  void remove(Clause* cl) { handleClause(cl, false); }
+};
+
+}
+
+TEST_FUN(feature_vector_candidates)
+{
+  RandomTerms rt;
+  Random::setSeed(1);
+
+  TestIndex index;
+  DArray<Clause*> bases(CLAUSES);
+  DArray<Clause*> instances(CLAUSES);
+  for (unsigned i=0; i<CLAUSES; i++) {
+    Stack<Literal*> lits;
+    unsigned len = 2+Random::getInteger(2);
+    for (unsigned j=0; j<len; j++) {
+      lits.push(rt.literal(2, 3));
+    }
+    bases[i] = RandomTerms::clause(lits);
+
+    Substitution subst;
+    for (unsigned var=0; var<4; var++) {
+      subst.bind(var, rt.term(1, 3));
+    }
+    Stack<Literal*> ilits;
+    for (unsigned j=0; j<len; j++) {
+      ilits.push(SubstHelper::apply(lits[j], subst));
+    }
+    unsigned extra = Random::getInteger(3);
+    for (unsigned j=0; j<extra; j++) {
+      ilits.push(rt.literal(2, 3));
+    }
+    instances[i] = RandomTerms::clause(ilits);
+
+    index.add(bases[i]);
+    index.add(instances[i]);
+  }
+
+  size_t candidates = 0;
+  for (unsigned i=0; i<CLAUSES; i++) {
+    bool found = false;
+    ClauseIterator cit = index.getSubsumptionCandidates(bases[i]);
+    while (cit.hasNext()) {
+      if (cit.next() == instances[i]) {
+        found = true;
+      }
+      candidates++;
+    }
+    ASS(found);
+  }
+  ASS_L(candidates/CLAUSES, CLAUSES/4);
+
+  for (unsigned i=0; i<CLAUSES; i++) {
+    index.remove(bases[i]);
+    index.remove(instances[i]);
+  }
+  ClauseIterator cit = index.getSubsumptionCandidates(bases[0]);
+  ASS(!cit.hasNext());
+}
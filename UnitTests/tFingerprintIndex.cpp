@@ -0,0 +1,186 @@
+
+/*
+ * File tFingerprintIndex.cpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions.
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide.
+ */
+/**
+ * @file tFingerprintIndex.cpp
+ * Tests of FingerprintIndex against TermSubstitutionTree, see
+ * Benchmarks/bFingerprintIndex.cpp for the timing.
+ *
+ * Both indexes get the same random terms and the same random queries,
+ * they must give the same results, though not in the same order. The
+ * substitutions of the results of the fingerprint index are checked
+ * by applying them.
+ */
+
+#include <algorithm>
+
+#include "Lib/DArray.hpp"
+#include "Lib/Random.hpp"
+#include "Lib/Stack.hpp"
+
+#include "Kernel/Clause.hpp"
+#include "Kernel/Term.hpp"
+
+#include "Indexing/FingerprintIndex.hpp"
+#include "Indexing/ResultSubstitution.hpp"
+#include "Indexing/TermSubstitutionTree.hpp"
+
+#include "Test/RandomTerms.hpp"
+#include "Test/UnitTesting.hpp"
+
+#define UNIT_ID fingerprint_index
+UT_CREATE;
+
+using namespace std;
+using namespace Lib;
+using namespace Kernel;
+using namespace Indexing;
+using namespace Test;
+
+namespace {
+
+const unsigned TERMS = 3000;
+const unsigned QUERIES = 500;
+
+enum Retrieval {
+  UNIFICATIONS,
+  GENERALIZATIONS,
+  INSTANCES
+};
+
+/**
+ * Insert the same @b TERMS random non-variable terms from @b rt into
+ * both indexes and store them and their clauses into @b terms and
+ * @b clauses
+ */
+void fill(RandomTerms& rt, TermIndexingStructure& tree, TermIndexingStructure& fp,
+    DArray<TermList>& terms, DArray<Clause*>& clauses)
+{
+  terms.ensure(TERMS);
+  clauses.ensure(TERMS);
+  for (unsigned i=0; i<TERMS; i++) {
+    TermList t;
+    do {
+      t = rt.term(4, 10);
+    } while (t.isVar());
+    Stack<Literal*> lits;
+    lits.push(Literal::create(rt.p, 1, true, false, &t));
+    Clause* cl = RandomTerms::clause(lits);
+    clauses[i] = cl;
+    terms[i] = t;
+    tree.insert(t, (*cl)[0], cl);
+    fp.insert(t, (*cl)[0], cl);
+  }
+}
+
+/** Remove every third of the @b terms from both indexes */
+void removeSome(TermIndexingStructure& tree, TermIndexingStructure& fp,
+    DArray<TermList>& terms, DArray<Clause*>& clauses)
+{
+  for (unsigned i=0; i<TERMS; i+=3) {
+    tree.remove(terms[i], (*clauses[i])[0], clauses[i]);
+    fp.remove(terms[i], (*clauses[i])[0], clauses[i]);
+  }
+}
+
+TermQueryResultIterator retrieve(TermIndexingStructure& is, TermList query, Retrieval kind, bool subst)
+{
+  switch (kind) {
+  case UNIFICATIONS:
+    return is.getUnifications(query, subst);
+  case GENERALIZATIONS:
+    return is.getGeneralizations(query, subst);
+  default:
+    return is.getInstances(query, subst);
+  }
+}
+
+/** Check that the substitution of @b qr makes the query and the result equal */
+void checkSubstitution(TermList query, TermQueryResult& qr, Retrieval kind)
+{
+  switch (kind) {
+  case UNIFICATIONS:
+    ASS_EQ(qr.substitution->applyToQuery(query), qr.substitution->applyToResult(qr.term));
+    break;
+  case GENERALIZATIONS:
+    ASS(qr.substitution->isIdentityOnQueryWhenResultBound());
+    ASS_EQ(qr.substitution->applyToBoundResult(qr.term), query);
+    break;
+  default:
+    ASS(qr.substitution->isIdentityOnResultWhenQueryBound());
+    ASS_EQ(qr.substitution->applyToBoundQuery(query), qr.term);
+    break;
+  }
+}
+
+/** Store the sorted numbers of the clauses retrieved for @b query into @b res */
+void results(TermIndexingStructure& is, TermList query, Retrieval kind, bool checkSubst, Stack<unsigned>& res)
+{
+  res.reset();
+  TermQueryResultIterator rit = retrieve(is, query, kind, checkSubst);
+  while (rit.hasNext()) {
+    TermQueryResult qr = rit.next();
+    if (checkSubst) {
+      checkSubstitution(query, qr, kind);
+    }
+    res.push(qr.clause->number());
+  }
+  sort(res.begin(), res.end());
+}
+
+void compare(TermIndexingStructure& tree, TermIndexingStructure& fp, Stack<TermList>& queries, Retrieval kind)
+{
+  Stack<unsigned> treeRes;
+  Stack<unsigned> fpRes;
+  for (unsigned i=0; i<queries.size(); i++) {
+    results(tree, queries[i], kind, false, treeRes);
+    results(fp, queries[i], kind, true, fpRes);
+    ASS_EQ(treeRes.size(), fpRes.size());
+    for (unsigned j=0; j<treeRes.size(); j++) {
+      ASS_EQ(treeRes[j], fpRes[j]);
+    }
+  }
+}
+
+}
+
+TEST_FUN(fingerprint_retrieval)
+{
+  RandomTerms rt;
+  Random::setSeed(1);
+
+  TermSubstitutionTree tree;
+  FingerprintIndex fp;
+  DArray<TermList> terms;
+  DArray<Clause*> clauses;
+  fill(rt, tree, fp, terms, clauses);
+
+  Stack<TermList> queries;
+  for (unsigned i=0; i<QUERIES; i++) {
+    queries.push(rt.term(3, 10));
+  }
+
+  compare(tree, fp, queries, UNIFICATIONS);
+  compare(tree, fp, queries, GENERALIZATIONS);
+  compare(tree, fp, queries, INSTANCES);
+
+  removeSome(tree, fp, terms, clauses);
+  compare(tree, fp, queries, UNIFICATIONS);
+  compare(tree, fp, queries, GENERALIZATIONS);
+  compare(tree, fp, queries, INSTANCES);
+}
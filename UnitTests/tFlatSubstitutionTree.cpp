@@ -0,0 +1,120 @@
+
+/*
+ * File tFlatSubstitutionTree.cpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions.
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide.
+ */
+/**
+ * @file tFlatSubstitutionTree.cpp
+ * Tests of the retrieval of generalizations from LiteralSubstitutionTree
+ * with the FlatTree copies of the roots, see
+ * Benchmarks/bFlatSubstitutionTree.cpp for the timing.
+ *
+ * Both trees get the same random literals and the same random queries,
+ * they must give the same results in the same order. After some literals
+ * are removed, the queries are asked again to check that the copies are
+ * made again.
+ */
+
+#include "Lib/DArray.hpp"
+#include "Lib/Random.hpp"
+#include "Lib/Stack.hpp"
+
+#include "Kernel/Clause.hpp"
+#include "Kernel/Term.hpp"
+
+#include "Indexing/LiteralSubstitutionTree.hpp"
+
+#include "Test/RandomTerms.hpp"
+#include "Test/UnitTesting.hpp"
+
+#define UNIT_ID flat_subst_tree
+UT_CREATE;
+
+using namespace std;
+using namespace Lib;
+using namespace Kernel;
+using namespace Indexing;
+using namespace Test;
+
+namespace {
+
+const unsigned LITERALS = 5000;
+const unsigned QUERIES = 10000;
+
+/**
+ * Insert the same @b LITERALS random unit clauses from @b rt into both
+ * trees and store them into @b clauses
+ */
+void fill(RandomTerms& rt, LiteralSubstitutionTree& plain, LiteralSubstitutionTree& flat, DArray<Clause*>& clauses)
+{
+  clauses.ensure(LITERALS);
+  for (unsigned i=0; i<LITERALS; i++) {
+    Stack<Literal*> lits;
+    lits.push(rt.literal(3, 8, true));
+    Clause* cl = RandomTerms::clause(lits);
+    clauses[i] = cl;
+    plain.insert((*cl)[0], cl);
+    flat.insert((*cl)[0], cl);
+  }
+}
+
+/** Remove every third of the @b clauses from both trees */
+void removeSome(LiteralSubstitutionTree& plain, LiteralSubstitutionTree& flat, DArray<Clause*>& clauses)
+{
+  for (unsigned i=0; i<LITERALS; i+=3) {
+    plain.remove((*clauses[i])[0], clauses[i]);
+    flat.remove((*clauses[i])[0], clauses[i]);
+  }
+}
+
+/** Ask the queries to both trees and check that the results are the same */
+void compare(LiteralSubstitutionTree& plain, LiteralSubstitutionTree& flat, Stack<Literal*>& queries)
+{
+  for (unsigned i=0; i<queries.size(); i++) {
+    SLQueryResultIterator pit = plain.getGeneralizations(queries[i], false, false);
+    SLQueryResultIterator fit = flat.getGeneralizations(queries[i], false, false);
+    while (pit.hasNext()) {
+      ASS(fit.hasNext());
+      SLQueryResult pr = pit.next();
+      SLQueryResult fr = fit.next();
+      ASS_EQ(pr.clause, fr.clause);
+      ASS_EQ(pr.literal, fr.literal);
+    }
+    ASS(!fit.hasNext());
+  }
+}
+
+}
+
+TEST_FUN(flat_generalizations)
+{
+  RandomTerms rt;
+  Random::setSeed(1);
+
+  LiteralSubstitutionTree plain;
+  LiteralSubstitutionTree flat(false, true);
+  DArray<Clause*> clauses;
+  fill(rt, plain, flat, clauses);
+
+  Stack<Literal*> queries;
+  for (unsigned i=0; i<QUERIES; i++) {
+    queries.push(rt.literal(4, 20, true));
+  }
+  compare(plain, flat, queries);
+
+  removeSome(plain, flat, clauses);
+  compare(plain, flat, queries);
+}
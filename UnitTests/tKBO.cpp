@@ -0,0 +1,225 @@
+
+/*
+ * File tKBO.cpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions.
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide.
+ */
+/**
+ * @file tKBO.cpp
+ * Tests of KBO with the option kbo_cache, see Benchmarks/bKBO.cpp for
+ * the timing of the cache.
+ *
+ * A stream of comparisons of random shared terms, most of which repeat
+ * pairs that were compared before, must give the same results with and
+ * without the cache.
+ *
+ * The checks compiled for incomparable pairs of terms must agree with
+ * comparing random instances of the pairs, also for the instances that
+ * backward demodulation retrieves from a substitution tree.
+ */
+
+#include "Lib/DArray.hpp"
+#include "Lib/Random.hpp"
+#include "Lib/Stack.hpp"
+
+#include "Kernel/Clause.hpp"
+#include "Kernel/EqHelper.hpp"
+#include "Kernel/KBO.hpp"
+#include "Kernel/Problem.hpp"
+#include "Kernel/Sorts.hpp"
+#include "Kernel/SubstHelper.hpp"
+#include "Kernel/Substitution.hpp"
+#include "Kernel/Term.hpp"
+
+#include "Indexing/ResultSubstitution.hpp"
+#include "Indexing/TermSubstitutionTree.hpp"
+
+#include "Shell/Options.hpp"
+
+#include "Test/RandomTerms.hpp"
+#include "Test/UnitTesting.hpp"
+
+#define UNIT_ID kbo
+UT_CREATE;
+
+using namespace std;
+using namespace Lib;
+using namespace Kernel;
+using namespace Indexing;
+using namespace Shell;
+using namespace Test;
+
+namespace {
+
+/** Number of distinct terms in the stream */
+const unsigned TERMS = 2000;
+/** Number of pairs that are compared repeatedly */
+const unsigned HOT_PAIRS = 500;
+const unsigned COMPARISONS = 100000;
+
+/** Record a stream of @b COMPARISONS pairs of terms into @b lhs and @b rhs */
+void recordStream(Stack<TermList>& lhs, Stack<TermList>& rhs)
+{
+  RandomTerms rt;
+
+  Random::setSeed(1);
+  DArray<TermList> terms(TERMS);
+  for (unsigned i=0; i<TERMS; i++) {
+    terms[i] = rt.term(6, 8);
+  }
+  DArray<unsigned> hot(2*HOT_PAIRS);
+  for (unsigned i=0; i<2*HOT_PAIRS; i++) {
+    hot[i] = Random::getInteger(TERMS);
+  }
+
+  for (unsigned i=0; i<COMPARISONS; i++) {
+    if (Random::getInteger(10)) {
+      unsigned p = Random::getInteger(HOT_PAIRS);
+      lhs.push(terms[hot[2*p]]);
+      rhs.push(terms[hot[2*p+1]]);
+    }
+    else {
+      lhs.push(terms[Random::getInteger(TERMS)]);
+      rhs.push(terms[Random::getInteger(TERMS)]);
+    }
+  }
+}
+
+}
+
+TEST_FUN(kbo_cache)
+{
+  Stack<TermList> lhs;
+  Stack<TermList> rhs;
+  recordStream(lhs, rhs);
+
+  Problem prb;
+  Options plainOpt;
+  KBO plain(prb, plainOpt);
+  Options cachedOpt;
+  cachedOpt.set("kbo_cache","on");
+  KBO cached(prb, cachedOpt);
+
+  for (unsigned i=0; i<lhs.size(); i++) {
+    ASS_EQ(plain.compare(lhs[i], rhs[i]), cached.compare(lhs[i], rhs[i]));
+  }
+}
+
+TEST_FUN(kbo_instance_check)
+{
+  RandomTerms rt;
+  Problem prb;
+  Options opt;
+  opt.set("kbo_cache","on");
+  KBO ord(prb, opt);
+
+  Random::setSeed(2);
+  unsigned pairs = 0;
+  while (pairs < 2000) {
+    TermList l = rt.term(3, 8);
+    TermList r = rt.term(3, 8);
+    if (ord.compare(l, r) != Ordering::Result::INCOMPARABLE) {
+      continue;
+    }
+    InstanceOrderingCheck* check = ord.compileInstanceCheck(l, r);
+    if (!check) {
+      continue;
+    }
+    pairs++;
+
+    for (unsigned i=0; i<20; i++) {
+      Substitution subst;
+      for (unsigned var=0; var<4; var++) {
+        subst.bind(var, rt.term(2, 8));
+      }
+      TermList lS = SubstHelper::apply(l, subst);
+      TermList rS = SubstHelper::apply(r, subst);
+      bool greater = check->isGreater(lS, rS);
+      ASS_EQ(greater, ord.compare(lS, rS) == Ordering::Result::GREATER);
+    }
+    delete check;
+  }
+}
+
+/**
+ * Replay the checks of backward demodulation: for a unit equation with
+ * incomparable sides, the checks are compiled for both orientations and
+ * evaluated on the instances of its left-hand sides found in the subterm
+ * index.
+ */
+TEST_FUN(kbo_instance_check_backward_demodulation)
+{
+  RandomTerms rt;
+  Problem prb;
+  Options opt;
+  opt.set("kbo_cache","on");
+  KBO ord(prb, opt);
+
+  Random::setSeed(3);
+  TermSubstitutionTree tree;
+  for (unsigned i=0; i<2000; i++) {
+    TermList t;
+    do {
+      t = rt.term(4, 8);
+    } while (t.isVar());
+    Stack<Literal*> lits;
+    lits.push(Literal::create(rt.p, 1, true, false, &t));
+    Clause* cl = RandomTerms::clause(lits);
+    tree.insert(t, (*cl)[0], cl);
+  }
+
+  unsigned lhsCnt = 0;
+  unsigned checked = 0;
+  while (lhsCnt < 500) {
+    TermList t0 = rt.term(2, 8);
+    TermList t1 = rt.term(2, 8);
+    if (t0 == t1) {
+      continue;
+    }
+    Literal* eqLit = Literal::createEquality(true, t0, t1, (unsigned)Sorts::DefaultSorts::SRT_DEFAULT);
+    if (ord.getEqualityArgumentOrder(eqLit) != Ordering::Result::INCOMPARABLE) {
+      continue;
+    }
+    InstanceOrderingCheck* checks[2];
+    checks[0] = ord.compileInstanceCheck(t0, t1);
+    checks[1] = ord.compileInstanceCheck(t1, t0);
+
+    TermIterator lhsIt = EqHelper::getDemodulationLHSIterator(eqLit, false, ord, opt);
+    while (lhsIt.hasNext()) {
+      TermList lhs = lhsIt.next();
+      TermList rhs = EqHelper::getOtherEqualitySide(eqLit, lhs);
+      if (lhs.isVar()) {
+        continue;
+      }
+      InstanceOrderingCheck* check = checks[lhs==t0 ? 0 : 1];
+      lhsCnt++;
+
+      TermQueryResultIterator rit = tree.getInstances(lhs, true);
+      while (rit.hasNext()) {
+        TermQueryResult qr = rit.next();
+        ASS(qr.substitution->isIdentityOnResultWhenQueryBound());
+        TermList lhsS = qr.term;
+        TermList rhsS = qr.substitution->applyToBoundQuery(rhs);
+        bool greater = check ? check->isGreater(lhsS, rhsS)
+            : ord.compare(lhsS, rhsS) == Ordering::Result::GREATER;
+        ASS_EQ(greater, ord.compare(lhsS, rhsS) == Ordering::Result::GREATER);
+        checked++;
+      }
+    }
+    delete checks[0];
+    delete checks[1];
+  }
+  ASS_G(checked, 0);
+}
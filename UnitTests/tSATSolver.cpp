@@ -18,6 +18,7 @@
  */
 
 #include "Lib/List.hpp"
+#include "Lib/Random.hpp"
 #include "Lib/Stack.hpp"
 #include "Lib/Environment.hpp"
 
@@ -27,6 +28,8 @@
 #include "SAT/SATSolver.hpp"
 #include "SAT/TWLSolver.hpp"
 #include "SAT/MinisatInterfacing.hpp"
+#include "SAT/CDCLSolver.hpp"
+#include "SAT/LingelingInterfacing.hpp"
 #include "SAT/Z3Interfacing.hpp"
 
 #include "Test/UnitTesting.hpp"
@@ -244,6 +247,14 @@ TEST_FUN(testSATSolverInterface)
   TWLSolver sTWL(*env.options,true);
   testInterface(sTWL);  
 
+  cout << endl << "CDCL" << endl;
+  CDCLSolver sCDCL(*env.options,true);
+  testInterface(sCDCL);
+
+  cout << endl << "Lingeling" << endl;
+  LingelingInterfacing sLingeling(*env.options,true);
+  testInterface(sLingeling);
+
   /* Not fully conforming - does not support zeroImplied and resource-limited solving
   cout << endl << "Z3" << endl;
   {
@@ -308,6 +319,14 @@ TEST_FUN(testSolvingUnderAssumptions)
   TWLSolver sTWL(*env.options,true);
   testAssumptions(sTWL);
 
+  cout << endl << "CDCL" << endl;
+  CDCLSolver sCDCL(*env.options,true);
+  testAssumptions(sCDCL);
+
+  cout << endl << "Lingeling" << endl;
+  LingelingInterfacing sLingeling(*env.options,true);
+  testAssumptions(sLingeling);
+
   /*cout << endl << "Z3" << endl;
   {
     SAT2FO sat2fo;
@@ -315,3 +334,63 @@ TEST_FUN(testSolvingUnderAssumptions)
     testAssumptions(sZ3);
   }*/
 }
+
+/**
+ * Compare @b s against minisat on random 3-SAT problems around the phase
+ * transition, solved incrementally and under random assumptions.
+ */
+void testAgainstMinisat(SATSolverWithAssumptions& s, unsigned varCnt, unsigned rounds)
+{
+  CALL("testAgainstMinisat");
+
+  MinisatInterfacing minisat(*env.options,true);
+  SATSolverWithAssumptions& ref = minisat;
+  s.ensureVarCount(varCnt);
+  ref.ensureVarCount(varCnt);
+
+  for (unsigned r = 0; r < rounds; r++) {
+    for (unsigned i = 0; i < varCnt; i++) {
+      SATLiteralStack lits;
+      while (lits.size() < 3) {
+        SATLiteral lit(Random::getInteger(varCnt)+1, Random::getBit());
+        if (!lits.find(lit) && !lits.find(lit.opposite())) {
+          lits.push(lit);
+        }
+      }
+      SATClause* cl = SATClause::fromStack(lits);
+      s.addClause(cl);
+      ref.addClause(cl);
+    }
+
+    SATLiteralStack assumps;
+    for (unsigned i = 0; i < 5; i++) {
+      assumps.push(SATLiteral(Random::getInteger(varCnt)+1, Random::getBit()));
+    }
+    SATSolver::Status res = s.solveUnderAssumptions(assumps);
+    ASS_EQ(res, ref.solveUnderAssumptions(assumps));
+    if (res == SATSolver::Status::UNSATISFIABLE) {
+      // the failed assumptions must be enough for the reference solver
+      SATLiteralStack failed;
+      failed.loadFromIterator(SATLiteralStack::ConstIterator(s.failedAssumptions()));
+      ASS_EQ(ref.solveUnderAssumptions(failed), SATSolver::Status::UNSATISFIABLE);
+    }
+
+    res = s.solve();
+    ASS_EQ(res, ref.solve());
+    if (res == SATSolver::Status::UNSATISFIABLE) {
+      return;
+    }
+  }
+}
+
+TEST_FUN(testCDCLAgainstMinisat)
+{
+  CDCLSolver s(*env.options,true);
+  testAgainstMinisat(s, 150, 10);
+}
+
+TEST_FUN(testLingelingAgainstMinisat)
+{
+  LingelingInterfacing s(*env.options,true);
+  testAgainstMinisat(s, 150, 10);
+}
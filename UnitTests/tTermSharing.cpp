@@ -0,0 +1,164 @@
+/*
+ * File tTermSharing.cpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions.
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide.
+ */
+/**
+ * @file tTermSharing.cpp
+ * Tests of the insertion of terms into TermSharing.
+ *
+ * Each thread creates the same terms through Term::create, so every term
+ * is inserted by all the threads and all of them must get the same shared
+ * term. Several threads are used only in builds with
+ * CONCURRENT_TERM_SHARING=1, which are release builds, e.g.
+ * make vtest XFLAGS="-O3 -DVDEBUG=0 -DCONCURRENT_TERM_SHARING=1 -DTHREAD_SAFE_ALLOCATION=1"
+ *
+ * The throughput is measured in Benchmarks/bTermSharing.cpp.
+ */
+
+#include <cstdlib>
+#include <iostream>
+#include <pthread.h>
+
+#include "Lib/Allocator.hpp"
+#include "Lib/DArray.hpp"
+#include "Lib/Environment.hpp"
+#include "Lib/Int.hpp"
+
+#include "Kernel/Signature.hpp"
+#include "Kernel/Term.hpp"
+
+#include "Indexing/TermSharing.hpp"
+
+#include "Test/UnitTesting.hpp"
+
+#define UNIT_ID termSharing
+UT_CREATE;
+
+using namespace std;
+using namespace Lib;
+using namespace Kernel;
+
+namespace {
+
+/** Number of terms created by each thread */
+const unsigned TERMS = 20000;
+/** Number of distinct constants the terms are built from */
+const unsigned LEAVES = 16;
+
+struct Symbols {
+  unsigned f, g, h;
+};
+
+struct Worker {
+  Symbols s;
+  /** The constants at the leaves */
+  TermList* leaves;
+  /** The terms created by this worker */
+  Term** terms;
+};
+
+/**
+ * Create the terms 0 to TERMS-1, the term i has arguments chosen
+ * among the previous terms and the leaves
+ */
+void* createTerms(void* arg)
+{
+#if THREAD_SAFE_ALLOCATION
+  Allocator::ThreadInitialiser init;
+#endif
+  Worker* w = static_cast<Worker*>(arg);
+  for (unsigned i=0; i<TERMS; i++) {
+    unsigned hash = i*2654435761u;
+    TermList a = i<LEAVES ? w->leaves[i] : TermList(w->terms[hash%i]);
+    TermList b = i<LEAVES ? w->leaves[(i+1)%LEAVES] : TermList(w->terms[(hash>>16)%i]);
+    switch (hash%3) {
+    case 0:
+      w->terms[i] = Term::create2(w->s.f, a, b);
+      break;
+    case 1:
+      w->terms[i] = Term::create2(w->s.g, a, b);
+      break;
+    default:
+      w->terms[i] = Term::create1(w->s.h, a);
+      break;
+    }
+  }
+  return 0;
+}
+
+/**
+ * Let @b threadCnt threads create the same terms over the constants
+ * named after @b round and check that they all got the same shared terms
+ */
+void createInParallel(const Symbols& s, unsigned threadCnt, unsigned round)
+{
+  TermList leaves[LEAVES];
+  for (unsigned i=0; i<LEAVES; i++) {
+    leaves[i] = TermList(Term::createConstant("c"+Int::toString(round)+"_"+Int::toString(i)));
+  }
+  DArray<Term*> terms(threadCnt*TERMS);
+  DArray<Worker> workers(threadCnt);
+  DArray<pthread_t> threads(threadCnt);
+  for (unsigned t=0; t<threadCnt; t++) {
+    workers[t].s = s;
+    workers[t].leaves = leaves;
+    workers[t].terms = terms.array()+t*TERMS;
+  }
+
+  for (unsigned t=0; t<threadCnt; t++) {
+    int err = pthread_create(&threads[t], 0, createTerms, &workers[t]);
+    ASS_EQ(err,0);
+  }
+  for (unsigned t=0; t<threadCnt; t++) {
+    pthread_join(threads[t], 0);
+  }
+
+  // checked also in release builds, which are the ones running several threads
+  for (unsigned i=0; i<TERMS; i++) {
+    Term* t = terms[i];
+    for (unsigned w=0; w<threadCnt; w++) {
+      if (!terms[w*TERMS+i]->shared() || terms[w*TERMS+i]!=t) {
+        cout << "thread " << w << " got a different term number " << i << endl;
+        exit(1);
+      }
+    }
+  }
+}
+
+}
+
+TEST_FUN(termSharing_threads)
+{
+#if CONCURRENT_TERM_SHARING
+  const unsigned threadCnt = 4;
+#else
+  const unsigned threadCnt = 1;
+#endif
+
+  Symbols s;
+  s.f = env.signature->addFunction("f",2);
+  s.g = env.signature->addFunction("g",2);
+  s.h = env.signature->addFunction("h",1);
+  // the default types are created on first use, which must not happen
+  // in several threads at once
+  env.signature->getFunction(s.f)->fnType();
+  env.signature->getFunction(s.g)->fnType();
+  env.signature->getFunction(s.h)->fnType();
+
+  createInParallel(s, threadCnt, 0);
+  // the terms of the same round are found in the sharing
+  createInParallel(s, threadCnt, 0);
+}
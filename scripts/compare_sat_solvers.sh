@@ -0,0 +1,67 @@
+#!/bin/bash
+
+# Compare the SAT solver backends (--sat_solver) of vampire on a set of problems
+#
+# usage:
+# ./compare_sat_solvers.sh <vampire_exec> <time_limit> <vampire_arguments> <solvers> <problem files ...>
+# vampire_arguments and solvers must be passed as one argument each (put into quotation marks)
+#
+# examples:
+# ./compare_sat_solvers.sh ./vampire 60 "--mode sat_solver" "minisat cdcl lingeling" *.cnf
+# ./compare_sat_solvers.sh ./vampire 60 "-sa fmb" "minisat cdcl lingeling" *.p
+#
+# For every problem, prints the SZS status (or the result of --mode sat_solver) and the wall clock time of each solver,
+# marking problems on which two solvers report contradicting statuses. The summary
+# gives the number of problems solved by each solver and the total time.
+
+EXEC_FILE=$1
+TIME_LIMIT=$2
+EXEC_ARGS="$3"
+SOLVERS="$4"
+shift 4
+
+declare -A SOLVED
+declare -A TOTAL
+for S in $SOLVERS; do
+        SOLVED[$S]=0
+        TOTAL[$S]=0
+done
+
+printf "%-40s" "problem"
+for S in $SOLVERS; do
+        printf " %-16s %8s" $S "time"
+done
+echo
+
+for F in $*; do
+        printf "%-40s" $(basename $F)
+        PROVEN=""
+        REFUTED=""
+        for S in $SOLVERS; do
+                START=$(date +%s.%N)
+                STATUS=$($EXEC_FILE $EXEC_ARGS --sat_solver $S --time_limit $TIME_LIMIT $F 2>&1 | grep -m 1 -o -E "SZS status [A-Za-z]+|^(UN)?SATISFIABLE$" | sed -e "s/SZS status //" -e "s/^UNSATISFIABLE$/Unsatisfiable/" -e "s/^SATISFIABLE$/Satisfiable/")
+                END=$(date +%s.%N)
+                TIME=$(awk "BEGIN { print $END - $START }")
+                case $STATUS in
+                        Unsatisfiable|Theorem|ContradictoryAxioms)
+                                PROVEN=$S
+                                SOLVED[$S]=$((${SOLVED[$S]}+1));;
+                        Satisfiable|CounterSatisfiable)
+                                REFUTED=$S
+                                SOLVED[$S]=$((${SOLVED[$S]}+1));;
+                        "")
+                                STATUS=none;;
+                esac
+                TOTAL[$S]=$(awk "BEGIN { print ${TOTAL[$S]} + $TIME }")
+                printf " %-16s %8.2f" $STATUS $TIME
+        done
+        if [ -n "$PROVEN" ] && [ -n "$REFUTED" ]; then
+                printf "  MISMATCH (%s, %s)" $PROVEN $REFUTED
+        fi
+        echo
+done
+
+echo
+for S in $SOLVERS; do
+        printf "%-16s solved %6d total time %10.2f\n" $S ${SOLVED[$S]} ${TOTAL[$S]}
+done
@@ -91,6 +91,8 @@
 #include "SAT/MinisatInterfacing.hpp"
 #include "SAT/MinisatInterfacingNewSimp.hpp"
 #include "SAT/TWLSolver.hpp"
+#include "SAT/CDCLSolver.hpp"
+#include "SAT/LingelingInterfacing.hpp"
 #include "SAT/Preprocess.hpp"
 
 #include "FMB/ModelCheck.hpp"
@@ -560,6 +562,16 @@ void satSolverMode()
     case Options::SatSolver::MINISAT:
       solver = new MinisatInterfacingNewSimp(*env.options);
       break;      
+    case Options::SatSolver::CDCL:
+      solver = new CDCLSolver(*env.options);
+      break;
+    case Options::SatSolver::LINGELING: {
+      // all the clauses are added before solving
+      LingelingInterfacing* lingeling = new LingelingInterfacing(*env.options);
+      lingeling->enableVariableElimination();
+      solver = lingeling;
+      break;
+    }
     default:
       ASSERTION_VIOLATION(env.options->satSolver());
   }
@@ -579,6 +591,11 @@ void satSolverMode()
 
   env.statistics->phase = Statistics::ExecutionPhase::FINALIZATION;
 
+  if (env.options->satSolver() == Options::SatSolver::CDCL &&
+      env.options->statistics() != Options::Statistics::NONE) {
+    static_cast<CDCLSolver*>(solver.ptr())->printStatistics(cout);
+  }
+
   switch(res) {
   case SATSolver::Status::SATISFIABLE:
     cout<<"SATISFIABLE\n";